@@ -98,6 +98,55 @@ bool skip_to_next_demo(__unused struct repeating_timer *t)
     return true;
 }
 
+#if MAP_BENCHMARK == true
+/**
+ * @brief Evict the XIP cache like a large application would.
+ *
+ * Reads twice the 16 KB cache size of flash through the cached alias, one read per 8 byte cache line.
+ */
+static void xip_cache_pressure()
+{
+    const volatile uint32_t *flash = (const volatile uint32_t *)XIP_BASE;
+    for (uint32_t i = 0; i < (32 * 1024) / sizeof(uint32_t); i += 2)
+        (void)flash[i];
+}
+
+/**
+ * @brief Print the mapping time of update() and the DMA IRQ cost with a warm and a cold XIP cache.
+ *
+ * @param graphics RGB888 frame to map - the content does not matter
+ */
+static void map_benchmark(PicoGraphics const *graphics)
+{
+    constexpr uint32_t FRAMES = 100;
+
+    printf("map benchmark: RAM_HOT_PATH=%d INTERP_MAPPING=%d PARALLEL_MAPPING=%d, %lu frames of %ux%u\n",
+           RAM_HOT_PATH, INTERP_MAPPING, PARALLEL_MAPPING, (unsigned long)FRAMES,
+           (unsigned)HUB75_SCREEN_WIDTH, (unsigned)HUB75_SCREEN_HEIGHT);
+
+    for (int pressure = 0; pressure <= 1; ++pressure)
+    {
+        hub75_telemetry_t t;
+        uint32_t map_us = 0;
+
+        hub75_telemetry_reset();
+        for (uint32_t frame = 0; frame < FRAMES; ++frame)
+        {
+            if (pressure)
+                xip_cache_pressure();
+            update(graphics);
+            hub75_telemetry_snapshot(&t);
+            map_us += t.map_us_last;
+            sleep_ms(5); // let the bitplane build finish, like a 100 Hz render loop would
+        }
+        printf("  %s: map_us avg=%lu max=%lu irq0_cycles=%lu irq1_cycles=%lu\n",
+               pressure ? "XIP cache evicted" : "XIP cache warm   ",
+               (unsigned long)(map_us / FRAMES), (unsigned long)t.map_us_max,
+               (unsigned long)t.irq_display_cycles_max, (unsigned long)t.irq_build_cycles_max);
+    }
+}
+#endif
+
 /**
  * @brief Secondary core entry point.
  *
@@ -113,7 +162,14 @@ void core1_entry()
     // Add your additional tasks for core1 here
     while (true)
     {
-        tight_loop_contents();
+        // Plays animations started with hub75_anim_play() - returns immediately if none is playing
+        hub75_anim_poll();
+
+        // Maps half of the scan rows of update() / update_bgr() calls made on core0
+        hub75_map_poll();
+
+        // Maps and presents frames rendered on core0 with hub75_pipeline_submit()
+        hub75_pipeline_poll();
     }
 }
 
@@ -159,6 +215,11 @@ int main()
 
     PixelFill pixelFill = PixelFill(HUB75_SCREEN_WIDTH, HUB75_SCREEN_HEIGHT);
 
+#if MAP_BENCHMARK == true
+    bouncingBalls.bounce();
+    map_benchmark(&bouncingBalls);
+#endif
+
     // Pico RAM is finite - due to your configuration of DISPLAY_WIDTH and DISPLAY_HEIGHT, BITPLANES, BALANCED_LIGHT_OUTPUT 
     // and SEPARATE_CIE_CHANNELS you have to select just a selection of demos! 
     
@@ -263,6 +324,22 @@ int main()
             step = -step;
         }
 
+#if FRAME_RATE
+        // Driver telemetry once per second - printed here, never from the driver IRQs
+        static uint32_t telemetry_ms = 0;
+        uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+        if (now_ms - telemetry_ms >= 1000)
+        {
+            hub75_telemetry_t t;
+            char line[256];
+            hub75_telemetry_snapshot(&t);
+            hub75_telemetry_format(&t, line, sizeof(line));
+            printf("%s", line);
+            hub75_telemetry_reset();
+            telemetry_ms = now_ms;
+        }
+#endif
+
         sleep_ms(ms); // hz updates per second - the HUB75 driver is running independently usually with far more than 200Hz (see README.md)
     }
 }
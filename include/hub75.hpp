@@ -138,6 +138,66 @@ static_assert(ROW_MAPPING == ROW_MAP_STANDARD || ROW_MAPPING == ROW_MAP_SPLIT ||
 #define CIE_BLUE CIE
 #endif
 
+// Runtime LUTs
+// true lets hub75_lut_generate() regenerate the brightness tables on the device - CIE 1931 or gamma curve, white
+// point and black level - into two RAM table sets (3 KB, see src/hub75_lut.hpp). The mapping switches to a new set
+// before the next frame. The tables of src/cie.hpp stay the start value.
+#ifndef RUNTIME_LUT
+#define RUNTIME_LUT false
+#endif
+
+// Power limit
+// true sums the output values of every frame while it is mapped and estimates the LED current from them. Above the
+// budget set with hub75_set_power_limit() the brightness is reduced at once, and raised again by
+// 1/2^POWER_LIMIT_RELEASE_SHIFT of the difference per frame.
+#ifndef POWER_LIMIT
+#define POWER_LIMIT false
+#endif
+#ifndef POWER_LIMIT_RELEASE_SHIFT
+#define POWER_LIMIT_RELEASE_SHIFT 4
+#endif
+
+// Fade engine
+// Number of precomputed brightness steps for hub75_fade_build() (0 = off). Each step is a complete set of row
+// commands (SCAN_DEPTH x BCM sequence length x 12 bytes). The DMA advances through a sequence of up to
+// FADE_SEQUENCE_LENGTH step pointers, one per refresh period.
+#ifndef FADE_STEPS
+#define FADE_STEPS 0
+#endif
+#ifndef FADE_SEQUENCE_LENGTH
+#define FADE_SEQUENCE_LENGTH 1024
+#endif
+
+// Idle refresh
+// true drops the refresh rate to 1/IDLE_REFRESH_DIVIDER, at the same brightness, once nothing was presented for
+// IDLE_TIMEOUT_MS, and stops the display stream while an all-black frame is shown (see hub75_set_idle_policy()).
+// Costs a second, stretched row command set per row command buffer.
+#ifndef IDLE_REFRESH
+#define IDLE_REFRESH false
+#endif
+#ifndef IDLE_REFRESH_DIVIDER
+#define IDLE_REFRESH_DIVIDER 4
+#endif
+#ifndef IDLE_TIMEOUT_MS
+#define IDLE_TIMEOUT_MS 2000
+#endif
+static_assert(IDLE_TIMEOUT_MS <= UINT32_MAX / 1000u, "IDLE_TIMEOUT_MS must fit the 32-bit microsecond timer");
+
+// Frame sync (genlock)
+// true adds hub75_set_frame_sync(): a rising edge on FRAME_SYNC_PIN, shared by the controllers of a wall, releases the
+// frame swaps and optionally starts the refresh frames; the master drives the pin. A refresh frame may end up to
+// FRAME_SYNC_LATE_US after the expected pulse before the stream stops one frame earlier to wait for it.
+#ifndef FRAME_SYNC
+#define FRAME_SYNC false
+#endif
+#ifndef FRAME_SYNC_PIN
+#define FRAME_SYNC_PIN 14
+#endif
+#ifndef FRAME_SYNC_LATE_US
+#define FRAME_SYNC_LATE_US 20
+#endif
+static_assert(!(FRAME_SYNC == true && IDLE_REFRESH == true), "FRAME_SYNC and IDLE_REFRESH both stop the display stream, enable only one of them");
+
 // ---------------------------------------------------------------------------
 // Color Correction Matrix (CCM) — Cross-channel mixing
 //
@@ -182,6 +242,15 @@ static_assert(ROW_MAPPING == ROW_MAP_STANDARD || ROW_MAPPING == ROW_MAP_SPLIT ||
 #define CCM_BG_SHIFT 31 // bits of Green added into Blue output  (31 = off)
 #endif
 
+// Full colour correction matrix
+// true replaces the shift cross-terms above by a 3x3 matrix with signed coefficients, which can subtract bleed
+// and is switched at runtime with hub75_set_ccm(). The shifts above are its start value. The matrix and the
+// CIE tables are folded into partial-product tables (6 KB RAM, see src/hub75_ccm.hpp), so a pixel costs nine
+// table reads instead of three plus the shifts.
+#ifndef CCM_MATRIX
+#define CCM_MATRIX false
+#endif
+
 #ifndef BITPLANES
 #define BITPLANES 10 // default to 10-bit color depth (1024 levels per channel)
 #endif
@@ -193,6 +262,13 @@ static_assert(ROW_MAPPING == ROW_MAP_STANDARD || ROW_MAPPING == ROW_MAP_SPLIT ||
 #define CCM_MAX_VAL 255u
 #endif
 
+// Linear 16-bit input
+// true adds a 4x4 ordered dither to update_linear16(): each output step is split into 16 levels that are spread
+// over neighbouring pixels, so gradients finer than the BITPLANES steps do not band. false rounds to the nearest step.
+#ifndef LINEAR16_DITHER
+#define LINEAR16_DITHER true
+#endif
+
 // ---------------------------------------------------------------------------
 // Display Rotation
 //
@@ -246,6 +322,66 @@ static_assert(DISPLAY_ROTATION == 0 || DISPLAY_ROTATION == 90 || DISPLAY_ROTATIO
 #define BALANCED_LIGHT_OUTPUT true
 #endif
 
+// Single Frame Buffer (low-memory mode)
+// Only one copy of the BCM slices is kept. The display streams from it continuously while the
+// bitplane builder rewrites it in place, slice by slice, always picking the slice the scanout has
+// just left. This halves the frame buffer memory in exchange for occasional, bounded tearing
+// (at most one refresh period). Collisions with the scanout are counted - see hub75_get_single_buffer_stats().
+#ifndef SINGLE_FRAME_BUFFER
+#define SINGLE_FRAME_BUFFER false
+#endif
+
+// Serial frame ingest: receive ring buffer size as a power of two (14 → 16 KB)
+// The UART DMA ring must hold the bytes arriving between two hub75_stream_poll() calls, plus those arriving while a
+// presented frame is built and waits for its swap - the next frame is not decoded before.
+#ifndef STREAM_RING_BITS
+#define STREAM_RING_BITS 14
+#endif
+
+// SPI / parallel bus ingest: most bytes the host sends per CS assertion after seeing READY high.
+// READY rises when the ring has this much room, so a chunk never overruns it.
+#ifndef STREAM_BUS_CHUNK
+#define STREAM_BUS_CHUNK (1u << (STREAM_RING_BITS - 1))
+#endif
+static_assert(STREAM_BUS_CHUNK > 0 && STREAM_BUS_CHUNK <= (1u << STREAM_RING_BITS), "STREAM_BUS_CHUNK must fit into the ring buffer");
+
+// Art-Net / E1.31 ingest: packets held back while a presented frame is built and waits for its swap
+// (DMX_PACKET_MAX = 638 bytes each). Packets arriving when the queue is full are dropped.
+#ifndef DMX_QUEUE_PACKETS
+#define DMX_QUEUE_PACKETS 16
+#endif
+static_assert(DMX_QUEUE_PACKETS > 0, "DMX_QUEUE_PACKETS must be at least 1");
+
+// Event trace: ring buffer size per core as a power of two (7 → 128 events, 1 KB per core), 0 compiles the trace out
+#ifndef TRACE_BUFFER_BITS
+#define TRACE_BUFFER_BITS 7
+#endif
+
+// Parallel mapping: update() / update_bgr() hand the second half of the scan rows to the other core,
+// which picks it up in hub75_map_poll(). If the other core does not poll in time, the caller maps it itself.
+#ifndef PARALLEL_MAPPING
+#define PARALLEL_MAPPING true
+#endif
+
+// Interpolator mapping: the RGB888 kernel of update() lets the SIO interpolators compute the CIE table
+// addresses (see src/hub75_interp.hpp). false selects the portable C path, which is as fast on the
+// Cortex-M33 of the RP2350 (bit field extract + scaled index loads), so it is only enabled on the RP2040.
+#ifndef INTERP_MAPPING
+#if PICO_RP2040
+#define INTERP_MAPPING true
+#else
+#define INTERP_MAPPING false
+#endif
+#endif
+
+// Hot path in RAM: the CIE tables, the BCM sequence, the mapping kernels, the DMA IRQ handlers and hub75_trace()
+// are placed in SRAM instead of flash. Without it every XIP cache miss - e.g. when the application's own code
+// evicts the 16 KB cache - costs flash wait states in the per-pixel LUT reads and in the IRQ handlers.
+// Costs 1.5 KB of tables (0.5 KB with SEPARATE_CIE_CHANNELS false) plus the code of these functions.
+#ifndef RAM_HOT_PATH
+#define RAM_HOT_PATH true
+#endif
+
 // Used in hub75_demo.cpp
 // Start hub75 driver on core1 if HUB75_MULTICORE is set to true
 // Start hub75 driver on core0 if HUB75_MULTICORE is set to false
@@ -264,11 +400,19 @@ static_assert(DISPLAY_ROTATION == 0 || DISPLAY_ROTATION == 90 || DISPLAY_ROTATIO
 #endif
 
 // Frame rate
-// Use only for testing or debugging
+// hub75_demo.cpp prints the driver telemetry (refresh period, build time, ...) once per second.
+// The driver itself is not affected - the telemetry is always collected, see hub75_telemetry_snapshot().
 #ifndef FRAME_RATE
 #define FRAME_RATE false
 #endif
 
+// Mapping benchmark
+// hub75_demo.cpp measures the mapping time of update() and the IRQ handler cost once at start-up, with a warm
+// XIP cache and with the cache evicted before every frame. Build with RAM_HOT_PATH true and false to compare.
+#ifndef MAP_BENCHMARK
+#define MAP_BENCHMARK false
+#endif
+
 // --- modifications below this line might imply changes in source code ---
 
 namespace HUB75
@@ -290,6 +434,15 @@ namespace HUB75
 #define HUB75_SCREEN_HEIGHT (HUB75::DISPLAY_HEIGHT)
 #endif
 
+// Placement of the hot path (see RAM_HOT_PATH)
+#if RAM_HOT_PATH == true
+#define HUB75_RAM_FUNC(func_name) __not_in_flash_func(func_name)
+#define HUB75_RAM_DATA __not_in_flash("hub75_lut")
+#else
+#define HUB75_RAM_FUNC(func_name) func_name
+#define HUB75_RAM_DATA
+#endif
+
 #define LUT_MAPPING(COLOUR) pack_lut_rgb(COLOUR)
 #define LUT_MAPPING_RGB(R, G, B) pack_lut_rgb_(R, G, B)
 
@@ -355,14 +508,373 @@ enum Hub75ChainMode
 void create_hub75_driver(void);
 void start_hub75_driver(void);
 void update_bgr(const uint8_t *src);
+void update_linear16(const uint16_t *src);
+bool update_qoi(const uint8_t *qoi, size_t size);
+bool update_rle(const uint8_t *rle, size_t size);
+
+void hub75_write_rect_bgr(int x, int y, int w, int h, const uint8_t *src, int stride);
+void hub75_fill_rect(int x, int y, int w, int h, uint8_t r, uint8_t g, uint8_t b);
+int hub75_scan_slot(int x, int y);
+#define HUB75_NO_SLOT 0xFFFF ///< hub75_write_slots_rgb() slot entry that skips a pixel
+void hub75_write_slots_rgb(const uint16_t *slots, int n, const uint8_t *rgb);
+void hub75_present(void);
+bool hub75_present_pending(void);
 #if USE_PICO_GRAPHICS == true
 void update(PicoGraphics const *graphics);
+
+bool hub75_pipeline_init(PicoGraphics *graphics, void *second_buffer);
+void hub75_pipeline_submit(void);
+bool hub75_pipeline_poll(void);
 #endif
+bool hub75_map_poll(void);
 
 void setBasisBrightness(uint8_t factor);
 void setIntensity(float intensity);
 void setIntensity(float intensity, bool linear_brightness_control);
 
+/**
+ * @brief Refresh rate lock, see hub75_set_refresh_rate().
+ */
+typedef struct
+{
+    float requested_hz;       ///< rate passed to hub75_set_refresh_rate(), 0 = no lock
+    float achieved_hz;        ///< rate of the current row commands, clk_sys / (SM_CLOCKDIV * frame_cycles)
+    uint32_t frame_cycles;    ///< PIO cycles per frame
+    uint32_t padding_cycles;  ///< dark cycles added per frame to reach requested_hz
+    uint8_t max_basis_factor; ///< largest setBasisBrightness() factor that still reaches requested_hz, 0 = none
+    float headroom;           ///< brightness left under the lock: max_basis_factor / current basis factor
+    bool locked;              ///< requested_hz is reached
+} hub75_refresh_rate_t;
+
+bool hub75_set_refresh_rate(float hz);
+void hub75_get_refresh_rate(hub75_refresh_rate_t *info);
+
+#if CCM_MATRIX == true
+#define HUB75_CCM_ONE 16384 ///< coefficient 1.0 of hub75_ccm_t (Q2.14, range -2.0 .. < 2.0)
+
+/**
+ * @brief Colour correction matrix, see hub75_set_ccm().
+ *
+ * out[o] = m[o][0] * red + m[o][1] * green + m[o][2] * blue for the outputs o = red, green, blue,
+ * applied to the CIE corrected channel values.
+ */
+typedef struct
+{
+    int16_t m[3][3];
+} hub75_ccm_t;
+
+void hub75_set_ccm(const hub75_ccm_t *ccm);
+void hub75_get_ccm(hub75_ccm_t *ccm);
+bool hub75_ccm_from_float(hub75_ccm_t *ccm, const float m[3][3]);
+#endif
+
+#if RUNTIME_LUT == true
+#define HUB75_LUT_ONE 65536u ///< 1.0 in the Q16.16 fields of hub75_lut_params_t
+
+/**
+ * @brief Brightness curve of hub75_lut_generate().
+ *
+ * out(0) = 0, out(v) = black + y(v / 255) * (max * cap - black) with max = 2^BITPLANES - 1 and
+ * y(x) = x^gamma, or the CIE 1931 lightness curve of utils/cie.py for gamma = 0.
+ */
+typedef struct
+{
+    uint32_t gamma;  ///< exponent, Q16.16 (2.2 = 144179); 0 selects the CIE 1931 curve
+    uint32_t cap[3]; ///< white point of red, green, blue, Q16.16 up to HUB75_LUT_ONE
+    uint16_t black;  ///< output of the darkest non-zero input, 0 .. max
+} hub75_lut_params_t;
+
+void hub75_lut_generate(const hub75_lut_params_t *params);
+#endif
+
+#if POWER_LIMIT == true
+/**
+ * @brief LED current budget, see hub75_set_power_limit().
+ *
+ * The estimate of a frame is the sum over the channels of full_ma * (mean output value / max) * brightness.
+ */
+typedef struct
+{
+    uint32_t full_ma[3]; ///< current of the whole display showing full red, green, blue at brightness 1.0, mA
+    uint32_t budget_ma;  ///< current the supply may deliver to the LEDs, mA; 0 = no limit
+} hub75_power_limit_t;
+
+void hub75_set_power_limit(const hub75_power_limit_t *limit);
+uint32_t hub75_power_estimate_ma(void);
+uint32_t hub75_power_scale(void);
+#endif
+
+#if FADE_STEPS > 0
+/**
+ * @brief Order in which hub75_fade_start() plays the steps.
+ */
+typedef enum
+{
+    HUB75_FADE_ONCE,     ///< 0 .. n-1, then hold the last step
+    HUB75_FADE_LOOP,     ///< 0 .. n-1, repeated
+    HUB75_FADE_PINGPONG, ///< 0 .. n-1 .. 1, repeated (breathing)
+} hub75_fade_mode_t;
+
+bool hub75_fade_build(const float *intensity, uint32_t steps, bool linear_brightness_control);
+bool hub75_fade_start(hub75_fade_mode_t mode, uint32_t refreshes_per_step);
+void hub75_fade_stop(void);
+bool hub75_fade_active(void);
+#endif
+
+#if IDLE_REFRESH == true
+/**
+ * @brief Idle refresh statistics, see hub75_get_idle_stats().
+ */
+typedef struct
+{
+    uint32_t refreshes_full; ///< frames shown at the full refresh rate
+    uint32_t refreshes_idle; ///< frames shown at 1/IDLE_REFRESH_DIVIDER of it
+    uint32_t blanks;         ///< times the stream was stopped for an all-black frame
+    uint64_t blanked_us;     ///< time the stream was stopped, including a stop in progress
+    uint64_t dma_bytes;      ///< bytes moved by pixel_chan, row_chan and their control channels
+} hub75_idle_stats_t;
+
+void hub75_set_idle_policy(uint32_t timeout_ms, bool blank_black);
+void hub75_get_idle_stats(hub75_idle_stats_t *stats);
+#endif
+
+#if FRAME_SYNC == true
+/**
+ * @brief Role of the controller on FRAME_SYNC_PIN, see hub75_set_frame_sync().
+ */
+typedef enum
+{
+    HUB75_SYNC_OFF,     ///< free running, the pin is not used
+    HUB75_SYNC_MASTER,  ///< drive the pulse: high during the first of every frames_per_pulse refresh frames
+    HUB75_SYNC_SWAP,    ///< follow: swaps wait for a pulse
+    HUB75_SYNC_REFRESH, ///< follow: swaps wait for a pulse, and every pulse starts a refresh frame
+} hub75_sync_mode_t;
+
+/**
+ * @brief Frame sync statistics, see hub75_get_frame_sync_stats().
+ */
+typedef struct
+{
+    uint32_t pulses;        ///< rising edges seen (driven, on the master)
+    uint32_t missed;        ///< pulses that did not come, from intervals longer than 1.5 periods
+    uint32_t period_us_min; ///< pulse interval
+    uint32_t period_us_max;
+    float period_us_avg;
+    int32_t phase_us;       ///< last local refresh frame start after its pulse
+    int32_t phase_us_min;
+    int32_t phase_us_max;
+    float drift_ppm;        ///< HUB75_SYNC_SWAP: refresh rate against the pulses, positive = local frames slower
+    uint32_t late;          ///< HUB75_SYNC_REFRESH: frames that ended after their pulse
+    uint32_t resyncs;       ///< HUB75_SYNC_REFRESH: pulses that came while no stop was armed, e.g. while locking on
+    uint32_t stops;         ///< HUB75_SYNC_REFRESH: times the stream stopped to wait for a pulse
+    uint64_t waited_us;     ///< HUB75_SYNC_REFRESH: time the stream was stopped
+    uint32_t held_swaps;    ///< swaps that waited for a pulse
+} hub75_frame_sync_stats_t;
+
+void hub75_set_frame_sync(hub75_sync_mode_t mode, uint32_t frames_per_pulse);
+void hub75_get_frame_sync_stats(hub75_frame_sync_stats_t *stats);
+#endif
+
+#if SINGLE_FRAME_BUFFER == true
+typedef struct
+{
+    uint32_t slices_written; ///< BCM slices rebuilt in place since start-up
+    uint32_t collisions;     ///< slices the scanout entered while they were being rewritten
+} hub75_single_buffer_stats_t;
+
+void hub75_get_single_buffer_stats(hub75_single_buffer_stats_t *stats);
+#endif
+
+/**
+ * @brief Driver telemetry, see hub75_telemetry_snapshot().
+ *
+ * Counters run since start-up; maxima and the refresh statistics since the last hub75_telemetry_reset().
+ */
+typedef struct
+{
+    uint32_t frames_displayed;       ///< frames streamed to the panel
+    uint32_t frames_built;           ///< completed bitplane builds
+    uint32_t presents;               ///< frames handed to the driver (update*(), hub75_present(), hub75_show_prebaked*())
+    uint32_t overwritten;            ///< presents that replaced a frame before it reached the panel
+    uint32_t build_us_last;          ///< present → bitplanes built
+    uint32_t build_us_max;
+    uint32_t latency_us_last;        ///< present → frame on the panel (buffer swap)
+    uint32_t latency_us_max;
+    uint32_t irq_display_cycles_max; ///< ctrl_chan_handler() (DMA_IRQ_0) in processor clocks
+    uint32_t irq_build_cycles_max;   ///< read_chan_handler() (DMA_IRQ_1) in processor clocks
+    uint32_t refresh_us_min;         ///< measured refresh period
+    uint32_t refresh_us_avg;
+    uint32_t refresh_us_max;
+    uint32_t stream_starved_frames;  ///< frames in which hub75_bitplane_stream ran into an empty TX FIFO
+    uint32_t row_starved_frames;     ///< frames in which hub75_row ran into an empty TX FIFO
+    uint32_t tx_overruns;            ///< frames with a write to a full TX FIFO (FDEBUG TXOVER)
+    uint32_t map_us_last;            ///< update() / update_bgr() / hub75_pipeline_poll() mapping into rgb_buffer
+    uint32_t map_us_max;
+} hub75_telemetry_t;
+
+void hub75_telemetry_snapshot(hub75_telemetry_t *t);
+void hub75_telemetry_reset(void);
+int hub75_telemetry_format(const hub75_telemetry_t *t, char *buf, size_t size);
+
+// Flags passed to the starvation callback
+#define HUB75_STARVED_STREAM 0x1u ///< hub75_bitplane_stream stalled on an empty TX FIFO
+#define HUB75_STARVED_ROW 0x2u    ///< hub75_row stalled on an empty TX FIFO
+#define HUB75_TX_OVERRUN 0x4u     ///< a TX FIFO write was lost
+
+typedef void (*hub75_starved_callback_t)(uint32_t flags, uint32_t frame);
+
+void hub75_set_starved_callback(hub75_starved_callback_t callback);
+
+// Event trace (see src/hub75_trace.cpp, utils/trace2json.py converts hub75_trace_print() output)
+enum Hub75TraceEvent
+{
+    HUB75_TRACE_UPDATE_BEGIN = 1, ///< update() 0, update_bgr() 1, update_qoi() 2, update_rle() 3, hub75_pipeline_poll() 4, update_linear16() 5 started mapping
+    HUB75_TRACE_UPDATE_END,       ///< mapping done, bitplane build requested
+    HUB75_TRACE_BUILD_BEGIN,      ///< bitplane build started (every present)
+    HUB75_TRACE_SLICE_DONE,       ///< read_chan_handler(): BCM slice arg extracted
+    HUB75_TRACE_BUILD_DONE,       ///< all slices built, frame_buffer swap requested
+    HUB75_TRACE_SWAP,             ///< ctrl_chan_handler(): new frame on the panel (arg 1: pre-baked image)
+    HUB75_TRACE_ROW_CMD_BEGIN,    ///< hub75_build_row_cmd_buffer() started, arg basis brightness
+    HUB75_TRACE_ROW_CMD_END,      ///< row commands rebuilt, arg intensity in 1/1000
+    HUB75_TRACE_ROW_CMD_SWAP,     ///< ctrl_chan_handler(): new row commands in use
+    HUB75_TRACE_STARVED,          ///< frame with a starved display FIFO, arg HUB75_STARVED_* flags
+    HUB75_TRACE_IDLE,             ///< ctrl_chan_handler(): arg 0 full refresh rate, 1 idle rate, 2 stream stopped, 3 restarted
+    HUB75_TRACE_SYNC,             ///< frame sync: arg 0 pulse, 1 waiting for it, restarted 2 by the pulse, 3 late, 4 by timeout
+    HUB75_TRACE_USER = 32         ///< first event number free for the application
+};
+
+typedef struct
+{
+    uint32_t time_us; ///< time_us_32(), shared by both cores
+    uint8_t type;     ///< Hub75TraceEvent
+    uint8_t core;
+    uint16_t arg;
+} hub75_trace_event_t;
+
+void hub75_trace(uint8_t type, uint16_t arg);
+void hub75_trace_enable(bool enable);
+size_t hub75_trace_snapshot(hub75_trace_event_t *out, size_t max);
+void hub75_trace_print(void);
+
+// Pre-baked frame_buffer images (see utils/prebake.py)
+#define HUB75_PREBAKED_MAGIC 0x50353748u // 'H75P'
+#define HUB75_PREBAKED_VERSION 1
+
+/**
+ * @brief Header of a pre-baked asset, followed by the raw frame_buffer image.
+ *
+ * The image holds all BCM slices in BCM_SEQUENCE order, exactly as the bitplane
+ * builder would have written them. The geometry fields must match the build
+ * configuration, otherwise the asset is rejected.
+ */
+typedef struct
+{
+    uint32_t magic;               ///< HUB75_PREBAKED_MAGIC
+    uint16_t version;             ///< HUB75_PREBAKED_VERSION
+    uint16_t header_size;         ///< sizeof(hub75_prebaked_header_t), image starts right after the header
+    uint16_t display_width;       ///< HUB75::DISPLAY_WIDTH
+    uint16_t display_height;      ///< HUB75::DISPLAY_HEIGHT
+    uint8_t bitplanes;            ///< BITPLANES
+    uint8_t bcm_sequence_length;  ///< number of BCM slices (depends on BALANCED_LIGHT_OUTPUT)
+    uint8_t row_mapping;          ///< ROW_MAPPING
+    uint8_t rowsel_n_pins;        ///< ROWSEL_N_PINS
+    uint8_t chain_rows;           ///< CHAIN_ROWS
+    uint8_t chain_cols;           ///< CHAIN_COLS
+    uint8_t chain_mode;           ///< CHAIN_MODE
+    uint8_t rotation;             ///< DISPLAY_ROTATION / 90
+    uint32_t slice_bytes;         ///< bytes per BCM slice (TOTAL_PIXELS / 2)
+    uint32_t data_bytes;          ///< slice_bytes * bcm_sequence_length
+    uint32_t reserved;
+} hub75_prebaked_header_t;
+
+static_assert(sizeof(hub75_prebaked_header_t) == 32, "hub75_prebaked_header_t must match utils/prebake.py");
+
+bool hub75_show_prebaked(const uint8_t *asset, size_t size);
+bool hub75_show_prebaked_in_place(const uint8_t *asset, size_t size);
+
+// Animation playback (see src/hub75_animation.cpp, assets are created by utils/animation.py)
+#define HUB75_ANIM_KEYFRAME 0
+#define HUB75_ANIM_DELTA 1
+
+typedef struct
+{
+    uint32_t timestamp_ms; ///< presentation time relative to the start of the animation
+    uint16_t type;         ///< HUB75_ANIM_KEYFRAME or HUB75_ANIM_DELTA
+    uint16_t tile_count;   ///< number of changed tiles in a delta frame, 0 for keyframes
+    const uint8_t *data;   ///< keyframe: full BGR image, delta: tile_count × (uint16_t tile index, BGR tile pixels)
+} hub75_anim_frame_t;
+
+typedef struct
+{
+    uint16_t width;       ///< must equal HUB75_SCREEN_WIDTH
+    uint16_t height;      ///< must equal HUB75_SCREEN_HEIGHT
+    uint16_t tile_width;  ///< delta tile size, tiles are numbered row-major
+    uint16_t tile_height;
+    uint32_t duration_ms; ///< length of one loop iteration, greater than the last timestamp
+    uint32_t frame_count;
+    const hub75_anim_frame_t *frames;
+} hub75_animation_t;
+
+bool hub75_anim_play(const hub75_animation_t *anim, bool loop);
+void hub75_anim_stop(void);
+bool hub75_anim_playing(void);
+bool hub75_anim_poll(void);
+
+// Serial frame ingest (see src/hub75_stream.cpp and include/hub75_stream_decoder.h)
+#include "hub75_stream_decoder.h"
+
+void hub75_stream_init_uart(int uart_num, uint rx_pin, uint baudrate);
+void hub75_stream_init_spi(uint mosi_pin, uint ready_pin);
+void hub75_stream_init_parallel(uint data_pin, uint ready_pin);
+void hub75_stream_init_usb(void);
+void hub75_stream_poll(void);
+void hub75_stream_get_stats(hub75_stream_stats_t *stats);
+
+// Art-Net / E1.31 ingest (see src/hub75_dmx.cpp and include/hub75_dmx_decoder.h)
+#include "hub75_dmx_decoder.h"
+
+bool hub75_dmx_init(const hub75_dmx_layout_t *layout, uint32_t protocols);
+void hub75_dmx_feed(const uint8_t *packet, size_t len);
+void hub75_dmx_poll(void);
+void hub75_dmx_get_stats(hub75_dmx_stats_t *stats);
+
+#if USE_PICO_GRAPHICS == true
+/**
+ * @brief PicoGraphics target that draws straight into the driver's scan-ordered rgb_buffer.
+ *
+ * Pen colours are RGB888 like PicoGraphics_PenRGB888, but set_pen() pushes them through the
+ * CIE LUTs and CCM once, and every pixel write stores the pre-mapped 30-bit value in the
+ * rgb_buffer slot that update() would have filled for (x, y).
+ *
+ * No application framebuffer is allocated and update(&pen) skips the remap pass entirely -
+ * it only starts the bitplane extraction. There is exactly one rgb_buffer, so create at most
+ * one instance. Layers and alpha blending are not supported.
+ */
+class PicoGraphics_PenHUB75 : public PicoGraphics
+{
+public:
+    RGB src_color;
+    uint32_t color; ///< LUT/CCM mapped and packed (bv << 20 | gv << 10 | rv)
+
+    PicoGraphics_PenHUB75();
+    void set_pen(uint c) override;
+    void set_pen(uint8_t r, uint8_t g, uint8_t b) override;
+    int create_pen(uint8_t r, uint8_t g, uint8_t b) override;
+    int create_pen_hsv(float h, float s, float v) override;
+    void set_pixel(const Point &p) override;
+    void set_pixel_span(const Point &p, uint l) override;
+
+    // Hides PicoGraphics::clear(): an unclipped clear fills rgb_buffer linearly,
+    // since every slot receives the same pre-mapped value regardless of scan order.
+    void clear();
+
+    static size_t buffer_size(uint w, uint h)
+    {
+        return 0; // renders into the driver owned rgb_buffer
+    }
+};
+#endif
+
 #if defined(HUB75_MULTIPLEX_2_ROWS)
 static_assert(MATRIX_PANEL_HEIGHT == 2 * PanelConfig::SCAN_DEPTH, "HUB75_MULTIPLEX_2_ROWS requires two-row multiplexing");
 #endif
@@ -0,0 +1,95 @@
+#pragma once
+
+// Art-Net / E1.31 (sACN) DMX receiver (see README.md chapter "Art-Net / sACN Ingest")
+//
+// Portable C++ without Pico SDK dependencies, so the same decoder runs on the device
+// (src/hub75_dmx.cpp) and on a Linux host (utils/dmx_dump.cpp).
+//
+// The screen is cut into universes of pixels_per_universe RGB pixels (3 channels each),
+// counted row by row from the top-left pixel, optionally serpentine. Universe
+// first_universe + u carries pixels u * pixels_per_universe onwards.
+//
+// Init resolves every universe pixel to its rgb_buffer slot once, so a data packet is
+// written with one table walk - no RGB framebuffer and no coordinate maths per packet.
+//
+// Packets (one UDP payload per feed() call, multi-byte fields big endian unless noted):
+//
+//   ArtDmx         "Art-Net\0" op=0x5000:le16 ver:u16 seq:u8 phys:u8 subuni:u8 net:u8 length:u16 data[length]
+//   ArtSync        "Art-Net\0" op=0x5200:le16 ver:u16 aux:u16
+//   E1.31 data     root vector 4, framing vector 2: priority@108 sync@109 seq@111 options@112
+//                  universe@113, DMP count@123, start code@125, data@126
+//   E1.31 sync     root vector 8, framing vector 1: seq@44 sync@45
+//
+// Presenting:
+//   - ArtSync, or an E1.31 sync packet for the data's synchronization address, presents
+//     the universes received since the last present
+//   - without synchronization (no sync packet within DMX_SYNC_TIMEOUT_MS, E1.31 sync
+//     address 0) a frame is presented once every universe of the screen arrived, or when
+//     a universe arrives a second time before that (senders skipping unchanged universes)
+//
+// Per-universe sequence numbers drop packets the network reordered (E1.31 section 6.7.2);
+// Art-Net sequence 0 disables the check. E1.31 preview data, terminated streams and
+// non-zero start codes are ignored. Priorities are not merged: one source per universe.
+
+#include <cstddef>
+#include <cstdint>
+
+#define DMX_ARTNET_PORT 6454
+#define DMX_SACN_PORT 5568
+
+#define DMX_ARTNET 0x01 ///< protocol flags for hub75_dmx_init()
+#define DMX_SACN 0x02
+
+#define DMX_CHANNELS 512
+#define DMX_MAX_PIXELS (DMX_CHANNELS / 3) ///< RGB pixels per universe
+#define DMX_MAX_UNIVERSES 256             ///< universes per screen
+#define DMX_PACKET_MAX 638                ///< E1.31 data packet with 512 channels, the largest packet used
+#define DMX_SYNC_TIMEOUT_MS 4000          ///< Art-Net: back to unsynchronized 4 s after the last ArtSync
+#define DMX_NO_SLOT 0xFFFF                ///< slot table entry of a pixel outside the screen, HUB75_NO_SLOT on the device
+
+typedef struct
+{
+    uint16_t first_universe;      ///< universe of the top-left pixel (Art-Net port-address or E1.31 universe)
+    uint16_t pixels_per_universe; ///< 1..DMX_MAX_PIXELS, e.g. the screen width for one row per universe
+    bool serpentine;              ///< every second row runs right to left
+} hub75_dmx_layout_t;
+
+typedef struct
+{
+    void (*write)(const uint16_t *slots, int n, const uint8_t *rgb); ///< n RGB pixels into their slots
+    void (*present)(void);                                          ///< frame complete
+} hub75_dmx_sink_t;
+
+typedef struct
+{
+    uint32_t packets;      ///< packets fed into the decoder
+    uint32_t dmx;          ///< data packets written to the screen
+    uint32_t syncs;        ///< ArtSync and E1.31 sync packets
+    uint32_t frames;       ///< frames presented
+    uint32_t ignored;      ///< other universes, opcodes, start codes, preview data, sync addresses
+    uint32_t out_of_order; ///< data packets dropped by the sequence check
+    uint32_t errors;       ///< malformed packets
+    uint32_t dropped;      ///< packets dropped while a present was pending and the queue was full (device receive path)
+} hub75_dmx_stats_t;
+
+typedef struct
+{
+    hub75_dmx_layout_t layout;
+    hub75_dmx_sink_t sink;
+    hub75_dmx_stats_t stats;
+    const uint16_t *slots; ///< universes * pixels_per_universe rgb_buffer slots
+    uint16_t universes;    ///< universes covering the screen
+
+    uint8_t seq[DMX_MAX_UNIVERSES];             ///< last sequence number per universe
+    uint8_t seq_valid[DMX_MAX_UNIVERSES / 8];   ///< seq[] holds a received value
+    uint8_t received[DMX_MAX_UNIVERSES / 8];    ///< universes written since the last present
+    uint16_t received_count;
+    uint16_t sacn_sync; ///< synchronization address of the latest accepted E1.31 data packet, 0 = none
+    bool synced;        ///< a sync packet arrived within DMX_SYNC_TIMEOUT_MS
+    uint32_t sync_ms;   ///< time of the last sync packet
+} hub75_dmx_decoder_t;
+
+size_t hub75_dmx_table_size(const hub75_dmx_layout_t *layout, int width, int height);
+bool hub75_dmx_decoder_init(hub75_dmx_decoder_t *dec, const hub75_dmx_layout_t *layout, int width, int height,
+                            uint16_t *slots, int (*slot_of)(int x, int y), const hub75_dmx_sink_t *sink);
+void hub75_dmx_decoder_feed(hub75_dmx_decoder_t *dec, const uint8_t *packet, size_t len, uint32_t now_ms);
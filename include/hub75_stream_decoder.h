@@ -0,0 +1,88 @@
+#pragma once
+
+// Framed frame-stream protocol decoder (see README.md chapter "Serial Frame Ingest")
+//
+// Portable C++ without Pico SDK dependencies, so the same decoder runs on the device
+// (src/hub75_stream.cpp) and on a Linux host (utils/stream_dump.cpp).
+//
+// Packet layout (little endian):
+//
+//   0xA5 0x5A type:u8 flags:u8 length:u32 payload[length] sum:u16
+//
+//   sum    = sum of all payload bytes modulo 65536
+//   flags  = STREAM_FLAG_PRESENT: present the frame after this packet
+//
+//   STREAM_FULL     payload = width * height BGR pixels, always presents
+//   STREAM_RECT     payload = x:u16 y:u16 w:u16 h:u16, w * h BGR pixels
+//   STREAM_RLE      payload = x:u16 y:u16 w:u16 h:u16, RLE packets covering w * h pixels row-major
+//                             0x80 | (n - 1), B, G, R       → run of n pixels
+//                             0x00 | (n - 1), n × (B, G, R) → n literal pixels
+//   STREAM_PRESENT  payload empty, presents the frame
+//
+// Pixel data is handed to the sink while it arrives - one row segment at a time - so
+// no packet or frame is ever buffered by the decoder. A bad checksum is only detected
+// after the pixels were written; it is counted and the packet's present request dropped.
+//
+// feed() stops right after a frame was presented and returns the bytes consumed. The caller
+// feeds the rest once the presented frame no longer reads the pixels (hub75_present_pending()).
+
+#include <cstddef>
+#include <cstdint>
+
+#define STREAM_SYNC0 0xA5
+#define STREAM_SYNC1 0x5A
+
+#define STREAM_FULL 0x01
+#define STREAM_RECT 0x02
+#define STREAM_RLE 0x03
+#define STREAM_PRESENT 0x04
+
+#define STREAM_FLAG_PRESENT 0x01
+
+typedef struct
+{
+    void (*write)(int x, int y, int n, const uint8_t *bgr);             ///< n pixels on one row
+    void (*fill)(int x, int y, int n, uint8_t b, uint8_t g, uint8_t r); ///< n pixels of one colour on one row
+    void (*present)(void);                                              ///< frame complete
+} hub75_stream_sink_t;
+
+typedef struct
+{
+    uint32_t bytes;           ///< bytes fed into the decoder
+    uint32_t packets;         ///< packets decoded successfully
+    uint32_t frames;          ///< frames presented
+    uint32_t errors;          ///< malformed packets (unknown type, bad length or rectangle), followed by resync
+    uint32_t checksum_errors; ///< packets with a bad checksum
+    uint32_t overruns;        ///< receive ring buffer overruns (maintained by the device receive path)
+    uint32_t aborted_chunks;  ///< SPI chunks cut off in the middle of a byte, the partial byte dropped (device receive path)
+} hub75_stream_stats_t;
+
+typedef struct
+{
+    int width;
+    int height;
+    hub75_stream_sink_t sink;
+    hub75_stream_stats_t stats;
+
+    // parser state
+    uint8_t state;
+    uint8_t type;
+    uint8_t flags;
+    uint8_t hdr_len;  ///< bytes collected in hdr
+    uint8_t hdr[8];   ///< packet header or rectangle header
+    uint32_t length;  ///< payload bytes left
+    uint16_t sum;     ///< running payload checksum
+    uint8_t rle_ctrl; ///< current RLE packet control byte
+    uint32_t rle_n;   ///< pixels left in the current RLE packet
+
+    // rectangle being written
+    int rx, ry, rw, rh;
+    int cx, cy;          ///< cursor inside the rectangle
+    uint32_t pixels;     ///< pixels left in the rectangle
+    uint8_t carry[3];    ///< partial pixel split across feed() calls
+    uint8_t carry_len;
+} hub75_stream_decoder_t;
+
+void hub75_stream_decoder_init(hub75_stream_decoder_t *dec, int width, int height, const hub75_stream_sink_t *sink);
+void hub75_stream_decoder_reset(hub75_stream_decoder_t *dec);
+size_t hub75_stream_decoder_feed(hub75_stream_decoder_t *dec, const uint8_t *data, size_t len);
@@ -226,6 +226,7 @@ namespace pimoroni {
       PEN_DV_RGB555,
       PEN_DV_P5,
       PEN_DV_RGB888,
+      PEN_HUB75, // LUT-mapped 30-bit pixels stored in HUB75 scan order (see hub75.hpp)
     };
 
     void *frame_buffer;
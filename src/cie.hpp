@@ -1,9 +1,14 @@
 // Deduced from https://jared.geek.nz/2013/02/linear-led-pwm/
 // The CIE 1931 lightness formula is what actually describes how we perceive light.
 
+// Copied to SRAM at boot with RAM_HOT_PATH (see hub75.hpp), empty for the host tools in utils/
+#ifndef HUB75_RAM_DATA
+#define HUB75_RAM_DATA
+#endif
+
 #if SEPARATE_CIE_CHANNELS == true
 #if BITPLANES == 10
-static const uint16_t CIE_RED[256] = {
+static const uint16_t HUB75_RAM_DATA CIE_RED[256] = {
     0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 4, 5, 5, 6, 6, 7,
     7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14,
     15, 16, 16, 17, 18, 18, 19, 20, 21, 21, 22, 23, 24, 25, 26, 26,
@@ -21,7 +26,7 @@ static const uint16_t CIE_RED[256] = {
     725, 733, 742, 750, 758, 767, 776, 784, 793, 802, 810, 819, 828, 837, 846, 855,
     865, 874, 883, 893, 902, 912, 921, 931, 941, 950, 960, 970, 980, 990, 1001, 1011};
 
-static const uint16_t CIE_GREEN[256] = {
+static const uint16_t HUB75_RAM_DATA CIE_GREEN[256] = {
     0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 4, 5, 5, 6, 6, 7,
     7, 8, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 15,
     15, 16, 17, 17, 18, 19, 19, 20, 21, 22, 22, 23, 24, 25, 26, 27,
@@ -39,7 +44,7 @@ static const uint16_t CIE_GREEN[256] = {
     734, 742, 751, 759, 768, 776, 785, 794, 802, 811, 820, 829, 838, 847, 857, 866,
     875, 885, 894, 903, 913, 923, 932, 942, 952, 962, 972, 982, 992, 1002, 1013, 1023};
 
-static const uint16_t CIE_BLUE[256] = {
+static const uint16_t HUB75_RAM_DATA CIE_BLUE[256] = {
     0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 4, 5, 5, 6, 6, 7,
     7, 8, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 15,
     15, 16, 17, 17, 18, 19, 19, 20, 21, 22, 22, 23, 24, 25, 26, 27,
@@ -58,7 +63,7 @@ static const uint16_t CIE_BLUE[256] = {
     875, 885, 894, 903, 913, 923, 932, 942, 952, 962, 972, 982, 992, 1002, 1013, 1023};
 
 #elif BITPLANES == 8
-static const uint16_t CIE_RED[256] = {
+static const uint16_t HUB75_RAM_DATA CIE_RED[256] = {
     0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2,
     2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4,
     4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 7,
@@ -76,7 +81,7 @@ static const uint16_t CIE_RED[256] = {
     181, 183, 185, 187, 189, 191, 193, 195, 198, 200, 202, 204, 206, 209, 211, 213,
     216, 218, 220, 223, 225, 227, 230, 232, 234, 237, 239, 242, 244, 247, 249, 252};
 
-static const uint16_t CIE_GREEN[256] = {
+static const uint16_t HUB75_RAM_DATA CIE_GREEN[256] = {
     0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2,
     2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4,
     4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 7,
@@ -94,7 +99,7 @@ static const uint16_t CIE_GREEN[256] = {
     183, 185, 187, 189, 191, 193, 196, 198, 200, 202, 204, 207, 209, 211, 214, 216,
     218, 220, 223, 225, 228, 230, 232, 235, 237, 240, 242, 245, 247, 250, 252, 255};
 
-static const uint16_t CIE_BLUE[256] = {
+static const uint16_t HUB75_RAM_DATA CIE_BLUE[256] = {
     0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2,
     2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4,
     4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 7,
@@ -114,7 +119,7 @@ static const uint16_t CIE_BLUE[256] = {
 #endif
 #else
 #if BITPLANES == 10
-static const uint16_t CIE[256] = {
+static const uint16_t HUB75_RAM_DATA CIE[256] = {
     0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 4, 5, 5, 6, 6, 7,
     7, 8, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 15,
     15, 16, 17, 17, 18, 19, 19, 20, 21, 22, 22, 23, 24, 25, 26, 27,
@@ -132,7 +137,7 @@ static const uint16_t CIE[256] = {
     734, 742, 751, 759, 768, 776, 785, 794, 802, 811, 820, 829, 838, 847, 857, 866,
     875, 885, 894, 903, 913, 923, 932, 942, 952, 962, 972, 982, 992, 1002, 1013, 1023};
 #elif BITPLANES == 8
-static const uint16_t CIE[256] = {
+static const uint16_t HUB75_RAM_DATA CIE[256] = {
     0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2,
     2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4,
     4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 7,
@@ -8,6 +8,8 @@
 #include "hardware/dma.h"
 #include "hardware/pio.h"
 #include "hardware/clocks.h"
+#include "hardware/timer.h"
+#include "hardware/structs/systick.h"
 #include "pico/sync.h"
 
 #include "hub75.hpp"
@@ -17,6 +19,22 @@
 #include "fm6126a.h"
 
 #include "cie.hpp"
+#if CCM_MATRIX == true
+#include "hub75_ccm.hpp"
+#endif
+#if RUNTIME_LUT == true
+#include "hub75_lut.hpp"
+#endif
+#if INTERP_MAPPING == true
+#include "hardware/interp.h"
+#include "hub75_interp.hpp"
+#endif
+#if FRAME_SYNC == true
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "pico/time.h"
+#include "hub75_sync.hpp"
+#endif
 
 using HUB75::DISPLAY_HEIGHT;
 using HUB75::DISPLAY_WIDTH;
@@ -66,15 +84,20 @@ row_cmd_t *dma_row_cmd_buffer;
 static volatile bool swap_row_cmd_buffer_pending = false;
 static volatile bool swap_frame_buffer_pending = false;
 
+// Pre-baked image streamed straight from flash (hub75_show_prebaked_in_place)
+static const uint8_t *prebaked_front = nullptr;
+static volatile bool swap_prebaked_pending = false;
+static int prebaked_copy_chan = -1;
+
 #if BITPLANES == 10
 #if BALANCED_LIGHT_OUTPUT == true
 // Split sequence for 10 bitplanes
 // Split BP 9 into 4 parts, BP 8 into 2 parts.
-static const uint8_t BCM_SEQUENCE[] = {
+static const uint8_t HUB75_RAM_DATA BCM_SEQUENCE[] = {
     9, 0, 8, 1, 9, 2, 7, 3, 9, 4, 8, 5, 9, 6 // 14 steps instead of 10
 };
 #else
-static const uint8_t BCM_SEQUENCE[] = {
+static const uint8_t HUB75_RAM_DATA BCM_SEQUENCE[] = {
     0, 9, 2, 7, 4, 5, 1, 8, 3, 6 // 10 steps
 };
 #endif
@@ -82,11 +105,11 @@ static const uint8_t BCM_SEQUENCE[] = {
 #if BALANCED_LIGHT_OUTPUT == true
 // Split sequence for 8 bitplanes
 // Split BP 7 into 3 parts, BP 6 into 2 parts
-static const uint8_t BCM_SEQUENCE[] = {
+static const uint8_t HUB75_RAM_DATA BCM_SEQUENCE[] = {
     7, 0, 6, 1, 7, 2, 5, 3, 7, 4, 6 // 11 steps instead of 8
 };
 #else
-static const uint8_t BCM_SEQUENCE[] = {
+static const uint8_t HUB75_RAM_DATA BCM_SEQUENCE[] = {
     0, 7, 2, 5, 1, 6, 3, 4 // 8 steps
 };
 #endif
@@ -96,15 +119,30 @@ constexpr uint8_t bcm_sequence_length = sizeof(BCM_SEQUENCE) / sizeof(uint8_t);
 
 constexpr float SM_CLOCKDIV = (SM_CLOCKDIV_FACTOR < 1.0f) ? 1.0f : SM_CLOCKDIV_FACTOR;
 alignas(4) static uint8_t frame_buffer1[(TOTAL_PIXELS >> 1) * bcm_sequence_length];
+#if SINGLE_FRAME_BUFFER == false
 alignas(4) static uint8_t frame_buffer2[(TOTAL_PIXELS >> 1) * bcm_sequence_length];
+#endif
 
 alignas(4) static row_cmd_t row_cmd_buffer1[PanelConfig::SCAN_DEPTH * bcm_sequence_length];
 alignas(4) static row_cmd_t row_cmd_buffer2[PanelConfig::SCAN_DEPTH * bcm_sequence_length];
+#if IDLE_REFRESH == true
+// Companions of row_cmd_buffer1 / 2, stretched to 1/IDLE_REFRESH_DIVIDER of the refresh rate
+alignas(4) static row_cmd_t idle_row_cmd_buffer1[PanelConfig::SCAN_DEPTH * bcm_sequence_length];
+alignas(4) static row_cmd_t idle_row_cmd_buffer2[PanelConfig::SCAN_DEPTH * bcm_sequence_length];
+
+static inline row_cmd_t *idle_companion(const row_cmd_t *set)
+{
+    return set == row_cmd_buffer1 ? idle_row_cmd_buffer1 : idle_row_cmd_buffer2;
+}
+
+static void idle_wake();
+#endif
 
 static uint32_t rgb_buffer[TOTAL_PIXELS];
 
 static void configure_pio(bool);
 static void setup_dma_transfers();
+static void map_job_init();
 
 /**
  * @struct hub75_timing_config_t
@@ -156,6 +194,8 @@ int pixel_ctrl_chan = -1;
 int read_chan = -1;
 int write_chan = -1;
 
+static dma_channel_config row_ctrl_config; ///< row_ctrl_chan as set up by setup_dma_transfers(), no read increment
+
 // PIO configuration structure for state machine numbers and corresponding program offsets
 static struct
 {
@@ -173,6 +213,7 @@ static struct
 
 // Variable for bit plane selection
 static uint32_t bitplane = 0;
+static volatile bool bitplane_build_active = false; ///< rgb_buffer → frame_buffer extraction in progress
 
 // Variables for brightness control
 // Q format shift: Q16 gives 1.0 == (1 << 16) == 65536
@@ -184,6 +225,21 @@ static uint32_t brightness_fp = (1u << BRIGHTNESS_FP_SHIFT); // default == 1.0
 // Basis factor (coarse brightness)
 static uint32_t basis_factor = 6u;
 
+#if POWER_LIMIT == true
+// Factor of the power limit on brightness_fp, Q16 (see power_mapped())
+static uint32_t power_scale = (1u << BRIGHTNESS_FP_SHIFT);
+#endif
+
+// Brightness the row commands are built with: brightness_fp, reduced by the power limit
+static inline uint32_t output_brightness()
+{
+#if POWER_LIMIT == true
+    return (uint32_t)(((uint64_t)brightness_fp * power_scale) >> BRIGHTNESS_FP_SHIFT);
+#else
+    return brightness_fp;
+#endif
+}
+
 // Inverse CIE 1931: perceptual input t (0..1) -> linear light Y (0..1)
 //
 // L* = t * 100  (scale from normalised to 0..100)
@@ -286,6 +342,130 @@ void hub75_timing_init(hub75_timing_config_t *cfg, float clk_sys_hz, float clkdi
     hub75_timing_recompute(cfg);
 }
 
+// Split factor of a bitplane in the balanced sequences: its period is spread over this many slices
+static inline uint32_t slice_split(uint8_t bp)
+{
+#if BALANCED_LIGHT_OUTPUT
+#if BITPLANES == 10
+    // Split BP 9 into 4 parts, BP 8 into 2 parts
+    if (bp == 9)
+        return 4;
+    if (bp == 8)
+        return 2;
+#elif BITPLANES == 8
+    // Split BP 7 into 3 parts, BP 6 into 2 parts
+    if (bp == 7)
+        return 3;
+    if (bp == 6)
+        return 2;
+#endif
+#endif
+    (void)bp;
+    return 1;
+}
+
+// Refresh rate lock (hub75_set_refresh_rate())
+//
+// Cycle count of one row command, taken from hub75.pio (PIO cycles, a jmp x-- loop runs x + 1 times):
+//
+//   hub75_row:              wait irq 0, mov, guard y + 1, latch 4, settle y + 1, irq 1    2 * y + 8 + 1
+//                           out, out, addr t_addr + 1, out, lit + 1, out, dark + 1        t_addr + lit + dark + 7
+//   hub75_bitplane_stream:  wait irq 1 .. irq 0 (9 cycles per column)                     9 * BITPLANE_STREAM_LENGTH + 3
+//
+// The row waits for the shift of the next row, started by its irq 1, so one command takes
+// 2 * latch_cycles + 8 + max(t_addr + lit + dark + 8, shift) cycles. utils/hub75_emu.cpp --refresh-hz
+// checks this against the cycle-counting emulator.
+static float refresh_lock_hz = 0.0f;      ///< requested rate, 0 = no lock
+static uint32_t refresh_lock_cycles = 0; ///< PIO cycles per frame to pad to, derived from refresh_lock_hz at every row command build
+
+// Frame length of the lock in PIO cycles; 0 without a lock or before hub75_timing_init() knows the clock
+static uint32_t lock_cycles()
+{
+    const double pio_hz = (double)hub75_timing_config.clk_sys_hz / (double)hub75_timing_config.clkdiv;
+    if (refresh_lock_hz <= 0.0f || !(pio_hz > 0.0))
+        return 0;
+    const double cycles = pio_hz / refresh_lock_hz;
+    return cycles < (double)UINT32_MAX ? (uint32_t)(cycles + 0.5) : UINT32_MAX;
+}
+
+static inline uint32_t row_shift_cycles()
+{
+    return 9u * PanelConfig::BITPLANE_STREAM_LENGTH + 3u;
+}
+
+// PIO cycles a row command with lit + dark = period waits for the shift of the next row
+static inline uint32_t row_shift_wait(uint32_t t_addr, uint32_t period)
+{
+    const uint32_t display = t_addr + period + 8u;
+    const uint32_t shift = row_shift_cycles();
+    return shift > display ? shift - display : 0u;
+}
+
+// PIO cycles of one row command without padding
+static inline uint32_t row_cmd_cycles(uint32_t t_addr, uint32_t period)
+{
+    return 2u * hub75_timing_config.latch_cycles + 16u + t_addr + period + row_shift_wait(t_addr, period);
+}
+
+// PIO cycles of an unpadded frame with the basis factor basis, every slice period multiplied by stretch
+static uint64_t natural_frame_cycles(uint32_t basis, uint32_t stretch)
+{
+    uint64_t cycles = 0;
+    for (uint8_t bp : BCM_SEQUENCE)
+        cycles += (uint64_t)PanelConfig::SCAN_DEPTH *
+                  row_cmd_cycles(hub75_timing_config.addr_cycles + (bp >> 1), stretch * ((basis << bp) / slice_split(bp)));
+    return cycles;
+}
+
+/**
+ * @brief Fill one row command set (SCAN_DEPTH * bcm_sequence_length entries) for brightness_fp.
+ *
+ * @param stretch 1 for the normal frame; n multiplies lit and dark time and pads the frame to n times
+ *                its normal length - 1/n of the refresh rate at the same brightness (IDLE_REFRESH)
+ */
+static void fill_row_cmds(row_cmd_t *cmds, uint32_t brightness_fp, uint32_t stretch)
+{
+    constexpr uint32_t n_cmds = PanelConfig::SCAN_DEPTH * bcm_sequence_length;
+    uint32_t idx = 0;
+
+    // Refresh lock and stretch: the missing cycles are spread evenly over all commands as dark
+    // time, on top of the time a command would otherwise wait for the shift of the next row
+    uint64_t frame = natural_frame_cycles(basis_factor, 1);
+    if (refresh_lock_cycles && frame <= refresh_lock_cycles)
+        frame = refresh_lock_cycles;
+    const uint64_t padding = frame * stretch - natural_frame_cycles(basis_factor, stretch);
+
+    // Iterate through BCM sequence
+    for (uint8_t bp : BCM_SEQUENCE)
+    {
+        uint32_t t_addr = hub75_timing_config.addr_cycles + (bp >> 1); // address settle
+
+        // Bitplanes split in the balanced sequences get 1/split of their duration per slice
+        uint32_t base_per_slice = stretch * ((basis_factor << bp) / slice_split(bp));
+        uint32_t lit_cycles = (uint32_t)(((uint64_t)base_per_slice * brightness_fp) >> BRIGHTNESS_FP_SHIFT);
+        uint32_t dark_cycles = base_per_slice - lit_cycles;
+
+        const uint32_t slack = padding ? row_shift_wait(t_addr, base_per_slice) : 0u;
+
+        for (uint32_t row = 0; row < PanelConfig::SCAN_DEPTH; ++row)
+        {
+            row_cmd_t *cmd = &cmds[idx];
+            // low 5 bits = row address (hub75_row PIO consumes exactly 5 bits via `out pins, 5`),
+            // upper 27 bits = t_addr, taken by the following `out x, 27`
+            cmd->addr_delay = (t_addr << 5) | (encode_row_address(row) & 0x1Fu);
+            cmd->lit_cycles = lit_cycles;
+            cmd->dark_cycles = dark_cycles;
+            if (padding)
+            {
+                // Share of command idx in padding, the remainder spread like a Bresenham line
+                const uint32_t pad = (uint32_t)(((idx + 1) * padding) / n_cmds - (idx * padding) / n_cmds);
+                cmd->dark_cycles += slack + pad;
+            }
+            ++idx;
+        }
+    }
+}
+
 /**
  * @brief Build row command buffer for a complete frame.
  *
@@ -312,56 +492,16 @@ void hub75_timing_init(hub75_timing_config_t *cfg, float clk_sys_hz, float clkdi
  */
 void hub75_build_row_cmd_buffer(uint32_t brightness_fp)
 {
-    uint32_t idx = 0;
+    hub75_trace(HUB75_TRACE_ROW_CMD_BEGIN, (uint16_t)basis_factor);
 
-    // Iterate through BCM sequence
-    for (uint8_t bp : BCM_SEQUENCE)
-    {
-        uint32_t split_factor = 1;
-#if BALANCED_LIGHT_OUTPUT
-#if BITPLANES == 10
-        if (bp == 9)
-        {
-            // Calculate the "weight" of this slice
-            // Split BP 9 into 4 parts, each part gets 1/4 of the duration
-            split_factor = 4;
-        }
-        else if (bp == 8)
-        {
-            split_factor = 2;
-        }
-#elif BITPLANES == 8
-        if (bp == 7)
-        {
-            // Calculate the "weight" of this slice
-            // Split BP 7 into 3 parts, each part gets 1/3 of the duration
-            split_factor = 3;
-        }
-        else if (bp == 6)
-        {
-            split_factor = 2;
-        }
+    refresh_lock_cycles = lock_cycles();
+    fill_row_cmds(row_cmd_buffer, brightness_fp, 1);
+#if IDLE_REFRESH == true
+    fill_row_cmds(idle_companion(row_cmd_buffer), brightness_fp, IDLE_REFRESH_DIVIDER);
 #endif
-#endif
-        uint32_t total_lit, total_dark;
-        compute_bcm_cycles(bp, brightness_fp, total_lit, total_dark);
-
-        uint32_t base_per_slice = (basis_factor << bp) / split_factor;
-        uint32_t lit_cycles = (base_per_slice * brightness_fp) >> BRIGHTNESS_FP_SHIFT;
-        uint32_t dark_cycles = base_per_slice - lit_cycles;
-
-        for (uint32_t row = 0; row < PanelConfig::SCAN_DEPTH; ++row)
-        {
-            uint32_t t_addr = hub75_timing_config.addr_cycles + (bp >> 1); // address settle
-            row_cmd_t *cmd = &row_cmd_buffer[idx++];
-            // low 5 bits = row address (hub75_row PIO consumes exactly 5 bits via `out pins, 5`),
-            // upper 27 bits = t_addr, taken by the following `out x, 27`
-            cmd->addr_delay = (t_addr << 5) | (encode_row_address(row) & 0x1Fu);
-            cmd->lit_cycles = lit_cycles;
-            cmd->dark_cycles = dark_cycles;
-        }
-    }
     swap_row_cmd_buffer_pending = true;
+
+    hub75_trace(HUB75_TRACE_ROW_CMD_END, (uint16_t)((brightness_fp * 1000u) >> BRIGHTNESS_FP_SHIFT));
 }
 
 /**
@@ -378,7 +518,87 @@ void setBasisBrightness(uint8_t factor)
 {
     basis_factor = (factor > 0u) ? factor : 1u;
 
-    hub75_build_row_cmd_buffer(brightness_fp);
+    hub75_build_row_cmd_buffer(output_brightness());
+}
+
+/**
+ * @brief Lock the refresh rate: every frame is padded with dark time to exactly 1 / hz.
+ *
+ * The frame length is rounded to whole PIO cycles of clk_sys / SM_CLOCKDIV; hub75_get_refresh_rate()
+ * reports the rate that results. The lock stays in place across setIntensity(), setBasisBrightness()
+ * and the power limit. If the frame is longer than 1 / hz at the current basis factor, it is left
+ * unpadded until setBasisBrightness() makes it short enough.
+ *
+ * Only the rate is stored; the frame length in PIO cycles is derived from it whenever the row
+ * commands are built, so a lock set before create_hub75_driver() takes effect once the clock is known.
+ *
+ * @param hz frames per second, e.g. 1920 for a camera with 1/60 s or 1/120 s shutter; 0 removes the lock
+ * @return false if the rate is not reached at the current basis factor, or the driver has not been
+ *         created yet and the rate can not be checked
+ */
+bool hub75_set_refresh_rate(float hz)
+{
+    refresh_lock_hz = hz > 0.0f ? hz : 0.0f;
+
+    // Before create_hub75_driver() there is neither a clock nor a row command buffer; it builds
+    // the first row commands with the stored rate
+    if (hub75_timing_config.clk_sys_hz <= 0.0f)
+        return refresh_lock_hz == 0.0f;
+
+    hub75_build_row_cmd_buffer(output_brightness());
+
+    if (refresh_lock_hz == 0.0f)
+        return true;
+    return refresh_lock_cycles && natural_frame_cycles(basis_factor, 1) <= refresh_lock_cycles;
+}
+
+/**
+ * @brief Frame length and rate of the current row commands, and the brightness headroom left under the lock.
+ */
+void hub75_get_refresh_rate(hub75_refresh_rate_t *info)
+{
+    const uint64_t natural = natural_frame_cycles(basis_factor, 1);
+    const bool locked = refresh_lock_cycles && natural <= refresh_lock_cycles;
+    const uint64_t frame = locked ? refresh_lock_cycles : natural;
+
+    info->requested_hz = refresh_lock_hz;
+    info->achieved_hz = (float)((double)hub75_timing_config.clk_sys_hz / ((double)hub75_timing_config.clkdiv * (double)frame));
+    info->frame_cycles = (uint32_t)frame;
+    info->padding_cycles = locked ? refresh_lock_cycles - (uint32_t)natural : 0u;
+    info->locked = locked;
+
+    // The lit time grows with the basis factor: the largest factor whose frame still fits is the headroom
+    info->max_basis_factor = 0;
+    if (refresh_lock_cycles)
+    {
+        for (uint32_t b = 255; b > 0; --b)
+        {
+            if (natural_frame_cycles(b, 1) <= refresh_lock_cycles)
+            {
+                info->max_basis_factor = (uint8_t)b;
+                break;
+            }
+        }
+    }
+    info->headroom = (float)info->max_basis_factor / (float)basis_factor;
+}
+
+// Intensity 0.0 .. 1.0 of setIntensity() as brightness_fp
+static uint32_t intensity_to_fp(float intensity, bool linear_brightness_control)
+{
+    if (intensity <= 0.0f)
+        return 0;
+    if (intensity >= 1.0f)
+        return 1u << BRIGHTNESS_FP_SHIFT;
+
+    float y = intensity;
+    if (linear_brightness_control)
+    {
+        // Convert perceptual input to linear light output.
+        // Without this, the panel appears to jump from dark to bright very quickly because human vision is logarithmic.
+        y = cie1931_inverse(intensity);
+    }
+    return (uint32_t)(y * (float)(1u << BRIGHTNESS_FP_SHIFT) + 0.5f);
 }
 
 /**
@@ -406,139 +626,1214 @@ void setIntensity(float intensity)
  */
 void setIntensity(float intensity, bool linear_brightness_control)
 {
-    if (intensity <= 0.0f)
-    {
-        brightness_fp = 0;
-    }
-    else if (intensity >= 1.0f)
-    {
-        brightness_fp = (1u << BRIGHTNESS_FP_SHIFT);
-    }
-    else
-    {
-        float y = intensity;
-        if (linear_brightness_control)
-        {
-            // Convert perceptual input to linear light output.
-            // Without this, the panel appears to jump from dark to bright very quickly because human vision is logarithmic.
-            y = cie1931_inverse(intensity);
-        }
-        brightness_fp = (uint32_t)(y * (float)(1u << BRIGHTNESS_FP_SHIFT) + 0.5f);
-    }
+    brightness_fp = intensity_to_fp(intensity, linear_brightness_control);
 
-    hub75_build_row_cmd_buffer(brightness_fp);
+    hub75_build_row_cmd_buffer(output_brightness());
 }
 
-#if FRAME_RATE
-// use only for testing or debugging
-static int frame_count = 0;
-static uint32_t frame_freq_us = 0; // last measured period for N frames
-static absolute_time_t frame_time_start;
+#if FADE_STEPS > 0
+// ---------------------------------------------------------------------------
+// Fade engine
+//
+// hub75_fade_build() fills up to FADE_STEPS complete row command sets, one per
+// brightness step. hub75_fade_start() lays out a sequence of set pointers in
+// fade_sequence, and row_ctrl_chan reads it with read increment: at the end of
+// every refresh it loads the next pointer into row_chan, so the DMA steps
+// through the fade without the CPU. ctrl_chan_handler() only acts at the end of
+// the sequence - it rewinds a loop, or parks a one-shot fade on its last step.
+//
+// row_ctrl_chan is only reconfigured in ctrl_chan_handler(), which runs right
+// after the channel's single transfer and long before the next one. The API
+// side only posts requests; fade_state has the IRQ as its only writer.
+// ---------------------------------------------------------------------------
+
+enum fade_state_t : uint32_t
+{
+    FADE_IDLE,    ///< row_ctrl_chan reads dma_row_cmd_buffer
+    FADE_RUNNING, ///< row_ctrl_chan steps through fade_sequence
+    FADE_HOLDING, ///< one-shot fade done, row_ctrl_chan reads fade_hold
+};
 
-#define FRAME_MEASURE_INTERVAL 100
-#endif
+alignas(4) static row_cmd_t fade_sets[FADE_STEPS][PanelConfig::SCAN_DEPTH * bcm_sequence_length];
+static row_cmd_t *fade_sequence[FADE_SEQUENCE_LENGTH];
+static uint32_t fade_length = 0; ///< used entries of fade_sequence
+static uint32_t fade_steps = 0;  ///< sets filled by hub75_fade_build()
+static bool fade_loop = false;
+static row_cmd_t *fade_hold = nullptr; ///< read by row_ctrl_chan while holding
+static volatile uint32_t fade_state = FADE_IDLE;
+static volatile bool fade_start_request = false;
+static volatile bool fade_stop_request = false;
+/**
+ * @brief True while a fade runs, holds its last step or is about to start.
+ */
+bool hub75_fade_active(void)
+{
+    return fade_start_request || fade_state != FADE_IDLE;
+}
 
 /**
- * @brief DMA IRQ0 handler for frame synchronization and buffer swapping.
- *
- * Responsibilities:
- * -----------------
- * 1. Detect end-of-frame for:
- *    - row DMA (row_ctrl_chan)
- *    - pixel DMA (pixel_ctrl_chan)
+ * @brief Precompute the row command sets of a brightness ramp.
  *
- * 2. Perform safe double-buffer swaps:
- *    - row_cmd_buffer
- *    - frame_buffer
+ * One set per step, built with the current basis brightness - rebuild after setBasisBrightness().
+ * Fails while a fade is active, since the DMA may read the sets.
  *
- * Design rationale:
- * -----------------
- * Swapping only at frame boundaries ensures:
- * - No tearing
- * - No partially updated frames
+ * @param intensity                 steps in range [0.0f, 1.0f], as for setIntensity()
+ * @param steps                     number of steps, 1 .. FADE_STEPS
+ * @param linear_brightness_control as for setIntensity()
+ * @return false if steps is out of range or a fade is active
+ */
+bool hub75_fade_build(const float *intensity, uint32_t steps, bool linear_brightness_control)
+{
+    if (steps == 0 || steps > FADE_STEPS || hub75_fade_active())
+        return false;
+
+    for (uint32_t i = 0; i < steps; ++i)
+        fill_row_cmds(fade_sets[i], intensity_to_fp(intensity[i], linear_brightness_control), 1);
+    fade_steps = steps;
+    return true;
+}
+
+/**
+ * @brief Play the steps of hub75_fade_build(), advanced by DMA at the end of each refresh.
  *
- * Lock-free design:
- * -----------------
- * Uses flags:
- *   swap_row_cmd_buffer_pending
- *   swap_frame_buffer_pending
+ * HUB75_FADE_ONCE plays step 0 .. n-1 and holds the last one until setIntensity(),
+ * setBasisBrightness() or hub75_fade_stop(). HUB75_FADE_LOOP repeats 0 .. n-1,
+ * HUB75_FADE_PINGPONG repeats 0 .. n-1 .. 1 (breathing). Starts with the next refresh.
  *
- * No mutexes required.
+ * @param mode                 see hub75_fade_mode_t
+ * @param refreshes_per_step   refresh periods each step is shown
+ * @return false without steps, while a fade runs, or if the sequence exceeds FADE_SEQUENCE_LENGTH
  */
-void ctrl_chan_handler()
+bool hub75_fade_start(hub75_fade_mode_t mode, uint32_t refreshes_per_step)
 {
-    if (dma_channel_get_irq0_status(row_ctrl_chan))
-    {
-        // Clear the interrupt request for DMA channel
-        dma_channel_acknowledge_irq0(row_ctrl_chan);
+    if (fade_steps == 0 || refreshes_per_step == 0 || fade_start_request || fade_state == FADE_RUNNING)
+        return false;
 
-#if FRAME_RATE
-        if (frame_count == 0)
-        {
-            frame_time_start = get_absolute_time();
-        }
-        else if (frame_count >= FRAME_MEASURE_INTERVAL)
-        {
-            frame_freq_us = (uint32_t)absolute_time_diff_us(frame_time_start, get_absolute_time());
-            frame_count = -1; // reset so it measures again next interval
+    const uint32_t n = fade_steps;
+    const uint32_t order = (mode == HUB75_FADE_PINGPONG && n > 1) ? 2 * n - 2 : n;
+    if (order * refreshes_per_step > FADE_SEQUENCE_LENGTH)
+        return false;
 
-            uint32_t freq = 1000000u * FRAME_MEASURE_INTERVAL / frame_freq_us;
-            printf("Frame frequency: %u Hz\n", freq);
-            frame_freq_us = 0; // clear until next measurement
-        }
-        frame_count++;
-#endif
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < order; ++i)
+    {
+        row_cmd_t *set = fade_sets[i < n ? i : 2 * n - 2 - i];
+        for (uint32_t r = 0; r < refreshes_per_step; ++r)
+            fade_sequence[k++] = set;
+    }
+    fade_length = k;
+    fade_loop = mode != HUB75_FADE_ONCE;
 
-        if (swap_row_cmd_buffer_pending)
-        {
-            // dma_row_cmd_buffer → active front buffer (DMA reads from it).
-            // row_cmd_buffer → back buffer (modified by setBasisBrightness).
-            // Swap: the new back buffer becomes the new front buffer.
+    __dmb();
+    fade_start_request = true;
+#if IDLE_REFRESH == true
+    idle_wake(); // the fade starts in ctrl_chan_handler()
+#endif
+    return true;
+}
 
-            row_cmd_t *new_front = row_cmd_buffer;
-            row_cmd_buffer = (new_front == row_cmd_buffer1) ? row_cmd_buffer2 : row_cmd_buffer1;
-            dma_row_cmd_buffer = new_front;
+/**
+ * @brief Stop a fade with the next refresh and return to the brightness of setIntensity().
+ */
+void hub75_fade_stop(void)
+{
+    fade_stop_request = true;
+}
 
-            // Reconfigure row_ctrl_chan with a new dma_row_cmd_buffer pointer
-            dma_channel_set_read_addr(row_ctrl_chan, &dma_row_cmd_buffer, false);
+// row_ctrl_chan back to dma_row_cmd_buffer (IRQ only)
+static inline void fade_release_dma()
+{
+    dma_channel_set_config(row_ctrl_chan, &row_ctrl_config, false);
+    dma_channel_set_read_addr(row_ctrl_chan, &dma_row_cmd_buffer, false);
+    fade_state = FADE_IDLE;
+}
 
-            swap_row_cmd_buffer_pending = false;
-        }
+// Called by ctrl_chan_handler() once per refresh, before a row_cmd_buffer swap
+static inline void fade_refresh()
+{
+    // A stop request or a new setIntensity() / setBasisBrightness() ends the fade
+    if (fade_stop_request || (swap_row_cmd_buffer_pending && fade_state != FADE_IDLE))
+    {
+        fade_stop_request = false;
+        fade_start_request = false;
+        if (fade_state != FADE_IDLE)
+            fade_release_dma();
+        return;
     }
-    else if (dma_channel_get_irq0_status(pixel_ctrl_chan))
+
+    if (fade_start_request)
     {
-        // Clear the interrupt request for DMA channel
-        dma_channel_acknowledge_irq0(pixel_ctrl_chan);
+        fade_start_request = false;
+        dma_channel_config config = row_ctrl_config;
+        channel_config_set_read_increment(&config, true);
+        dma_channel_set_config(row_ctrl_chan, &config, false);
+        dma_channel_set_read_addr(row_ctrl_chan, fade_sequence, false);
+        fade_state = FADE_RUNNING;
+        return;
+    }
 
-        if (swap_frame_buffer_pending)
+    if (fade_state == FADE_RUNNING && dma_hw->ch[row_ctrl_chan].read_addr == (uintptr_t)(fade_sequence + fade_length))
+    {
+        if (fade_loop)
         {
-            // dma_buffer  → active front buffer (DMA streams from it)
-            // frame_buffer → back buffer (refilled by read_chan_handler)
-            // Swap: the new back buffer becomes the new front buffer.
-
-            uint8_t *new_front = frame_buffer;
-            frame_buffer = (new_front == frame_buffer1) ? frame_buffer2 : frame_buffer1;
-            dma_buffer = new_front;
-            // Reconfigure pixel_ctrl_chan with a new dma_buffer pointer
-            dma_channel_set_read_addr(pixel_ctrl_chan, &dma_buffer, false);
-
-            swap_frame_buffer_pending = false;
+            dma_channel_set_read_addr(row_ctrl_chan, fade_sequence, false);
+        }
+        else
+        {
+            fade_hold = fade_sequence[fade_length - 1];
+            dma_channel_set_config(row_ctrl_chan, &row_ctrl_config, false);
+            dma_channel_set_read_addr(row_ctrl_chan, &fade_hold, false);
+            fade_state = FADE_HOLDING;
         }
     }
 }
+#endif
 
-void setup_display_irq()
+#if POWER_LIMIT == true
+// ---------------------------------------------------------------------------
+// Power limit
+//
+// The mapping kernels sum the output values of each channel while they write
+// rgb_buffer (map_power_t). An output value is the on-time of the LED in BCM
+// units, so sum / (TOTAL_PIXELS * CCM_MAX_VAL) is the share of the full-white
+// current of that channel. power_mapped() turns the sums of a frame into a
+// current at the brightness set by setIntensity() and scales the brightness
+// down to the budget: at once when a frame needs more, and back up by
+// 1/2^POWER_LIMIT_RELEASE_SHIFT of the difference per frame, so a white flash
+// cannot brown out the supply and the brightness does not pump with the content.
+// ---------------------------------------------------------------------------
+
+// Output sums of one mapping part
+struct map_power_t
 {
-    dma_channel_set_irq0_enabled(row_ctrl_chan, true);
-    dma_channel_set_irq0_enabled(pixel_ctrl_chan, true);
-    irq_set_exclusive_handler(DMA_IRQ_0, ctrl_chan_handler);
-    irq_set_enabled(DMA_IRQ_0, true);
-}
+    uint32_t r = 0;
+    uint32_t g = 0;
+    uint32_t b = 0;
+
+    inline uint32_t add(uint32_t packed)
+    {
+        r += packed & 0x3FFu;
+        g += (packed >> 10u) & 0x3FFu;
+        b += packed >> 20u;
+        return packed;
+    }
+
+    inline void add(uint32_t packed, uint32_t count)
+    {
+        r += (packed & 0x3FFu) * count;
+        g += ((packed >> 10u) & 0x3FFu) * count;
+        b += (packed >> 20u) * count;
+    }
+};
+
+static hub75_power_limit_t power_limit = {{0, 0, 0}, 0};
+static volatile uint32_t power_estimate_ma = 0;
 
 /**
- * @brief DMA IRQ handler for bitplane generation pipeline.
+ * @brief Set the LED current budget of the automatic brightness limit.
  *
- * This function implements a streaming pipeline:
+ * Takes effect with the next mapped frame. A budget of 0 lifts the limit.
+ *
+ * @param limit full-white current per channel and budget, see hub75_power_limit_t
+ */
+void hub75_set_power_limit(const hub75_power_limit_t *limit)
+{
+    power_limit = *limit;
+}
+
+/**
+ * @brief Estimated LED current of the last mapped frame at the brightness it is shown with, in mA.
+ */
+uint32_t hub75_power_estimate_ma(void)
+{
+    return power_estimate_ma;
+}
+
+/**
+ * @brief Factor the power limit applies to the brightness, Q16 (65536 = not limited).
+ */
+uint32_t hub75_power_scale(void)
+{
+    return power_scale;
+}
+
+// Adjust the brightness to the output sums of a complete frame
+static void power_mapped(const map_power_t &sum)
+{
+    // Current at brightness 1.0, then at the brightness of setIntensity()
+    const uint64_t full = (uint64_t)TOTAL_PIXELS * CCM_MAX_VAL;
+    const uint64_t ma_full = ((uint64_t)power_limit.full_ma[0] * sum.r + (uint64_t)power_limit.full_ma[1] * sum.g +
+                              (uint64_t)power_limit.full_ma[2] * sum.b) /
+                             full;
+    const uint32_t ma = (uint32_t)((ma_full * brightness_fp) >> BRIGHTNESS_FP_SHIFT);
+
+    uint32_t target = 1u << BRIGHTNESS_FP_SHIFT;
+    if (power_limit.budget_ma && ma > power_limit.budget_ma)
+        target = (uint32_t)(((uint64_t)power_limit.budget_ma << BRIGHTNESS_FP_SHIFT) / ma);
+
+    uint32_t scale = power_scale;
+    if (target < scale)
+        scale = target;
+    else
+        scale += (target - scale + (1u << POWER_LIMIT_RELEASE_SHIFT) - 1u) >> POWER_LIMIT_RELEASE_SHIFT;
+
+    // The back buffer of the row commands may only be rewritten after the last rebuild was swapped in,
+    // otherwise the next frame tries again. A rebuild would also end a fade, which brings its own brightness.
+    bool rebuild = scale != power_scale && !swap_row_cmd_buffer_pending;
+#if FADE_STEPS > 0
+    rebuild = rebuild && !hub75_fade_active();
+#endif
+    if (rebuild)
+    {
+        power_scale = scale;
+        hub75_build_row_cmd_buffer(output_brightness());
+    }
+    power_estimate_ma = (uint32_t)(((uint64_t)ma * power_scale) >> BRIGHTNESS_FP_SHIFT);
+}
+#else
+struct map_power_t
+{
+    inline uint32_t add(uint32_t packed)
+    {
+        return packed;
+    }
+
+    inline void add(uint32_t, uint32_t)
+    {
+    }
+};
+
+static inline void power_mapped(const map_power_t &)
+{
+}
+#endif
+
+// Driver telemetry
+//
+// Every field has exactly one writer - ctrl_chan_handler(), read_chan_handler() or the thread
+// presenting frames - so plain 32-bit stores are enough and no IRQ is ever masked for it.
+// Counters run since start-up, extrema and the average since the last hub75_telemetry_reset().
+static struct
+{
+    // ctrl_chan_handler() (DMA_IRQ_0)
+    volatile uint32_t seq; ///< odd while the refresh statistics are being updated
+    volatile uint32_t frames_displayed;
+    volatile uint32_t frame_start_us;
+    volatile uint32_t refresh_us_min;
+    volatile uint32_t refresh_us_max;
+    volatile uint64_t refresh_us_sum;
+    volatile uint32_t refresh_count;
+    volatile uint32_t latency_us_last;
+    volatile uint32_t latency_us_max;
+    volatile uint32_t irq_display_cycles_max;
+    volatile uint32_t stream_starved_frames;
+    volatile uint32_t row_starved_frames;
+    volatile uint32_t tx_overruns;
+    volatile bool reset_display;
+
+    // read_chan_handler() (DMA_IRQ_1)
+    volatile uint32_t frames_built;
+    volatile uint32_t build_us_last;
+    volatile uint32_t build_us_max;
+    volatile uint32_t irq_build_cycles_max;
+    volatile bool reset_build;
+
+    // presenting thread
+    volatile uint32_t presents;
+    volatile uint32_t overwritten;
+    volatile uint32_t present_us;      ///< start of the frame currently being built
+    volatile uint32_t swap_present_us; ///< present time of the frame waiting for its swap
+
+    // mapping thread (update(), update_bgr(), hub75_pipeline_poll())
+    volatile uint32_t map_us_last;
+    volatile uint32_t map_us_max;
+    volatile bool reset_map;
+} telemetry;
+
+// SysTick counts processor clocks downwards from rvr to 0. The period is rvr + 1, which is only
+// 2^24 when the driver started it; an application tick (e.g. 1 ms) reloads much earlier.
+// Handlers are assumed to run for less than one period.
+static inline uint32_t irq_cycles_since(uint32_t start)
+{
+    const uint32_t now = systick_hw->cvr;
+    return start >= now ? start - now : start + (systick_hw->rvr & 0x00FFFFFFu) + 1 - now;
+}
+
+/**
+ * @brief Start SysTick as free running cycle counter for the IRQ handler statistics.
+ *
+ * Left alone if the application already uses it.
+ */
+static void telemetry_init()
+{
+    if (!(systick_hw->csr & 1u))
+    {
+        systick_hw->rvr = 0x00FFFFFFu;
+        systick_hw->cvr = 0;
+        systick_hw->csr = 0x5u; // processor clock, no interrupt, enabled
+    }
+    telemetry.refresh_us_min = UINT32_MAX;
+}
+
+/**
+ * @brief Account for a new frame at the bitplane builder (called by all present paths).
+ */
+static inline void telemetry_present(bool overwrites)
+{
+    telemetry.presents = telemetry.presents + 1;
+    if (overwrites)
+        telemetry.overwritten = telemetry.overwritten + 1;
+    telemetry.present_us = time_us_32();
+}
+
+/**
+ * @brief Account for a finished mapping into rgb_buffer (mapping thread only).
+ */
+static inline void telemetry_mapped(uint32_t start_us)
+{
+    uint32_t duration = time_us_32() - start_us;
+    if (telemetry.reset_map)
+    {
+        telemetry.map_us_max = 0;
+        telemetry.reset_map = false;
+    }
+    telemetry.map_us_last = duration;
+    if (duration > telemetry.map_us_max)
+        telemetry.map_us_max = duration;
+}
+
+/**
+ * @brief Account for a finished bitplane build (read_chan_handler() only).
+ */
+static inline void telemetry_build_done()
+{
+    uint32_t duration = time_us_32() - telemetry.present_us;
+    telemetry.frames_built = telemetry.frames_built + 1;
+    telemetry.build_us_last = duration;
+    if (duration > telemetry.build_us_max)
+        telemetry.build_us_max = duration;
+}
+
+/**
+ * @brief Account for a frame that has reached the panel (or, with SINGLE_FRAME_BUFFER, the frame buffer).
+ */
+static inline void telemetry_on_panel(uint32_t present_us)
+{
+    uint32_t latency = time_us_32() - present_us;
+    telemetry.latency_us_last = latency;
+    if (latency > telemetry.latency_us_max)
+        telemetry.latency_us_max = latency;
+}
+
+static hub75_starved_callback_t starved_callback = nullptr;
+
+/**
+ * @brief Read and clear the sticky FDEBUG flags of the display state machines.
+ *
+ * TXSTALL is set whenever hub75_bitplane_stream or hub75_row ran into an empty TX FIFO
+ * (an `out` with autopull waiting for data) - with DMA feeding them this only happens
+ * when pixel_chan / row_chan could not get the bus in time. TXOVER means a write to a
+ * full FIFO was lost. Both are sampled once per frame, so the result says whether the
+ * frame was affected, not how often.
+ *
+ * @return HUB75_STARVED_* flags of the frame just finished
+ */
+static inline uint32_t sample_fifo_debug()
+{
+    const uint32_t stall_data = 1u << (PIO_FDEBUG_TXSTALL_LSB + pio_config.sm_data);
+    const uint32_t stall_row = 1u << (PIO_FDEBUG_TXSTALL_LSB + pio_config.sm_row);
+    const uint32_t over = (1u << (PIO_FDEBUG_TXOVER_LSB + pio_config.sm_data)) | (1u << (PIO_FDEBUG_TXOVER_LSB + pio_config.sm_row));
+
+    // data_pio and row_pio are the same PIO block
+    uint32_t fdebug = pio_config.data_pio->fdebug & (stall_data | stall_row | over);
+    if (!fdebug)
+        return 0;
+    pio_config.data_pio->fdebug = fdebug; // write 1 to clear
+
+    return ((fdebug & stall_data) ? HUB75_STARVED_STREAM : 0u) | ((fdebug & stall_row) ? HUB75_STARVED_ROW : 0u) |
+           ((fdebug & over) ? HUB75_TX_OVERRUN : 0u);
+}
+
+/**
+ * @brief Register a function called when a frame was displayed with a starved FIFO.
+ *
+ * Runs inside ctrl_chan_handler() (DMA_IRQ_0) on the driver core at the end of the
+ * affected frame - keep it short, e.g. record a timestamp or set a flag.
+ *
+ * @param callback receives the HUB75_STARVED_* flags and the frame count, nullptr to disable
+ */
+void hub75_set_starved_callback(hub75_starved_callback_t callback)
+{
+    starved_callback = callback;
+}
+
+/**
+ * @brief Copy the driver telemetry.
+ *
+ * Lock-free: the refresh statistics are read again if ctrl_chan_handler() updated them meanwhile.
+ * Safe to call from any core, any time.
+ *
+ * @param t destination
+ */
+void hub75_telemetry_snapshot(hub75_telemetry_t *t)
+{
+    uint32_t seq, count;
+    uint64_t sum;
+    do
+    {
+        seq = telemetry.seq;
+        t->frames_displayed = telemetry.frames_displayed;
+        t->refresh_us_min = telemetry.refresh_us_min;
+        t->refresh_us_max = telemetry.refresh_us_max;
+        sum = telemetry.refresh_us_sum;
+        count = telemetry.refresh_count;
+        t->latency_us_last = telemetry.latency_us_last;
+        t->latency_us_max = telemetry.latency_us_max;
+        t->irq_display_cycles_max = telemetry.irq_display_cycles_max;
+        t->stream_starved_frames = telemetry.stream_starved_frames;
+        t->row_starved_frames = telemetry.row_starved_frames;
+        t->tx_overruns = telemetry.tx_overruns;
+        __dmb();
+    } while ((seq & 1u) || seq != telemetry.seq);
+
+    t->refresh_us_avg = count ? (uint32_t)(sum / count) : 0;
+    if (!count)
+        t->refresh_us_min = 0;
+
+    t->frames_built = telemetry.frames_built;
+    t->build_us_last = telemetry.build_us_last;
+    t->build_us_max = telemetry.build_us_max;
+    t->irq_build_cycles_max = telemetry.irq_build_cycles_max;
+    t->presents = telemetry.presents;
+    t->overwritten = telemetry.overwritten;
+    t->map_us_last = telemetry.map_us_last;
+    t->map_us_max = telemetry.map_us_max;
+}
+
+/**
+ * @brief Restart the extrema and the refresh average.
+ *
+ * The IRQ handlers clear their own fields at their next run, counters keep running.
+ */
+void hub75_telemetry_reset(void)
+{
+    telemetry.reset_display = true;
+    telemetry.reset_build = true;
+    telemetry.reset_map = true;
+}
+
+/**
+ * @brief Format a snapshot as one `key=value` line for a serial link.
+ *
+ * @return number of characters written (like snprintf)
+ */
+int hub75_telemetry_format(const hub75_telemetry_t *t, char *buf, size_t size)
+{
+    return snprintf(buf, size,
+                    "hub75 displayed=%lu built=%lu presents=%lu overwritten=%lu build_us=%lu/%lu latency_us=%lu/%lu "
+                    "irq0_cycles=%lu irq1_cycles=%lu refresh_us=%lu/%lu/%lu starved=%lu/%lu overruns=%lu map_us=%lu/%lu "
+                    "map_cycles_per_pixel=%lu\n",
+                    (unsigned long)t->frames_displayed, (unsigned long)t->frames_built, (unsigned long)t->presents,
+                    (unsigned long)t->overwritten, (unsigned long)t->build_us_last, (unsigned long)t->build_us_max,
+                    (unsigned long)t->latency_us_last, (unsigned long)t->latency_us_max,
+                    (unsigned long)t->irq_display_cycles_max, (unsigned long)t->irq_build_cycles_max,
+                    (unsigned long)t->refresh_us_min, (unsigned long)t->refresh_us_avg, (unsigned long)t->refresh_us_max,
+                    (unsigned long)t->stream_starved_frames, (unsigned long)t->row_starved_frames, (unsigned long)t->tx_overruns,
+                    (unsigned long)t->map_us_last, (unsigned long)t->map_us_max,
+                    (unsigned long)((uint64_t)t->map_us_last * clock_get_hz(clk_sys) / 1000000u / TOTAL_PIXELS));
+}
+
+#if SINGLE_FRAME_BUFFER == true
+constexpr uint32_t SLICE_BYTES = TOTAL_PIXELS >> 1; ///< size of one BCM slice in frame_buffer
+
+static volatile uint32_t scanout_frames = 0; ///< frames streamed by pixel_chan since start-up
+static volatile uint32_t slices_pending = 0; ///< bitmask of BCM slices still to be rebuilt from rgb_buffer
+static volatile bool slice_build_active = false;
+static volatile bool slice_invalidated = false; ///< rgb_buffer changed while slice_in_progress was built
+static uint32_t slice_in_progress = 0;
+static uint32_t slice_start_pos = 0; ///< scanout position when slice_in_progress was started
+
+static volatile uint32_t single_buffer_slices_written = 0;
+static volatile uint32_t single_buffer_collisions = 0;
+
+/**
+ * @brief Scanout position in BCM slices since start-up.
+ *
+ * frames * bcm_sequence_length + slice currently streamed by pixel_chan.
+ * The frame count is updated by ctrl_chan_handler() and may lag the
+ * read address by one IRQ latency right at the frame boundary.
+ */
+static inline uint32_t scanout_position()
+{
+    uint32_t frames, addr;
+    do
+    {
+        frames = scanout_frames;
+        addr = dma_hw->ch[pixel_chan].read_addr;
+    } while (frames != scanout_frames);
+
+    uint32_t slice = (addr - (uint32_t)(uintptr_t)frame_buffer1) / SLICE_BYTES;
+    if (slice >= bcm_sequence_length)
+        slice = bcm_sequence_length - 1;
+
+    return frames * bcm_sequence_length + slice;
+}
+
+/**
+ * @brief Rebuild the pending slice the scanout has most recently left.
+ *
+ * That slice will not be displayed again for almost a full refresh period,
+ * which is the largest head start the builder can get.
+ */
+static void HUB75_RAM_FUNC(start_next_slice)()
+{
+    uint32_t pos = scanout_position();
+    uint32_t current = pos % bcm_sequence_length;
+    uint32_t slice = current;
+
+    for (uint32_t k = 1; k <= bcm_sequence_length; ++k)
+    {
+        uint32_t s = (current + bcm_sequence_length - k) % bcm_sequence_length;
+        if (slices_pending & (1u << s))
+        {
+            slice = s;
+            break;
+        }
+    }
+
+    slice_in_progress = slice;
+    slice_start_pos = pos;
+    slice_build_active = true;
+
+    hub75_bitplane_setup_set_shift(pio_config.pio_read, pio_config.sm_read, pio_config.offs_read, BCM_SEQUENCE[slice]);
+    dma_channel_set_write_addr(write_chan, frame_buffer + slice * SLICE_BYTES, false);
+    dma_channel_set_read_addr(read_chan, rgb_buffer, false);
+    dma_start_channel_mask((1u << read_chan) | (1u << write_chan));
+}
+
+/**
+ * @brief Account for a finished slice and detect whether the scanout overtook it.
+ *
+ * The scanout has to advance `ahead` slices to enter the slice being written.
+ * If it advanced at least that far during the rebuild, part of the slice was
+ * displayed half old / half new.
+ */
+static inline void finish_slice()
+{
+    uint32_t start_slice = slice_start_pos % bcm_sequence_length;
+    uint32_t ahead = (slice_in_progress + bcm_sequence_length - start_slice) % bcm_sequence_length;
+    int32_t elapsed = (int32_t)(scanout_position() - slice_start_pos);
+
+    if (ahead == 0 || (elapsed > 0 && (uint32_t)elapsed >= ahead))
+        single_buffer_collisions++;
+
+    single_buffer_slices_written++;
+    if (slice_invalidated)
+        slice_invalidated = false; // keep it pending, it mixes old and new content
+    else
+        slices_pending &= ~(1u << slice_in_progress);
+}
+
+/**
+ * @brief Read the single frame buffer statistics.
+ *
+ * @param stats destination, filled with slices written and scanout collisions since start-up
+ */
+void hub75_get_single_buffer_stats(hub75_single_buffer_stats_t *stats)
+{
+    stats->slices_written = single_buffer_slices_written;
+    stats->collisions = single_buffer_collisions;
+}
+#endif
+
+#if IDLE_REFRESH == true
+// ---------------------------------------------------------------------------
+// Idle refresh
+//
+// hub75_build_row_cmd_buffer() fills every row command set twice: for the full
+// refresh rate and stretched by IDLE_REFRESH_DIVIDER (see fill_row_cmds()), at
+// the same brightness. When nothing was presented for idle_timeout_us,
+// ctrl_chan_handler() points row_ctrl_chan at the stretched companion, so
+// pixel_chan and row_chan move IDLE_REFRESH_DIVIDER times fewer bytes.
+//
+// While an all-black frame is on the panel, the stream is stopped: the chain
+// row_ctrl_chan -> row_chan is cut, the frame in flight runs out and the state
+// machines stall with OE off. The next present starts row_ctrl_chan by hand;
+// its IRQ restores the chain and restarts row_chan. Decisions and the restart
+// are taken under idle_lock, so a present on the other core can not slip in
+// between the decision to stop and the stop.
+// ---------------------------------------------------------------------------
+
+enum idle_blank_t : uint32_t
+{
+    BLANK_OFF,     ///< streaming
+    BLANK_ARMED,   ///< chain cut, the frame in flight is the last one
+    BLANK_STOPPED, ///< row_chan stopped, OE off
+    BLANK_WAKING,  ///< row_ctrl_chan started by idle_wake(), its IRQ restarts row_chan
+};
+
+static row_cmd_t *idle_row_cmd_front = idle_row_cmd_buffer1; ///< read by row_ctrl_chan at the idle rate
+static uint32_t idle_timeout_us = IDLE_TIMEOUT_MS * 1000u;
+static bool idle_blank_black = true;
+static bool idle_on = false;      ///< row_ctrl_chan reads idle_row_cmd_front (IRQ only)
+static bool idle_running = false; ///< the frame in flight is stretched (IRQ only)
+static volatile uint32_t idle_blank = BLANK_OFF;
+static volatile bool build_black = false; ///< the frame in frame_buffer is all black
+static volatile bool front_black = false; ///< the frame on the panel is all black
+static spin_lock_t *idle_lock = nullptr;
+
+static uint32_t idle_refreshes_full = 0;
+static uint32_t idle_refreshes_idle = 0;
+static uint32_t idle_blanks = 0;
+static uint64_t idle_blanked_us = 0;
+static uint32_t idle_blank_start_us = 0;
+
+#if SINGLE_FRAME_BUFFER == false
+// True if every pixel of rgb_buffer is off; returns at the first lit one
+static bool rgb_buffer_black()
+{
+    for (uint32_t i = 0; i < TOTAL_PIXELS; ++i)
+        if (rgb_buffer[i])
+            return false;
+    return true;
+}
+#endif
+
+/**
+ * @brief Restart a stopped stream (presenting thread, after the swap flags of the new frame are set).
+ */
+static void idle_wake()
+{
+    const uint32_t irq_state = spin_lock_blocking(idle_lock);
+    if (idle_blank == BLANK_STOPPED)
+    {
+        idle_blank = BLANK_WAKING;
+        dma_channel_start(row_ctrl_chan); // reloads row_chan without chaining, its IRQ does the rest
+    }
+    spin_unlock(idle_lock, irq_state);
+}
+
+// row_chan from the full-rate set again, with the chain restored (IRQ only, idle_lock held)
+static inline void idle_restart_stream()
+{
+    dma_channel_set_config(row_ctrl_chan, &row_ctrl_config, false);
+    dma_channel_set_read_addr(row_chan, dma_row_cmd_buffer, true);
+    idle_running = false;
+    telemetry.frame_start_us = 0; // the gap is neither a refresh period nor starvation
+}
+
+// Called by ctrl_chan_handler() once per refresh, after a row_cmd_buffer swap
+static inline void idle_refresh(uint32_t now)
+{
+    bool fade = false;
+#if FADE_STEPS > 0
+    fade = hub75_fade_active();
+#endif
+#if SINGLE_FRAME_BUFFER == true
+    const bool presenting = slice_build_active;
+#else
+    const bool presenting = bitplane_build_active || swap_frame_buffer_pending || swap_prebaked_pending;
+#endif
+    const bool blank = idle_blank_black && front_black && !presenting && !fade;
+
+    const uint32_t irq_state = spin_lock_blocking(idle_lock);
+    if (idle_blank != BLANK_WAKING)
+    {
+        // A refresh ended
+        if (idle_running)
+            ++idle_refreshes_idle;
+        else
+            ++idle_refreshes_full;
+        idle_running = idle_on;
+    }
+
+    switch (idle_blank)
+    {
+    case BLANK_WAKING:
+        idle_restart_stream();
+        idle_blank = BLANK_OFF;
+        idle_blanked_us += now - idle_blank_start_us;
+        hub75_trace(HUB75_TRACE_IDLE, 3);
+        break;
+
+    case BLANK_ARMED:
+        if (blank)
+        {
+            idle_blank = BLANK_STOPPED;
+            idle_blank_start_us = now;
+            ++idle_blanks;
+            telemetry.frame_start_us = 0;
+            hub75_trace(HUB75_TRACE_IDLE, 2);
+            spin_unlock(idle_lock, irq_state);
+            return;
+        }
+        idle_restart_stream();
+        idle_blank = BLANK_OFF;
+        break;
+
+    case BLANK_OFF:
+        if (blank)
+        {
+            // Cut the chain: row_chan stops after the frame it has just started
+            dma_channel_config config = row_ctrl_config;
+            channel_config_set_chain_to(&config, row_ctrl_chan);
+            dma_channel_set_config(row_ctrl_chan, &config, false);
+            idle_blank = BLANK_ARMED;
+        }
+        break;
+
+    default:
+        break;
+    }
+    spin_unlock(idle_lock, irq_state);
+
+    // A fade owns row_ctrl_chan
+    if (fade)
+    {
+        idle_on = false;
+        return;
+    }
+
+    const bool idle = idle_timeout_us && !presenting && (now - telemetry.present_us) >= idle_timeout_us;
+    if (idle != idle_on)
+        hub75_trace(HUB75_TRACE_IDLE, idle ? 1 : 0);
+    idle_on = idle;
+    idle_row_cmd_front = idle_companion(dma_row_cmd_buffer);
+    dma_channel_set_read_addr(row_ctrl_chan, idle ? &idle_row_cmd_front : &dma_row_cmd_buffer, false);
+}
+
+/**
+ * @brief Set the idle refresh policy.
+ *
+ * @param timeout_ms  time without a present after which the refresh rate drops to 1/IDLE_REFRESH_DIVIDER, 0 = never;
+ *                    clamped to UINT32_MAX / 1000 (about 71 minutes), the range of the microsecond timer difference
+ * @param blank_black stop the display stream while an all-black frame is shown (not with SINGLE_FRAME_BUFFER)
+ */
+void hub75_set_idle_policy(uint32_t timeout_ms, bool blank_black)
+{
+    if (timeout_ms > UINT32_MAX / 1000u)
+        timeout_ms = UINT32_MAX / 1000u;
+    idle_timeout_us = timeout_ms * 1000u;
+    idle_blank_black = blank_black;
+    if (idle_lock)
+        idle_wake(); // a stopped stream runs again under the new policy
+}
+
+/**
+ * @brief Read the idle refresh statistics since start-up.
+ */
+void hub75_get_idle_stats(hub75_idle_stats_t *stats)
+{
+    // Bytes pixel_chan, row_chan and their control channels move per refresh
+    constexpr uint64_t refresh_bytes = (uint64_t)(TOTAL_PIXELS >> 1) * bcm_sequence_length + sizeof(row_cmd_buffer1) + 2 * sizeof(void *);
+
+    const uint32_t irq_state = spin_lock_blocking(idle_lock);
+    stats->refreshes_full = idle_refreshes_full;
+    stats->refreshes_idle = idle_refreshes_idle;
+    stats->blanks = idle_blanks;
+    stats->blanked_us = idle_blanked_us;
+    if (idle_blank == BLANK_STOPPED || idle_blank == BLANK_WAKING)
+        stats->blanked_us += time_us_32() - idle_blank_start_us;
+    spin_unlock(idle_lock, irq_state);
+
+    stats->dma_bytes = ((uint64_t)stats->refreshes_full + stats->refreshes_idle) * refresh_bytes;
+}
+#endif
+
+#if FRAME_SYNC == true
+// ---------------------------------------------------------------------------
+// Frame sync (genlock)
+//
+// The decisions are taken by hub75_sync.hpp. The master drives FRAME_SYNC_PIN high
+// at the start of every frames_per_pulse-th refresh frame and low at the next one;
+// the followers take the rising edge in a raw GPIO IRQ handler. The stream is
+// stopped by cutting the chain row_ctrl_chan -> row_chan and restarted by starting
+// row_chan, whose read address row_ctrl_chan has already loaded. If no pulse comes,
+// an alarm restarts it. Edge handler, ctrl_chan_handler() and alarm may run on
+// different cores; sync_lock orders them.
+// ---------------------------------------------------------------------------
+
+static sync_t frame_sync;
+static hub75_sync_mode_t sync_mode = HUB75_SYNC_OFF;
+static uint32_t sync_frames_per_pulse = 2;
+static uint32_t sync_frame_count = 0;
+static bool sync_pin_high = false;
+static bool sync_release = false; ///< restart the stream when the frame armed before a mode change ends
+static bool sync_irq_installed = false;
+static uint32_t sync_frame_us = 0; ///< last measured refresh frame
+static spin_lock_t *sync_lock = nullptr;
+
+// Chain row_ctrl_chan to chan, keeping the rest of its configuration (a fade changes it)
+static inline void row_ctrl_chain_to(uint chan)
+{
+    dma_channel_config config = dma_get_channel_config(row_ctrl_chan);
+    channel_config_set_chain_to(&config, chan);
+    dma_channel_set_config(row_ctrl_chan, &config, false);
+}
+
+// Restart the stopped stream (sync_lock held)
+static void sync_restart_stream()
+{
+    row_ctrl_chain_to(row_chan);
+    sample_fifo_debug(); // the stall while waiting is not starvation
+    telemetry.frame_start_us = time_us_32();
+    dma_channel_start(row_chan);
+}
+
+static int64_t sync_timeout_callback(alarm_id_t, void *user_data)
+{
+    const uint32_t irq_state = spin_lock_blocking(sync_lock);
+    // Only the wait the alarm was armed for
+    if (frame_sync.stops == (uint32_t)(uintptr_t)user_data && sync_timeout(frame_sync, time_us_32()))
+    {
+        sync_restart_stream();
+        hub75_trace(HUB75_TRACE_SYNC, 4);
+    }
+    spin_unlock(sync_lock, irq_state);
+    return 0;
+}
+
+static void HUB75_RAM_FUNC(sync_pulse_handler)()
+{
+    if (!(gpio_get_irq_event_mask(FRAME_SYNC_PIN) & GPIO_IRQ_EDGE_RISE))
+        return;
+    gpio_acknowledge_irq(FRAME_SYNC_PIN, GPIO_IRQ_EDGE_RISE);
+
+    const uint32_t irq_state = spin_lock_blocking(sync_lock);
+    if (sync_pulse(frame_sync, time_us_32()))
+    {
+        sync_restart_stream();
+        hub75_trace(HUB75_TRACE_SYNC, 2);
+    }
+    else
+    {
+        hub75_trace(HUB75_TRACE_SYNC, 0);
+    }
+    spin_unlock(sync_lock, irq_state);
+}
+
+// Called by ctrl_chan_handler() once per row_ctrl_chan completion; period 0 = not measured
+static inline void frame_sync_refresh(uint32_t now, uint32_t period)
+{
+    uint32_t irq_state = spin_lock_blocking(sync_lock);
+    if (sync_release)
+    {
+        // The frame armed before hub75_set_frame_sync() has ended
+        sync_release = false;
+        sync_restart_stream();
+    }
+    if (sync_mode == HUB75_SYNC_OFF)
+    {
+        spin_unlock(sync_lock, irq_state);
+        return;
+    }
+
+    if (sync_mode == HUB75_SYNC_MASTER)
+    {
+        if (sync_pin_high)
+        {
+            gpio_put(FRAME_SYNC_PIN, 0);
+            sync_pin_high = false;
+        }
+        if (++sync_frame_count >= sync_frames_per_pulse)
+        {
+            sync_frame_count = 0;
+            gpio_put(FRAME_SYNC_PIN, 1);
+            sync_pin_high = true;
+            sync_pulse(frame_sync, now);
+            hub75_trace(HUB75_TRACE_SYNC, 0);
+        }
+    }
+
+    if (period)
+        sync_frame_us = period;
+    bool wait = false;
+    switch (sync_frame(frame_sync, now, sync_frame_us))
+    {
+    case SYNC_CUT:
+        row_ctrl_chain_to(row_ctrl_chan); // row_chan stops after the frame it has just started
+        break;
+    case SYNC_WAIT:
+        telemetry.frame_start_us = 0; // the wait is not a refresh period
+        hub75_trace(HUB75_TRACE_SYNC, 1);
+        wait = true;
+        break;
+    case SYNC_RESTART:
+        sync_restart_stream();
+        hub75_trace(HUB75_TRACE_SYNC, 3);
+        break;
+    default:
+        break;
+    }
+    const uint32_t timeout = sync_timeout_in(frame_sync, now);
+    const uint32_t stops = frame_sync.stops;
+    spin_unlock(sync_lock, irq_state);
+
+    // Outside the lock: an alarm in the past runs its callback right here
+    if (wait)
+        add_alarm_in_us(timeout, sync_timeout_callback, (void *)(uintptr_t)stops, true);
+}
+
+// Called by ctrl_chan_handler() at every pixel frame boundary; true if a pending swap may happen
+static inline bool frame_sync_swap(bool pending)
+{
+    if (sync_mode == HUB75_SYNC_OFF)
+        return true;
+    const uint32_t irq_state = spin_lock_blocking(sync_lock);
+    const bool allowed = sync_swap(frame_sync, time_us_32(), pending);
+    spin_unlock(sync_lock, irq_state);
+    return allowed;
+}
+
+/**
+ * @brief Set the role of this controller on FRAME_SYNC_PIN.
+ *
+ * Call it from the core that runs the display interrupts, so the edge interrupt runs there too.
+ *
+ * @param mode             HUB75_SYNC_MASTER drives the pulse, HUB75_SYNC_SWAP / HUB75_SYNC_REFRESH follow it
+ * @param frames_per_pulse master only: refresh frames per pulse, at least 2
+ */
+void hub75_set_frame_sync(hub75_sync_mode_t mode, uint32_t frames_per_pulse)
+{
+    gpio_set_irq_enabled(FRAME_SYNC_PIN, GPIO_IRQ_EDGE_RISE, false);
+
+    const uint32_t irq_state = spin_lock_blocking(sync_lock);
+    if (frame_sync.state == SYNC_STOPPED)
+        sync_restart_stream();
+    else if (frame_sync.state == SYNC_ARMED)
+        sync_release = true; // its end restarts the stream
+    sync_init(frame_sync, mode == HUB75_SYNC_REFRESH, FRAME_SYNC_LATE_US);
+    sync_mode = mode;
+    sync_frames_per_pulse = frames_per_pulse < 2 ? 2 : frames_per_pulse;
+    sync_frame_count = 0;
+    sync_pin_high = false;
+    spin_unlock(sync_lock, irq_state);
+
+    gpio_init(FRAME_SYNC_PIN);
+    if (mode == HUB75_SYNC_MASTER)
+    {
+        gpio_set_dir(FRAME_SYNC_PIN, GPIO_OUT);
+        gpio_put(FRAME_SYNC_PIN, 0);
+    }
+    else if (mode != HUB75_SYNC_OFF)
+    {
+        gpio_set_dir(FRAME_SYNC_PIN, GPIO_IN);
+        gpio_pull_down(FRAME_SYNC_PIN);
+        if (!sync_irq_installed)
+        {
+            gpio_add_raw_irq_handler(FRAME_SYNC_PIN, sync_pulse_handler);
+            irq_set_enabled(IO_IRQ_BANK0, true);
+            sync_irq_installed = true;
+        }
+        gpio_acknowledge_irq(FRAME_SYNC_PIN, GPIO_IRQ_EDGE_RISE);
+        gpio_set_irq_enabled(FRAME_SYNC_PIN, GPIO_IRQ_EDGE_RISE, true);
+    }
+}
+
+/**
+ * @brief Read the frame sync statistics since the last hub75_set_frame_sync().
+ */
+void hub75_get_frame_sync_stats(hub75_frame_sync_stats_t *stats)
+{
+    const uint32_t irq_state = spin_lock_blocking(sync_lock);
+    const sync_t s = frame_sync;
+    spin_unlock(sync_lock, irq_state);
+
+    stats->pulses = s.pulses;
+    stats->missed = s.missed;
+    stats->period_us_min = s.period_count ? s.period_min : 0;
+    stats->period_us_max = s.period_max;
+    stats->period_us_avg = s.period_count ? (float)s.period_sum / s.period_count : 0.0f;
+    stats->phase_us = s.phase;
+    stats->phase_us_min = s.have_phase ? s.phase_min : 0;
+    stats->phase_us_max = s.have_phase ? s.phase_max : 0;
+    stats->drift_ppm = s.drift_span_us ? (float)((double)s.drift_us * 1e6 / s.drift_span_us) : 0.0f;
+    stats->late = s.late;
+    stats->resyncs = s.resyncs;
+    stats->stops = s.stops;
+    stats->waited_us = s.waited_us;
+    stats->held_swaps = s.held_swaps;
+}
+#endif
+
+/**
+ * @brief DMA IRQ0 handler for frame synchronization and buffer swapping.
+ *
+ * Responsibilities:
+ * -----------------
+ * 1. Detect end-of-frame for:
+ *    - row DMA (row_ctrl_chan)
+ *    - pixel DMA (pixel_ctrl_chan)
+ *
+ * 2. Perform safe double-buffer swaps:
+ *    - row_cmd_buffer
+ *    - frame_buffer
+ *
+ * Design rationale:
+ * -----------------
+ * Swapping only at frame boundaries ensures:
+ * - No tearing
+ * - No partially updated frames
+ *
+ * Lock-free design:
+ * -----------------
+ * Uses flags:
+ *   swap_row_cmd_buffer_pending
+ *   swap_frame_buffer_pending
+ *
+ * No mutexes required.
+ */
+void HUB75_RAM_FUNC(ctrl_chan_handler)()
+{
+    const uint32_t irq_start = systick_hw->cvr;
+
+    if (dma_channel_get_irq0_status(row_ctrl_chan))
+    {
+        // Clear the interrupt request for DMA channel
+        dma_channel_acknowledge_irq0(row_ctrl_chan);
+
+        // Refresh period: row_chan wraps once per frame
+        uint32_t now = time_us_32();
+        uint32_t period = now - telemetry.frame_start_us;
+#if FRAME_SYNC == true
+        const uint32_t timed_period = telemetry.frame_start_us != 0 ? period : 0;
+#endif
+        telemetry.seq = telemetry.seq + 1;
+        __dmb();
+        if (telemetry.reset_display)
+        {
+            telemetry.refresh_us_min = UINT32_MAX;
+            telemetry.refresh_us_max = 0;
+            telemetry.refresh_us_sum = 0;
+            telemetry.refresh_count = 0;
+            telemetry.latency_us_max = 0;
+            telemetry.irq_display_cycles_max = 0;
+            telemetry.reset_display = false;
+        }
+        else if (telemetry.frame_start_us != 0)
+        {
+            if (period < telemetry.refresh_us_min)
+                telemetry.refresh_us_min = period;
+            if (period > telemetry.refresh_us_max)
+                telemetry.refresh_us_max = period;
+            telemetry.refresh_us_sum = telemetry.refresh_us_sum + period;
+            telemetry.refresh_count = telemetry.refresh_count + 1;
+        }
+        __dmb();
+        telemetry.seq = telemetry.seq + 1;
+
+        // The first sample only clears what the state machines flagged while waiting for the DMA start
+        uint32_t starved = sample_fifo_debug();
+        if (starved && telemetry.frame_start_us != 0)
+        {
+            if (starved & HUB75_STARVED_STREAM)
+                telemetry.stream_starved_frames = telemetry.stream_starved_frames + 1;
+            if (starved & HUB75_STARVED_ROW)
+                telemetry.row_starved_frames = telemetry.row_starved_frames + 1;
+            if (starved & HUB75_TX_OVERRUN)
+                telemetry.tx_overruns = telemetry.tx_overruns + 1;
+            hub75_trace(HUB75_TRACE_STARVED, (uint16_t)starved);
+            if (starved_callback)
+                starved_callback(starved, telemetry.frames_displayed);
+        }
+        telemetry.frame_start_us = now;
+
+#if FADE_STEPS > 0
+        fade_refresh();
+#endif
+
+        if (swap_row_cmd_buffer_pending)
+        {
+            // dma_row_cmd_buffer → active front buffer (DMA reads from it).
+            // row_cmd_buffer → back buffer (modified by setBasisBrightness).
+            // Swap: the new back buffer becomes the new front buffer.
+
+            row_cmd_t *new_front = row_cmd_buffer;
+            row_cmd_buffer = (new_front == row_cmd_buffer1) ? row_cmd_buffer2 : row_cmd_buffer1;
+            dma_row_cmd_buffer = new_front;
+
+            // Reconfigure row_ctrl_chan with a new dma_row_cmd_buffer pointer
+            dma_channel_set_read_addr(row_ctrl_chan, &dma_row_cmd_buffer, false);
+
+            swap_row_cmd_buffer_pending = false;
+            hub75_trace(HUB75_TRACE_ROW_CMD_SWAP, 0);
+        }
+
+#if IDLE_REFRESH == true
+        idle_refresh(now);
+#endif
+#if FRAME_SYNC == true
+        frame_sync_refresh(now, timed_period);
+#endif
+    }
+    else if (dma_channel_get_irq0_status(pixel_ctrl_chan))
+    {
+        // Clear the interrupt request for DMA channel
+        dma_channel_acknowledge_irq0(pixel_ctrl_chan);
+
+        telemetry.frames_displayed = telemetry.frames_displayed + 1;
+
+#if SINGLE_FRAME_BUFFER == true
+        // Single buffer: nothing to swap, just keep track of the scanout for the slice builder
+        scanout_frames++;
+#else
+#if FRAME_SYNC == true
+        const bool swap_released = frame_sync_swap(swap_prebaked_pending || swap_frame_buffer_pending);
+#else
+        constexpr bool swap_released = true;
+#endif
+        if (swap_prebaked_pending && swap_released)
+        {
+            // Stream the pre-baked image directly; both frame buffers become free
+            dma_buffer = const_cast<uint8_t *>(prebaked_front);
+            dma_channel_set_read_addr(pixel_ctrl_chan, &dma_buffer, false);
+#if IDLE_REFRESH == true
+            front_black = false;
+#endif
+
+            swap_prebaked_pending = false;
+            telemetry_on_panel(telemetry.swap_present_us);
+            hub75_trace(HUB75_TRACE_SWAP, 1);
+        }
+        else if (swap_frame_buffer_pending && swap_released)
+        {
+            // dma_buffer  → active front buffer (DMA streams from it)
+            // frame_buffer → back buffer (refilled by read_chan_handler)
+            // Swap: the new back buffer becomes the new front buffer.
+
+            uint8_t *new_front = frame_buffer;
+            frame_buffer = (new_front == frame_buffer1) ? frame_buffer2 : frame_buffer1;
+            dma_buffer = new_front;
+            // Reconfigure pixel_ctrl_chan with a new dma_buffer pointer
+            dma_channel_set_read_addr(pixel_ctrl_chan, &dma_buffer, false);
+#if IDLE_REFRESH == true
+            front_black = build_black;
+#endif
+
+            swap_frame_buffer_pending = false;
+            telemetry_on_panel(telemetry.swap_present_us);
+            hub75_trace(HUB75_TRACE_SWAP, 0);
+        }
+#endif
+    }
+
+    uint32_t cycles = irq_cycles_since(irq_start);
+    if (cycles > telemetry.irq_display_cycles_max)
+        telemetry.irq_display_cycles_max = cycles;
+}
+
+void setup_display_irq()
+{
+    dma_channel_set_irq0_enabled(row_ctrl_chan, true);
+    dma_channel_set_irq0_enabled(pixel_ctrl_chan, true);
+    irq_set_exclusive_handler(DMA_IRQ_0, ctrl_chan_handler);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+/**
+ * @brief DMA IRQ handler for bitplane generation pipeline.
+ *
+ * This function implements a streaming pipeline:
  *
  * Step-by-step:
  * -------------
@@ -558,11 +1853,39 @@ void setup_display_irq()
  * - Must be deterministic and low-latency
  * - Uses memory barrier (__dmb) before signaling swap
  */
-void read_chan_handler()
+void HUB75_RAM_FUNC(read_chan_handler)()
 {
+    const uint32_t irq_start = systick_hw->cvr;
+
     // Clear the interrupt request for DMA channel
     dma_channel_acknowledge_irq1(read_chan);
 
+    if (telemetry.reset_build)
+    {
+        telemetry.build_us_max = 0;
+        telemetry.irq_build_cycles_max = 0;
+        telemetry.reset_build = false;
+    }
+
+#if SINGLE_FRAME_BUFFER == true
+    // Single buffer: slices are rebuilt in place, in scanout-trailing order
+    hub75_trace(HUB75_TRACE_SLICE_DONE, (uint16_t)slice_in_progress);
+    finish_slice();
+    if (slices_pending)
+    {
+        start_next_slice();
+    }
+    else
+    {
+        __dmb();
+        slice_build_active = false;
+        telemetry_build_done();
+        hub75_trace(HUB75_TRACE_BUILD_DONE, 0);
+        telemetry_on_panel(telemetry.present_us); // there is no swap, the slices are on the panel
+    }
+#else
+    hub75_trace(HUB75_TRACE_SLICE_DONE, (uint16_t)bitplane);
+
     // go through all bitplanes in BCM_SEQUENCE
     if (++bitplane < bcm_sequence_length)
     {
@@ -578,6 +1901,9 @@ void read_chan_handler()
     }
     else
     {
+        telemetry.swap_present_us = telemetry.present_us;
+        telemetry_build_done();
+        hub75_trace(HUB75_TRACE_BUILD_DONE, 0);
         __dmb();
 
         // Reset shift for bitplane 0
@@ -590,7 +1916,13 @@ void read_chan_handler()
         // - to display new content of frame_buffer on matrix panel
         // - to make new "back-buffer" available for writing
         swap_frame_buffer_pending = true;
+        bitplane_build_active = false;
     }
+#endif
+
+    uint32_t cycles = irq_cycles_since(irq_start);
+    if (cycles > telemetry.irq_build_cycles_max)
+        telemetry.irq_build_cycles_max = cycles;
 }
 
 static void setup_bitplane_creation()
@@ -654,13 +1986,27 @@ void setup_bitplane_stream_irq()
  */
 void create_hub75_driver(void)
 {
+#if SINGLE_FRAME_BUFFER == true
+    dma_buffer = frame_buffer1;
+    frame_buffer = frame_buffer1;
+#else
     dma_buffer = frame_buffer1;
     frame_buffer = frame_buffer2;
+#endif
 
     dma_row_cmd_buffer = row_cmd_buffer1;
     row_cmd_buffer = row_cmd_buffer2;
+#if IDLE_REFRESH == true
+    idle_lock = spin_lock_instance(spin_lock_claim_unused(true));
+#endif
+#if FRAME_SYNC == true
+    sync_lock = spin_lock_instance(spin_lock_claim_unused(true));
+    sync_init(frame_sync, false, FRAME_SYNC_LATE_US);
+#endif
 
     hub75_timing_init(&hub75_timing_config, clock_get_hz(clk_sys), SM_CLOCKDIV);
+    telemetry_init();
+    map_job_init();
 
 #if PANEL_TYPE == PANEL_FM6126A
     FM6126A_setup();
@@ -673,7 +2019,7 @@ void create_hub75_driver(void)
     setup_bitplane_creation();
     setup_display_irq();
     setup_bitplane_stream_irq();
-    hub75_build_row_cmd_buffer(brightness_fp);
+    hub75_build_row_cmd_buffer(output_brightness());
 }
 
 /**
@@ -688,8 +2034,13 @@ void start_hub75_driver(void)
     dma_row_cmd_buffer = row_cmd_buffer2;
     row_cmd_buffer = row_cmd_buffer1;
 
+#if SINGLE_FRAME_BUFFER == true
+    dma_buffer = frame_buffer1;
+    frame_buffer = frame_buffer1;
+#else
     dma_buffer = frame_buffer2;
     frame_buffer = frame_buffer1;
+#endif
 
     swap_row_cmd_buffer_pending = false;
     swap_frame_buffer_pending = false;
@@ -701,6 +2052,145 @@ void start_hub75_driver(void)
     dma_channel_set_read_addr(row_chan, dma_row_cmd_buffer, true);
 }
 
+/**
+ * @brief Validate a pre-baked asset against the build configuration.
+ *
+ * @param asset asset produced by utils/prebake.py
+ * @param size  size of the asset in bytes
+ * @return pointer to the frame_buffer image, or nullptr if the asset does not fit this build
+ */
+static const uint8_t *prebaked_image(const uint8_t *asset, size_t size)
+{
+    const hub75_prebaked_header_t *hdr = reinterpret_cast<const hub75_prebaked_header_t *>(asset);
+
+    if (size < sizeof(*hdr) || hdr->magic != HUB75_PREBAKED_MAGIC || hdr->version != HUB75_PREBAKED_VERSION)
+        return nullptr;
+
+    // The image must start behind the header and end inside the asset
+    if (hdr->header_size < sizeof(*hdr) || hdr->header_size > size || size - hdr->header_size < hdr->data_bytes)
+        return nullptr;
+
+    if (hdr->display_width != DISPLAY_WIDTH || hdr->display_height != DISPLAY_HEIGHT ||
+        hdr->bitplanes != BITPLANES || hdr->bcm_sequence_length != bcm_sequence_length ||
+        hdr->row_mapping != ROW_MAPPING || hdr->rowsel_n_pins != ROWSEL_N_PINS ||
+        hdr->chain_rows != CHAIN_ROWS || hdr->chain_cols != CHAIN_COLS ||
+        hdr->chain_mode != CHAIN_MODE || hdr->rotation != DISPLAY_ROTATION / 90 ||
+        hdr->slice_bytes != (TOTAL_PIXELS >> 1) || hdr->data_bytes != sizeof(frame_buffer1))
+        return nullptr;
+
+    const uint8_t *image = asset + hdr->header_size;
+
+    // pixel_chan and the copy channel transfer 32-bit words
+    if ((uintptr_t)image & 3u)
+        return nullptr;
+
+    return image;
+}
+
+/**
+ * @brief Present a pre-baked asset by DMA-copying it into the back buffer.
+ *
+ * No LUT, CCM or bitplane work is done - the asset already is the frame_buffer image.
+ * Waits for a running bitplane build and a pending swap to finish first.
+ *
+ * @param asset asset produced by utils/prebake.py (4-byte aligned)
+ * @param size  size of the asset in bytes, sizeof() of the generated array
+ * @return false if the asset was baked for a different configuration or is truncated
+ */
+bool hub75_show_prebaked(const uint8_t *asset, size_t size)
+{
+    const uint8_t *image = prebaked_image(asset, size);
+    if (!image)
+        return false;
+
+    if (prebaked_copy_chan < 0)
+    {
+        prebaked_copy_chan = dma_claim_unused_channel(true);
+    }
+
+#if SINGLE_FRAME_BUFFER == true
+    // Nothing to swap: overwrite the only frame buffer, tearing for at most one refresh period
+    while (slice_build_active)
+        tight_loop_contents();
+    slices_pending = 0;
+#else
+    // Once the build has finished and its swap has happened, frame_buffer is a free back buffer
+    while (bitplane_build_active || swap_frame_buffer_pending || swap_prebaked_pending)
+        tight_loop_contents();
+#endif
+
+    telemetry_present(false);
+
+    dma_channel_config c = dma_channel_get_default_config(prebaked_copy_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, true);
+
+    dma_channel_configure(
+        prebaked_copy_chan,
+        &c,
+        frame_buffer,                                           // Write to back buffer
+        image,                                                  // Read from asset (flash or RAM)
+        dma_encode_transfer_count(sizeof(frame_buffer1) >> 2), // Whole frame_buffer image in words
+        true                                                    // Start immediately
+    );
+    dma_channel_wait_for_finish_blocking(prebaked_copy_chan);
+
+#if SINGLE_FRAME_BUFFER == false
+    telemetry.swap_present_us = telemetry.present_us;
+#if IDLE_REFRESH == true
+    build_black = false;
+#endif
+    __dmb();
+    swap_frame_buffer_pending = true;
+#endif
+#if IDLE_REFRESH == true
+    idle_wake();
+#endif
+    return true;
+}
+
+/**
+ * @brief Present a pre-baked asset by streaming it straight from where it is stored.
+ *
+ * pixel_ctrl_chan is pointed at the asset at the next frame boundary, so static
+ * content costs neither CPU time nor a frame buffer copy. The asset must stay valid
+ * until the next update()/hub75_show_prebaked(). Streaming from flash is limited by
+ * XIP bandwidth, which is plenty for a single 64x64 panel but may cap the refresh
+ * rate of large chains.
+ *
+ * Not available with SINGLE_FRAME_BUFFER, whose slice builder tracks the scanout
+ * inside the one frame buffer.
+ *
+ * @param asset asset produced by utils/prebake.py (4-byte aligned)
+ * @param size  size of the asset in bytes, sizeof() of the generated array
+ * @return false if the asset was baked for a different configuration or is truncated
+ */
+bool hub75_show_prebaked_in_place(const uint8_t *asset, size_t size)
+{
+#if SINGLE_FRAME_BUFFER == true
+    return false;
+#else
+    const uint8_t *image = prebaked_image(asset, size);
+    if (!image)
+        return false;
+
+    // Don't overtake a frame the bitplane builder has just finished
+    while (swap_frame_buffer_pending)
+        tight_loop_contents();
+
+    telemetry_present(swap_prebaked_pending);
+    telemetry.swap_present_us = telemetry.present_us;
+    prebaked_front = image;
+    __dmb();
+    swap_prebaked_pending = true;
+#if IDLE_REFRESH == true
+    idle_wake();
+#endif
+    return true;
+#endif
+}
+
 /**
  * @brief Configures the PIO state machines for HUB75 matrix control.
  *
@@ -815,6 +2305,7 @@ static void setup_dma_transfers()
     // When row_chan has finished a complete frame (each row in each bitplane) has been emitted.
     // The row_ctrl_chan resets the start address of row_chan to dma_row_cmd_buffer.
     dma_channel_configure(row_ctrl_chan, &row_ctrl_chan_config, &dma_hw->ch[row_chan].read_addr, &dma_row_cmd_buffer, dma_encode_transfer_count(1), false);
+    row_ctrl_config = row_ctrl_chan_config;
 
     // pixel channel
     pixel_chan = dma_claim_unused_channel(true);
@@ -887,19 +2378,241 @@ static void setup_dma_transfers()
  * 4. Rotation handling:
  *    Odd chain rows are rotated 180° in software
  *
- * Performance considerations:
- * ---------------------------
- * - No divisions inside inner loops
- * - Memory access is mostly linear
- * - LUT + CCM applied inline
+ * Performance considerations:
+ * ---------------------------
+ * - No divisions inside inner loops
+ * - Memory access is mostly linear
+ * - LUT + CCM applied inline
+ */
+
+#if RUNTIME_LUT == true
+// ---------------------------------------------------------------------------
+// Runtime LUTs
+//
+// hub75_lut_generate() writes the set the mapping does not use and marks it
+// pending; colour_sync() makes it the front set before the next frame is
+// mapped, so both cores map a frame with the same tables. Until the first swap
+// the front set are the tables of cie.hpp. lut_state only changes under
+// lut_lock, and a swap only happens from LUT_PENDING - while the generator
+// writes, the back set cannot become the front set.
+// ---------------------------------------------------------------------------
+
+enum lut_state_t : uint32_t
+{
+    LUT_IDLE,
+    LUT_WRITING, ///< hub75_lut_generate() fills the back set
+    LUT_PENDING, ///< back set complete, swapped in by the next colour_sync()
+};
+
+static uint16_t lut_sets[2][3][256];
+static uint32_t lut_curve[256];               ///< normalised curve of the last generated set
+static uint32_t lut_curve_gamma = UINT32_MAX; ///< its gamma, UINT32_MAX: not built yet
+static const uint16_t *lut_front[3] = {CIE_RED, CIE_GREEN, CIE_BLUE};
+static uint32_t lut_swaps = 0;                ///< front set changes, the CCM tables are rebuilt after each
+static volatile uint32_t lut_state = LUT_IDLE;
+static spin_lock_t *lut_lock = nullptr;
+
+#define LUT_RED (lut_front[0])
+#define LUT_GREEN (lut_front[1])
+#define LUT_BLUE (lut_front[2])
+
+// The set the mapping does not read
+static inline uint16_t (*lut_back())[256]
+{
+    return lut_front[0] == lut_sets[0][0] ? lut_sets[1] : lut_sets[0];
+}
+
+static void lut_set_state(uint32_t state)
+{
+    const uint32_t irq_state = spin_lock_blocking(lut_lock);
+    lut_state = state;
+    spin_unlock(lut_lock, irq_state);
+}
+
+/**
+ * @brief Regenerate the brightness LUTs on the device, effective from the next frame on.
+ *
+ * Integer only (see hub75_lut.hpp). The curve is only rebuilt when gamma changes, so animating
+ * caps or black level costs 768 multiplies per call. Call from one core at a time; the mapping
+ * may run on either.
+ *
+ * @param params curve, white point and black level
+ */
+void hub75_lut_generate(const hub75_lut_params_t *params)
+{
+    if (!lut_lock)
+        lut_lock = spin_lock_instance(spin_lock_claim_unused(true));
+
+    lut_set_state(LUT_WRITING); // withdraws a swap still pending
+
+    uint16_t(*back)[256] = lut_back();
+    uint16_t *const tables[3] = {back[0], back[1], back[2]};
+    const uint32_t black = params->black > CCM_MAX_VAL ? CCM_MAX_VAL : params->black;
+    if (params->gamma != lut_curve_gamma)
+    {
+        lut_build_curve(lut_curve, params->gamma);
+        lut_curve_gamma = params->gamma;
+    }
+    lut_scale_tables(tables, lut_curve, params->cap, CCM_MAX_VAL, black);
+
+    __dmb();
+    lut_set_state(LUT_PENDING);
+}
+
+// Make a pending set the front set
+static void lut_swap()
+{
+    const uint32_t irq_state = spin_lock_blocking(lut_lock);
+    if (lut_state == LUT_PENDING)
+    {
+        uint16_t(*back)[256] = lut_back();
+        lut_front[0] = back[0];
+        lut_front[1] = back[1];
+        lut_front[2] = back[2];
+        lut_swaps++;
+        lut_state = LUT_IDLE;
+    }
+    spin_unlock(lut_lock, irq_state);
+}
+#else
+#define LUT_RED CIE_RED
+#define LUT_GREEN CIE_GREEN
+#define LUT_BLUE CIE_BLUE
+#endif
+
+#if CCM_MATRIX == true
+// ---------------------------------------------------------------------------
+// Colour correction matrix
+//
+// hub75_set_ccm() only stores the matrix. The partial-product tables are rebuilt
+// by colour_sync() on the next entry point that maps colours (update*(), pens,
+// hub75_fill_rect(), ...), before any pixel is looked up - so a matrix never
+// changes in the middle of a frame, whichever core maps it. The matrix itself is
+// published with a sequence count like the telemetry.
+// ---------------------------------------------------------------------------
+
+constexpr int16_t ccm_shift_coef(int shift)
+{
+    return shift >= CCM_COEF_BITS ? 0 : (int16_t)(HUB75_CCM_ONE >> shift);
+}
+
+static hub75_ccm_t ccm_matrix = {{
+    {HUB75_CCM_ONE, ccm_shift_coef(CCM_RG_SHIFT), ccm_shift_coef(CCM_RB_SHIFT)},
+    {ccm_shift_coef(CCM_GR_SHIFT), HUB75_CCM_ONE, ccm_shift_coef(CCM_GB_SHIFT)},
+    {ccm_shift_coef(CCM_BR_SHIFT), ccm_shift_coef(CCM_BG_SHIFT), HUB75_CCM_ONE},
+}};
+static volatile uint32_t ccm_seq = 2; ///< odd while hub75_set_ccm() writes ccm_matrix
+static uint32_t ccm_built_seq = 0;    ///< ccm_seq the tables were built for
+static uint32_t ccm_built_luts = 0;   ///< lut_swaps the tables were built for
+
+alignas(8) static ccm_table_t ccm_table;
+
+/**
+ * @brief Set the colour correction matrix, effective from the next frame or pen on.
+ *
+ * Call from one core at a time; the mapping may run on either.
+ *
+ * @param ccm coefficients in units of HUB75_CCM_ONE
+ */
+void hub75_set_ccm(const hub75_ccm_t *ccm)
+{
+    ccm_seq = ccm_seq + 1;
+    __dmb();
+    ccm_matrix = *ccm;
+    __dmb();
+    ccm_seq = ccm_seq + 1;
+}
+
+/**
+ * @brief Read the matrix last passed to hub75_set_ccm() (initially built from the CCM_*_SHIFT terms).
+ */
+void hub75_get_ccm(hub75_ccm_t *ccm)
+{
+    uint32_t seq;
+    do
+    {
+        seq = ccm_seq;
+        __dmb();
+        *ccm = ccm_matrix;
+        __dmb();
+    } while ((seq & 1u) || seq != ccm_seq);
+}
+
+/**
+ * @brief Convert a float matrix (1.0 = unchanged) to fixed point.
+ *
+ * @return false if a coefficient was outside -2.0 .. 2.0 and had to be clamped
  */
+bool hub75_ccm_from_float(hub75_ccm_t *ccm, const float m[3][3])
+{
+    bool in_range = true;
+    for (int o = 0; o < 3; ++o)
+    {
+        for (int s = 0; s < 3; ++s)
+        {
+            float q = roundf(m[o][s] * HUB75_CCM_ONE);
+            if (q < INT16_MIN || q > INT16_MAX)
+            {
+                q = q < 0 ? INT16_MIN : INT16_MAX;
+                in_range = false;
+            }
+            ccm->m[o][s] = (int16_t)q;
+        }
+    }
+    return in_range;
+}
+
+// Rebuild the partial-product tables if the matrix or the LUTs changed since the last build
+static inline void ccm_sync()
+{
+    const uint32_t seq = ccm_seq;
+#if RUNTIME_LUT == true
+    const uint32_t luts = lut_swaps;
+#else
+    const uint32_t luts = 0;
+#endif
+    if (seq == ccm_built_seq && luts == ccm_built_luts)
+        return;
+
+    hub75_ccm_t m;
+    hub75_get_ccm(&m);
+    ccm_build_tables(ccm_table, m.m, LUT_RED, LUT_GREEN, LUT_BLUE);
+    ccm_built_seq = seq;
+    ccm_built_luts = luts;
+}
+
+// Helper: apply LUT and matrix from the partial-product tables and pack into 30-bit RGB
+static inline uint32_t pack_lut_rgb(uint32_t colour)
+{
+    return ccm_pack(ccm_table[0][(colour >> 16u) & 0xFFu], ccm_table[1][(colour >> 8u) & 0xFFu],
+                    ccm_table[2][colour & 0xFFu], CCM_MAX_VAL);
+}
 
+// Helper: apply LUT and matrix from the partial-product tables and pack into 30-bit RGB
+static inline uint32_t pack_lut_rgb_(uint8_t r, uint8_t g, uint8_t b)
+{
+    return ccm_pack(ccm_table[0][r], ccm_table[1][g], ccm_table[2][b], CCM_MAX_VAL);
+}
+
+#if INTERP_MAPPING == true
+// Helper: pack_lut_rgb() with the entry addresses computed by the interpolators (see hub75_interp.hpp)
+static inline uint32_t pack_lut_rgb_interp(uint32_t colour)
+{
+    const void *er, *eg, *eb;
+    interp_lut_lookup(colour, CCM_ENTRY_SHIFT, er, eg, eb);
+    return ccm_pack((const int16_t *)er, (const int16_t *)eg, (const int16_t *)eb, CCM_MAX_VAL);
+}
+
+// Tables and entry size passed to interp_lut_begin() by the RGB888 mapping kernel
+#define MAP_LUT_TABLES ccm_table[0], ccm_table[1], ccm_table[2], CCM_ENTRY_SHIFT
+#endif
+#else
 // Helper: apply LUT and pack into 30-bit RGB (10 bits per channel)
 static inline uint32_t pack_lut_rgb(uint32_t colour)
 {
-    uint32_t rv = CIE_RED[(colour >> 16u) & 0xFFu];
-    uint32_t gv = CIE_GREEN[(colour >> 8u) & 0xFFu];
-    uint32_t bv = CIE_BLUE[colour & 0xFFu];
+    uint32_t rv = LUT_RED[(colour >> 16u) & 0xFFu];
+    uint32_t gv = LUT_GREEN[(colour >> 8u) & 0xFFu];
+    uint32_t bv = LUT_BLUE[colour & 0xFFu];
     CCM_APPLY(rv, gv, bv);
     return (bv << 20u) | (gv << 10u) | rv;
 }
@@ -907,13 +2620,47 @@ static inline uint32_t pack_lut_rgb(uint32_t colour)
 // Helper: apply LUT and pack into 30-bit RGB (10 bits per channel)
 static inline uint32_t pack_lut_rgb_(uint8_t r, uint8_t g, uint8_t b)
 {
-    uint32_t rv = CIE_RED[r];
-    uint32_t gv = CIE_GREEN[g];
-    uint32_t bv = CIE_BLUE[b];
+    uint32_t rv = LUT_RED[r];
+    uint32_t gv = LUT_GREEN[g];
+    uint32_t bv = LUT_BLUE[b];
+    CCM_APPLY(rv, gv, bv);
+    return (bv << 20u) | (gv << 10u) | rv;
+}
+
+#if INTERP_MAPPING == true
+// Helper: pack_lut_rgb() with the table addresses computed by the interpolators (see hub75_interp.hpp)
+static inline uint32_t pack_lut_rgb_interp(uint32_t colour)
+{
+    uint32_t rv, gv, bv;
+    interp_lut_channels(colour, rv, gv, bv);
     CCM_APPLY(rv, gv, bv);
     return (bv << 20u) | (gv << 10u) | rv;
 }
 
+// Tables and entry size passed to interp_lut_begin() by the RGB888 mapping kernel
+#define MAP_LUT_TABLES LUT_RED, LUT_GREEN, LUT_BLUE, 1
+#endif
+#endif
+
+// Bring the tables up to date before a frame or a colour is mapped (hub75_lut_generate(), hub75_set_ccm())
+static inline void colour_sync()
+{
+#if RUNTIME_LUT == true
+    if (lut_state == LUT_PENDING)
+        lut_swap();
+#endif
+#if CCM_MATRIX == true
+    ccm_sync();
+#endif
+}
+
+#if INTERP_MAPPING == true
+// Table lookup of the RGB888 mapping kernel, only valid between interp_lut_begin() and interp_lut_end()
+#define MAP_LUT(COLOUR) power.add(pack_lut_rgb_interp(COLOUR))
+#else
+#define MAP_LUT(COLOUR) power.add(LUT_MAPPING(COLOUR))
+#endif
+
 /**
  * @brief Calculate offset for current row in panel with coordinatres (v, h) in positive or negative (´reverse´) direction,
  *
@@ -973,51 +2720,482 @@ static inline constexpr int rotated_src_index(int dx, int dy, int dw, int dh)
 // then add the column-local `i` to dx_base (not to dy) before passing to rotated_src_index(). Only the W-divide is needed
 // once per (row, v, h[, p]) group; the inner i-loop stays division-free.
 // ---------------------------------------------------------------------------
-static inline uint32_t rot_lut(const uint32_t *src, int dx_base, int dy, int i, int W, int H)
+static inline uint32_t rot_lut(map_power_t &power, const uint32_t *src, int dx_base, int dy, int i, int W, int H)
 {
-    return LUT_MAPPING(src[rotated_src_index(dx_base + i, dy, W, H)]);
+    return MAP_LUT(src[rotated_src_index(dx_base + i, dy, W, H)]);
 }
 
 // BGR/uint8_t* byte-triple variant for update_bgr()
-static inline uint32_t rot_lut_rgb(const uint8_t *src, int dx_base, int dy, int i, int W, int H)
+static inline uint32_t rot_lut_rgb(map_power_t &power, const uint8_t *src, int dx_base, int dy, int i, int W, int H)
 {
     const int32_t rot = rotated_src_index(dx_base + i, dy, W, H) * 3;
-    return LUT_MAPPING_RGB(src[rot + 2], src[rot + 1], src[rot]);
+    return power.add(LUT_MAPPING_RGB(src[rot + 2], src[rot + 1], src[rot]));
+}
+
+// ---------------------------------------------------------------------------
+// Inverse mapping: screen coordinate (x, y) → rgb_buffer slot
+//
+// update() / update_bgr() walk rgb_buffer in scan order and pull the matching
+// source pixel. Writers that produce pixels in screen order (PicoGraphics_PenHUB75)
+// need the opposite direction. Both directions describe the same permutation:
+//
+//   rgb_buffer[scan_slot_index(x, y)] == LUT_MAPPING(src[y * HUB75_SCREEN_WIDTH + x])
+//
+// All divisors are compile-time constants (mostly powers of two), so no
+// runtime division is emitted.
+// ---------------------------------------------------------------------------
+
+// Undo DISPLAY_ROTATION: screen coordinate (sx, sy) → display coordinate (dx, dy)
+static inline void screen_to_display(int sx, int sy, int &dx, int &dy)
+{
+    constexpr int W = DISPLAY_WIDTH;
+    constexpr int H = DISPLAY_HEIGHT;
+#if DISPLAY_ROTATION == 90
+    dx = W - 1 - sy;
+    dy = sx;
+#elif DISPLAY_ROTATION == 180
+    dx = W - 1 - sx;
+    dy = H - 1 - sy;
+#elif DISPLAY_ROTATION == 270
+    dx = sy;
+    dy = H - 1 - sx;
+#else
+    (void)W;
+    (void)H;
+    dx = sx;
+    dy = sy;
+#endif
+}
+
+static inline uint32_t scan_slot_index(int sx, int sy)
+{
+    int dx, dy;
+    screen_to_display(sx, sy, dx, dy);
+
+#if ROW_MAPPING == ROW_MAP_SPLIT && CHAIN_COLS == 1 && CHAIN_ROWS == 1
+    // Inverse of the split-half single panel walk in update():
+    //   rgb_buffer[2j]     = src[index]
+    //   rgb_buffer[2j + 1] = src[index + HALF_PANEL_OFFSET]
+    constexpr int COLUMN_PAIRS = MATRIX_PANEL_WIDTH >> 1;
+    constexpr int HALF_PAIRS = COLUMN_PAIRS >> 1;
+    constexpr int GROUP_ROW_OFFSET = (MATRIX_PANEL_HEIGHT / SCAN_GROUPS) * MATRIX_PANEL_WIDTH;
+    constexpr int HALF_PANEL_OFFSET = (MATRIX_PANEL_HEIGHT >> 1) * MATRIX_PANEL_WIDTH;
+
+    int index = dy * MATRIX_PANEL_WIDTH + dx;
+
+    const int lower_half = index >= HALF_PANEL_OFFSET;
+    if (lower_half)
+        index -= HALF_PANEL_OFFSET;
+
+    const int upper_group = index >= GROUP_ROW_OFFSET;
+    if (upper_group)
+        index -= GROUP_ROW_OFFSET;
+
+    const int line = index / HALF_PAIRS;
+    const int j = line * COLUMN_PAIRS + upper_group * HALF_PAIRS + index % HALF_PAIRS;
+
+    return (uint32_t)((j << 1) + lower_half);
+#else
+    // Every other topology emits one contiguous chunk of MATRIX_PANEL_WIDTH * ROWS_IN_PARALLEL
+    // words per (scan row, v, h), in exactly the loop order used by update().
+    constexpr int SD = PanelConfig::SCAN_DEPTH;
+    constexpr int RIP = PanelConfig::ROWS_IN_PARALLEL;
+
+    const int v = dy / MATRIX_PANEL_HEIGHT;
+    const int phys_h = dx / MATRIX_PANEL_WIDTH;
+    int local_y = dy % MATRIX_PANEL_HEIGHT;
+    int i = dx % MATRIX_PANEL_WIDTH;
+    int h = phys_h;
+
+    const bool reverse = (CHAIN_MODE == CHAIN_MODE_SERPENTINE) && (v & 1);
+    if (reverse)
+    {
+        // Serpentine 180° correction: mirror row, column, panel order
+        local_y = MATRIX_PANEL_HEIGHT - 1 - local_y;
+        i = MATRIX_PANEL_WIDTH - 1 - i;
+        h = CHAIN_COLS - 1 - phys_h;
+    }
+
+    const int row = local_y % SD; // scan address
+    const int p = local_y / SD;   // multiplexed row within that address
+
+    const uint32_t chunk = ((uint32_t)row * CHAIN_ROWS + v) * CHAIN_COLS + h;
+    const uint32_t chunk_base = chunk * (MATRIX_PANEL_WIDTH * RIP);
+
+#if ROW_MAPPING == ROW_MAP_S31
+    // S31 emits quarter pairs (1, 3) for the whole row first, then (0, 2)
+    const uint32_t pair_base = (p & 1) ? 0u : (uint32_t)(MATRIX_PANEL_WIDTH << 1);
+    return chunk_base + pair_base + ((uint32_t)i << 1) + (p >> 1);
+#else
+    return chunk_base + (uint32_t)i * RIP + p;
+#endif
+#endif
 }
 
-#if USE_PICO_GRAPHICS == true
 /**
- * @brief Update frame_buffer from PicoGraphics source (RGB888 / packed 32-bit),
+ * @brief Start the bitplane extraction rgb_buffer → PIO → frame_buffer.
  *
- * @param src Graphics object to be updated - RGB888 format, 24-bits in uint32_t array
+ * read_chan_handler() walks the remaining BCM slices and requests the frame_buffer swap.
  */
-__attribute__((optimize("unroll-loops"))) void update(
-    PicoGraphics const *graphics // Graphics object to be updated - RGB888 format, 24-bits in uint32_t array
-)
+static inline void start_bitplane_build()
 {
-    if (graphics->pen_type != PicoGraphics::PEN_RGB888)
-        return;
+    hub75_trace(HUB75_TRACE_BUILD_BEGIN, 0);
+
+#if SINGLE_FRAME_BUFFER == true
+    // Mark every slice stale; a build already in flight picks up the new content slice by slice
+    uint32_t irq_state = save_and_disable_interrupts();
+    telemetry_present(slice_build_active);
+    slices_pending = (1u << bcm_sequence_length) - 1u;
+    if (slice_build_active)
+        slice_invalidated = true;
+    else
+        start_next_slice();
+    restore_interrupts(irq_state);
+#else
+    telemetry_present(bitplane_build_active || swap_frame_buffer_pending);
+#if IDLE_REFRESH == true
+    build_black = idle_blank_black && rgb_buffer_black();
+#endif
+    bitplane_build_active = true;
+    dma_channel_set_write_addr(write_chan, frame_buffer, false);
+    dma_channel_set_read_addr(read_chan, rgb_buffer, false);
+    dma_start_channel_mask((1u << read_chan) | (1u << write_chan));
+#endif
+#if IDLE_REFRESH == true
+    idle_wake();
+#endif
+}
 
-#if DISPLAY_ROTATION == 90 || DISPLAY_ROTATION == 270
-    constexpr int expected_w = DISPLAY_HEIGHT;
-    constexpr int expected_h = DISPLAY_WIDTH;
-    const char *const error_msg = "For DISPLAY_ROTATION 90/270, width must be DISPLAY_HEIGHT and height must be DISPLAY_WIDTH!";
+/**
+ * @brief Map a rectangle of BGR pixels into rgb_buffer without presenting it.
+ *
+ * Only the slots covered by the rectangle are touched, the rest of rgb_buffer keeps
+ * the previous frame. Call hub75_present() once all changes are written.
+ * The rectangle is clipped to the screen.
+ *
+ * @param x, y   top-left screen coordinate
+ * @param w, h   rectangle size in pixels
+ * @param src    BGR pixels (B, G, R byte order like update_bgr())
+ * @param stride distance between source rows in bytes
+ */
+void hub75_write_rect_bgr(int x, int y, int w, int h, const uint8_t *src, int stride)
+{
+    colour_sync();
+
+    const int x0 = x < 0 ? 0 : x;
+    const int y0 = y < 0 ? 0 : y;
+    const int x1 = (x + w > (int)HUB75_SCREEN_WIDTH) ? (int)HUB75_SCREEN_WIDTH : x + w;
+    const int y1 = (y + h > (int)HUB75_SCREEN_HEIGHT) ? (int)HUB75_SCREEN_HEIGHT : y + h;
+
+    for (int sy = y0; sy < y1; ++sy)
+    {
+        const uint8_t *s = src + (sy - y) * stride + (x0 - x) * 3;
+        for (int sx = x0; sx < x1; ++sx, s += 3)
+        {
+            rgb_buffer[scan_slot_index(sx, sy)] = LUT_MAPPING_RGB(s[2], s[1], s[0]);
+        }
+    }
+}
+
+/**
+ * @brief Fill a rectangle of rgb_buffer with one colour without presenting it.
+ *
+ * The colour goes through the LUT/CCM once. The rectangle is clipped to the screen.
+ */
+void hub75_fill_rect(int x, int y, int w, int h, uint8_t r, uint8_t g, uint8_t b)
+{
+    colour_sync();
+    const uint32_t value = LUT_MAPPING_RGB(r, g, b);
+    const int x0 = x < 0 ? 0 : x;
+    const int y0 = y < 0 ? 0 : y;
+    const int x1 = (x + w > (int)HUB75_SCREEN_WIDTH) ? (int)HUB75_SCREEN_WIDTH : x + w;
+    const int y1 = (y + h > (int)HUB75_SCREEN_HEIGHT) ? (int)HUB75_SCREEN_HEIGHT : y + h;
+
+    for (int sy = y0; sy < y1; ++sy)
+    {
+        for (int sx = x0; sx < x1; ++sx)
+        {
+            rgb_buffer[scan_slot_index(sx, sy)] = value;
+        }
+    }
+}
+
+/**
+ * @brief rgb_buffer slot of screen pixel (x, y), or -1 outside the screen.
+ *
+ * For writers that resolve their pixel order once up front (see hub75_write_slots_rgb()).
+ */
+int hub75_scan_slot(int x, int y)
+{
+    if (x < 0 || y < 0 || x >= (int)HUB75_SCREEN_WIDTH || y >= (int)HUB75_SCREEN_HEIGHT)
+        return -1;
+    return (int)scan_slot_index(x, y);
+}
+
+/**
+ * @brief Map n RGB pixels into precomputed rgb_buffer slots without presenting them.
+ *
+ * @param slots rgb_buffer slots from hub75_scan_slot(), HUB75_NO_SLOT skips a pixel
+ * @param rgb   n pixels in R, G, B byte order (DMX channel order)
+ */
+void hub75_write_slots_rgb(const uint16_t *slots, int n, const uint8_t *rgb)
+{
+    colour_sync();
+    for (int k = 0; k < n; ++k, rgb += 3)
+    {
+        if (slots[k] != HUB75_NO_SLOT)
+            rgb_buffer[slots[k]] = LUT_MAPPING_RGB(rgb[0], rgb[1], rgb[2]);
+    }
+}
+
+/**
+ * @brief Build bitplanes from the current rgb_buffer content and swap them in at the next frame boundary.
+ *
+ * Counterpart of hub75_write_rect_bgr(). Wait for hub75_present_pending() to return false
+ * before writing the next frame, otherwise the running build picks up a mix of both.
+ */
+void hub75_present(void)
+{
+    start_bitplane_build();
+}
+
+/**
+ * @brief Check whether the last presented frame is still being built or waiting for its swap.
+ *
+ * @return true until the frame is on the panel
+ */
+bool hub75_present_pending(void)
+{
+#if SINGLE_FRAME_BUFFER == true
+    return slice_build_active;
 #else
-    constexpr int expected_w = DISPLAY_WIDTH;
-    constexpr int expected_h = DISPLAY_HEIGHT;
-    const char *const error_msg = "For DISPLAY_ROTATION 0/180, width must be DISPLAY_WIDTH and height must be DISPLAY_HEIGHT!";
+    return bitplane_build_active || swap_frame_buffer_pending;
 #endif
+}
 
-    if (graphics->bounds.w != expected_w || graphics->bounds.h != expected_h)
+// ---------------------------------------------------------------------------
+// Parallel mapping
+//
+// update() / update_bgr() split rgb_buffer by scan rows into MAP_PARTS parts.
+// Every part is a consecutive range of rgb_buffer words, so the parts never share
+// a word and can be written by both cores at once. The caller posts the second part,
+// maps the first and then either waits for the other core or, if hub75_map_poll()
+// has not picked the job up by then, maps the second part as well. A busy or idle
+// core1 therefore never blocks update() for longer than the mapping itself.
+// ---------------------------------------------------------------------------
+
+constexpr uint MAP_PARTS = PARALLEL_MAPPING ? 2 : 1;
+
+// First of n units (scan rows, lines, ...) belonging to part `part`
+static inline int part_begin(int n, uint part)
+{
+    return n * (int)part / (int)MAP_PARTS;
+}
+
+#if POWER_LIMIT == true
+static map_power_t power_parts[MAP_PARTS];
+
+// Output sums of a part, summed by power_parts_mapped() once all parts are done
+static inline void power_part_done(uint part, const map_power_t &power)
+{
+    power_parts[part] = power;
+}
+
+// Adjust the brightness to the parts mapped by map_parallel()
+static inline void power_parts_mapped()
+{
+    map_power_t sum;
+    for (uint part = 0; part < MAP_PARTS; ++part)
     {
-        printf("\n[HUB75 ERROR] Dimension Mismatch!\n");
-        printf("Expected: %dx%d, Got: %dx%d\n", expected_w, expected_h, graphics->bounds.w, graphics->bounds.h);
+        sum.r += power_parts[part].r;
+        sum.g += power_parts[part].g;
+        sum.b += power_parts[part].b;
+    }
+    power_mapped(sum);
+}
+#else
+static inline void power_part_done(uint, const map_power_t &)
+{
+}
 
-        // Hard panic halts both pico cores and prints a clean debug trace over the terminal
-        panic(error_msg);
+static inline void power_parts_mapped()
+{
+}
+#endif
+
+typedef void (*map_fn_t)(const void *src, uint part);
+
+enum map_job_state : uint32_t
+{
+    MAP_JOB_IDLE,
+    MAP_JOB_POSTED,  ///< waiting for a core to claim it
+    MAP_JOB_CLAIMED, ///< being mapped by the other core
+    MAP_JOB_DONE,    ///< mapped by the other core
+};
+
+static struct
+{
+    map_fn_t map;
+    const void *src;
+    uint caller_core;
+    volatile uint32_t state;
+} map_job;
+
+static spin_lock_t *map_lock = nullptr;
+
+static void map_job_init()
+{
+#if PARALLEL_MAPPING == true
+    if (!map_lock)
+        map_lock = spin_lock_instance(spin_lock_claim_unused(true));
+#endif
+}
+
+// Move the posted job to `next`, false if someone else was faster
+static bool map_job_claim(uint32_t next)
+{
+    const uint32_t irq_state = spin_lock_blocking(map_lock);
+    const bool claimed = map_job.state == MAP_JOB_POSTED;
+    if (claimed)
+        map_job.state = next;
+    spin_unlock(map_lock, irq_state);
+    return claimed;
+}
+
+// Map all parts of src into rgb_buffer, sharing the work with the other core if it is polling
+static void HUB75_RAM_FUNC(map_parallel)(map_fn_t map, const void *src)
+{
+    const uint32_t start_us = time_us_32();
+
+    colour_sync(); // before the other core can claim its part
+
+    if (MAP_PARTS == 1 || !map_lock)
+    {
+        for (uint part = 0; part < MAP_PARTS; ++part)
+            map(src, part);
+        power_parts_mapped();
+        telemetry_mapped(start_us);
+        return;
+    }
+
+    map_job.map = map;
+    map_job.src = src;
+    map_job.caller_core = get_core_num();
+    __dmb();
+    map_job.state = MAP_JOB_POSTED;
+    __sev(); // wake a core idling in __wfe()
+
+    map(src, 0);
+
+    if (map_job_claim(MAP_JOB_IDLE))
+    {
+        map(src, 1);
+    }
+    else
+    {
+        while (map_job.state != MAP_JOB_DONE)
+            __wfe();
+        __dmb();
+        map_job.state = MAP_JOB_IDLE;
+    }
+    power_parts_mapped();
+    telemetry_mapped(start_us);
+}
+
+/**
+ * @brief Map the second half of a pending update() / update_bgr() call.
+ *
+ * Call this frequently from an idle loop on the core that does not call update(),
+ * e.g. core1_entry(). Returns immediately if nothing is pending, so it can share
+ * the loop with hub75_anim_poll(). Does nothing with PARALLEL_MAPPING false.
+ *
+ * @return true if a part was mapped
+ */
+bool HUB75_RAM_FUNC(hub75_map_poll)(void)
+{
+    if (map_job.state != MAP_JOB_POSTED || map_job.caller_core == get_core_num())
+        return false;
+
+    if (!map_job_claim(MAP_JOB_CLAIMED))
+        return false;
+
+    __dmb();
+    map_job.map(map_job.src, 1);
+    __dmb();
+    map_job.state = MAP_JOB_DONE;
+    __sev();
+    return true;
+}
+
+#if USE_PICO_GRAPHICS == true
+PicoGraphics_PenHUB75::PicoGraphics_PenHUB75()
+    : PicoGraphics(HUB75_SCREEN_WIDTH, HUB75_SCREEN_HEIGHT, rgb_buffer)
+{
+    this->pen_type = PEN_HUB75;
+    set_pen(0u);
+}
+
+void PicoGraphics_PenHUB75::set_pen(uint c)
+{
+    src_color = RGB(c);
+    colour_sync();
+    color = LUT_MAPPING(c);
+}
+
+void PicoGraphics_PenHUB75::set_pen(uint8_t r, uint8_t g, uint8_t b)
+{
+    src_color = {r, g, b};
+    colour_sync();
+    color = LUT_MAPPING_RGB(r, g, b);
+}
+
+int PicoGraphics_PenHUB75::create_pen(uint8_t r, uint8_t g, uint8_t b)
+{
+    return RGB(r, g, b).to_rgb888();
+}
+
+int PicoGraphics_PenHUB75::create_pen_hsv(float h, float s, float v)
+{
+    return RGB::from_hsv(h, s, v).to_rgb888();
+}
+
+void PicoGraphics_PenHUB75::set_pixel(const Point &p)
+{
+    rgb_buffer[scan_slot_index(p.x, p.y)] = color;
+}
+
+void PicoGraphics_PenHUB75::set_pixel_span(const Point &p, uint l)
+{
+    // Colour is already mapped - only the slot lookup remains per pixel
+    const uint32_t c = color;
+    for (int x = p.x, end = p.x + (int)l; x < end; ++x)
+    {
+        rgb_buffer[scan_slot_index(x, p.y)] = c;
+    }
+}
+
+void PicoGraphics_PenHUB75::clear()
+{
+    if (clip.x == 0 && clip.y == 0 && clip.w == bounds.w && clip.h == bounds.h)
+    {
+        std::fill_n(rgb_buffer, TOTAL_PIXELS, color);
     }
+    else
+    {
+        PicoGraphics::clear();
+    }
+}
 
-    uint32_t const *src = static_cast<uint32_t const *>(graphics->frame_buffer);
+// Scan rows of part `part` (0 .. MAP_PARTS-1) of an RGB888 source, see map_parallel()
+__attribute__((optimize("unroll-loops"))) static void HUB75_RAM_FUNC(map_rgb888)(const void *source, uint part)
+{
+    uint32_t const *src = static_cast<uint32_t const *>(source);
+    map_power_t power;
+
+#if INTERP_MAPPING == true
+    interp_lut_t interp_state;
+    interp_lut_begin(interp_state, MAP_LUT_TABLES);
+#endif
 
 #if ROW_MAPPING == ROW_MAP_STANDARD
 #if CHAIN_COLS == 1 && CHAIN_ROWS == 1
@@ -1028,18 +3206,21 @@ __attribute__((optimize("unroll-loops"))) void update(
 
     constexpr int rows_per_bank = H / PanelConfig::ROWS_IN_PARALLEL;
 
-    int32_t fb_index = 0;
+    const int row_begin = part_begin(rows_per_bank, part);
+    const int row_end = part_begin(rows_per_bank, part + 1);
+
+    int32_t fb_index = row_begin * W * PanelConfig::ROWS_IN_PARALLEL;
 
-    int dx = 0;          // column:       0 .. W-1, then wraps
-    int row_in_bank = 0; // row within one bank: 0 .. rows_per_bank-1
+    int dx = 0;                  // column:       0 .. W-1, then wraps
+    int row_in_bank = row_begin; // row within one bank: 0 .. rows_per_bank-1
 
-    for (int32_t i = 0; i < PanelConfig::stride_to_paired_row; ++i)
+    for (int32_t i = row_begin * W; i < row_end * W; ++i)
     {
         for (int p = 0; p < PanelConfig::ROWS_IN_PARALLEL; ++p)
         {
             // dy = which display row: bank p starts at p * rows_per_bank
             const int dy = p * rows_per_bank + row_in_bank;
-            rgb_buffer[fb_index++] = LUT_MAPPING(src[rotated_src_index(dx, dy, W, H)]);
+            rgb_buffer[fb_index++] = MAP_LUT(src[rotated_src_index(dx, dy, W, H)]);
         }
 
         // Advance column; roll over into next row-within-bank
@@ -1082,9 +3263,13 @@ __attribute__((optimize("unroll-loops"))) void update(
     // authoritative source (== MATRIX_PANEL_HEIGHT / ROWS_IN_PARALLEL).
     constexpr int rows_per_bank = PanelConfig::SCAN_DEPTH;
 
-    int32_t fb_index = 0;
+    // Every scan row fills the same number of consecutive rgb_buffer words
+    const int row_begin = part_begin(PanelConfig::SCAN_DEPTH, part);
+    const int row_end = part_begin(PanelConfig::SCAN_DEPTH, part + 1);
 
-    for (int row = 0; row < PanelConfig::SCAN_DEPTH; row++) // row: current row
+    int32_t fb_index = row_begin * (TOTAL_PIXELS / PanelConfig::SCAN_DEPTH);
+
+    for (int row = row_begin; row < row_end; row++) // row: current row
     {
         for (int v = 0; v < CHAIN_ROWS; v++) // v: panel in row (vertical chain)
         {
@@ -1115,7 +3300,7 @@ __attribute__((optimize("unroll-loops"))) void update(
                         for (int p = 0; p < PanelConfig::ROWS_IN_PARALLEL; ++p)
                         {
                             const int dy = dy_base - p * rows_per_bank;
-                            rgb_buffer[fb_index++] = rot_lut(src, dx_base, dy, i, W, H);
+                            rgb_buffer[fb_index++] = rot_lut(power, src, dx_base, dy, i, W, H);
                         }
                     }
                 }
@@ -1126,7 +3311,7 @@ __attribute__((optimize("unroll-loops"))) void update(
                         for (int p = 0; p < PanelConfig::ROWS_IN_PARALLEL; ++p)
                         {
                             const int dy = dy_base + p * rows_per_bank;
-                            rgb_buffer[fb_index++] = rot_lut(src, dx_base, dy, i, W, H);
+                            rgb_buffer[fb_index++] = rot_lut(power, src, dx_base, dy, i, W, H);
                         }
                     }
                 }
@@ -1145,7 +3330,6 @@ __attribute__((optimize("unroll-loops"))) void update(
     constexpr int W = DISPLAY_WIDTH;
     constexpr int H = DISPLAY_HEIGHT;
 
-    int line = 0;
     int counter = 0;
 
     constexpr int COLUMN_PAIRS = MATRIX_PANEL_WIDTH >> 1;
@@ -1161,7 +3345,12 @@ __attribute__((optimize("unroll-loops"))) void update(
 
     constexpr int total_pairs = (MATRIX_PANEL_WIDTH * MATRIX_PANEL_HEIGHT) >> 1;
 
-    for (int j = 0, fb_index = 0; j < total_pairs; ++j, fb_index += 2)
+    // Split by lines of COLUMN_PAIRS pairs, the pair index restarts at the first line of the part
+    constexpr int lines = total_pairs / COLUMN_PAIRS;
+    int line = part_begin(lines, part);
+    const int j_end = part_begin(lines, part + 1) * COLUMN_PAIRS;
+
+    for (int j = line * COLUMN_PAIRS, fb_index = 2 * j; j < j_end; ++j, fb_index += 2)
     {
         // Panel-side flat index (destination address in display space).
         // Single-panel case: this index is always within [0, W*H), so a
@@ -1169,8 +3358,8 @@ __attribute__((optimize("unroll-loops"))) void update(
         const int32_t index = !(j & PAIR_HALF_BIT) ? j - (line << PAIR_HALF_SHIFT) : GROUP_ROW_OFFSET + j - ((line + 1) << PAIR_HALF_SHIFT);
         const int32_t index2 = index + HALF_PANEL_OFFSET;
 
-        rgb_buffer[fb_index] = LUT_MAPPING(src[rotated_src_index(index % W, index / W, W, H)]);
-        rgb_buffer[fb_index + 1] = LUT_MAPPING(src[rotated_src_index(index2 % W, index2 / W, W, H)]);
+        rgb_buffer[fb_index] = MAP_LUT(src[rotated_src_index(index % W, index / W, W, H)]);
+        rgb_buffer[fb_index + 1] = MAP_LUT(src[rotated_src_index(index2 % W, index2 / W, W, H)]);
 
         if (++counter >= COLUMN_PAIRS)
         {
@@ -1185,9 +3374,12 @@ __attribute__((optimize("unroll-loops"))) void update(
     constexpr int W = DISPLAY_WIDTH;
     constexpr int H = DISPLAY_HEIGHT;
 
-    size_t fb_index = 0;
+    const int row_begin = part_begin(PanelConfig::SCAN_DEPTH, part);
+    const int row_end = part_begin(PanelConfig::SCAN_DEPTH, part + 1);
 
-    for (int row = 0; row < PanelConfig::SCAN_DEPTH; ++row)
+    size_t fb_index = row_begin * (TOTAL_PIXELS / PanelConfig::SCAN_DEPTH);
+
+    for (int row = row_begin; row < row_end; ++row)
     {
         for (int v = 0; v < CHAIN_ROWS; ++v)
         {
@@ -1197,11 +3389,13 @@ __attribute__((optimize("unroll-loops"))) void update(
             {
                 const int32_t row_base = map_panel_row(row, v, h, reverse);
 
+                // Scan groups step downwards from the mirrored row on reversed panels (same as S31)
+                const int32_t sign = reverse ? -1 : 1;
                 const int32_t row_ptr[4] = {
-                    row_base + scan_map[0] * PanelConfig::stride_to_paired_row,
-                    row_base + scan_map[1] * PanelConfig::stride_to_paired_row,
-                    row_base + scan_map[2] * PanelConfig::stride_to_paired_row,
-                    row_base + scan_map[3] * PanelConfig::stride_to_paired_row,
+                    row_base + sign * scan_map[0] * PanelConfig::stride_to_paired_row,
+                    row_base + sign * scan_map[1] * PanelConfig::stride_to_paired_row,
+                    row_base + sign * scan_map[2] * PanelConfig::stride_to_paired_row,
+                    row_base + sign * scan_map[3] * PanelConfig::stride_to_paired_row,
                 };
 
                 // row_ptr[p] is only guaranteed W-aligned when CHAIN_COLS == 1.
@@ -1214,13 +3408,13 @@ __attribute__((optimize("unroll-loops"))) void update(
                     // Serpentine physical 180° correction:
                     //   - scan row reversed  → map_panel_row
                     //   - i reversed         → below
-                    //   - scan group order   → p counts 3..0
+                    //   - scan group rows    → negative sign on row_ptr
                     // DISPLAY_ROTATION composited independently via rot_lut().
                     for (int i = MATRIX_PANEL_WIDTH - 1; i >= 0; --i)
                     {
-                        for (int p = 3; p >= 0; --p)
+                        for (int p = 0; p < 4; ++p)
                         {
-                            rgb_buffer[fb_index++] = rot_lut(src, dx_base[p], dy[p], i, W, H);
+                            rgb_buffer[fb_index++] = rot_lut(power, src, dx_base[p], dy[p], i, W, H);
                         }
                     }
                 }
@@ -1231,7 +3425,7 @@ __attribute__((optimize("unroll-loops"))) void update(
                     {
                         for (int p = 0; p < 4; ++p)
                         {
-                            rgb_buffer[fb_index++] = rot_lut(src, dx_base[p], dy[p], i, W, H);
+                            rgb_buffer[fb_index++] = rot_lut(power, src, dx_base[p], dy[p], i, W, H);
                         }
                     }
                 }
@@ -1256,27 +3450,30 @@ __attribute__((optimize("unroll-loops"))) void update(
 
         constexpr uint quarter = total_pixels >> 2; // number of pixels in a quarter of the panel
 
-        uint quarter1 = 0 * quarter; // rows in quarter1  0–15
-        uint quarter2 = 1 * quarter; // rows in quarter2  16–31
-        uint quarter3 = 2 * quarter; // rows in quarter3  32–47
-        uint quarter4 = 3 * quarter; // rows in quarter4  48–63
+        constexpr uint lines = PanelConfig::HEIGHT >> 2;
 
-        uint p = 0; // per line pixel counter
+        uint line = part_begin(lines, part); // Number of logical rows processed
+        const uint line_end = part_begin(lines, part + 1);
 
-        uint line = 0; // Number of logical rows processed
+        uint quarter1 = 0 * quarter + line * W; // rows in quarter1  0–15
+        uint quarter2 = 1 * quarter + line * W; // rows in quarter2  16–31
+        uint quarter3 = 2 * quarter + line * W; // rows in quarter3  32–47
+        uint quarter4 = 3 * quarter + line * W; // rows in quarter4  48–63
+
+        uint p = 0; // per line pixel counter
 
-        uint32_t *dst = rgb_buffer; // rgb_buffer write pointer
+        uint32_t *dst = rgb_buffer + line * (2 * PanelConfig::WIDTH + line_offset); // rgb_buffer write pointer
 
         // Each iteration processes 4 physical rows (2 scan-row pairs)
-        while (line < (PanelConfig::HEIGHT >> 2))
+        while (line < line_end)
         {
-            dst[0] = LUT_MAPPING(src[rotated_src_index(quarter2 % W, quarter2 / W, W, H)]);
+            dst[0] = MAP_LUT(src[rotated_src_index(quarter2 % W, quarter2 / W, W, H)]);
             ++quarter2;
-            dst[1] = LUT_MAPPING(src[rotated_src_index(quarter4 % W, quarter4 / W, W, H)]);
+            dst[1] = MAP_LUT(src[rotated_src_index(quarter4 % W, quarter4 / W, W, H)]);
             ++quarter4;
-            dst[line_offset + 0] = LUT_MAPPING(src[rotated_src_index(quarter1 % W, quarter1 / W, W, H)]);
+            dst[line_offset + 0] = MAP_LUT(src[rotated_src_index(quarter1 % W, quarter1 / W, W, H)]);
             ++quarter1;
-            dst[line_offset + 1] = LUT_MAPPING(src[rotated_src_index(quarter3 % W, quarter3 / W, W, H)]);
+            dst[line_offset + 1] = MAP_LUT(src[rotated_src_index(quarter3 % W, quarter3 / W, W, H)]);
             ++quarter3;
 
             dst += 2;
@@ -1295,9 +3492,12 @@ __attribute__((optimize("unroll-loops"))) void update(
     constexpr int W = DISPLAY_WIDTH;
     constexpr int H = DISPLAY_HEIGHT;
 
-    size_t fb_index = 0;
+    const int row_begin = part_begin(PanelConfig::SCAN_DEPTH, part);
+    const int row_end = part_begin(PanelConfig::SCAN_DEPTH, part + 1);
 
-    for (int row = 0; row < PanelConfig::SCAN_DEPTH; row++)
+    size_t fb_index = row_begin * (TOTAL_PIXELS / PanelConfig::SCAN_DEPTH);
+
+    for (int row = row_begin; row < row_end; row++)
     {
         for (int v = 0; v < CHAIN_ROWS; v++)
         {
@@ -1332,13 +3532,13 @@ __attribute__((optimize("unroll-loops"))) void update(
                     // DISPLAY_ROTATION composited independently via rot_lut().
                     for (int i = MATRIX_PANEL_WIDTH - 1; i >= 0; --i)
                     {
-                        rgb_buffer[fb_index++] = rot_lut(src, dx_base1, dy1, i, W, H);
-                        rgb_buffer[fb_index++] = rot_lut(src, dx_base3, dy3, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut(power, src, dx_base1, dy1, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut(power, src, dx_base3, dy3, i, W, H);
                     }
                     for (int i = MATRIX_PANEL_WIDTH - 1; i >= 0; --i)
                     {
-                        rgb_buffer[fb_index++] = rot_lut(src, dx_base0, dy0, i, W, H);
-                        rgb_buffer[fb_index++] = rot_lut(src, dx_base2, dy2, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut(power, src, dx_base0, dy0, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut(power, src, dx_base2, dy2, i, W, H);
                     }
                 }
                 else
@@ -1346,13 +3546,13 @@ __attribute__((optimize("unroll-loops"))) void update(
                     // Normal orientation
                     for (int i = 0; i < MATRIX_PANEL_WIDTH; ++i)
                     {
-                        rgb_buffer[fb_index++] = rot_lut(src, dx_base1, dy1, i, W, H);
-                        rgb_buffer[fb_index++] = rot_lut(src, dx_base3, dy3, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut(power, src, dx_base1, dy1, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut(power, src, dx_base3, dy3, i, W, H);
                     }
                     for (int i = 0; i < MATRIX_PANEL_WIDTH; ++i)
                     {
-                        rgb_buffer[fb_index++] = rot_lut(src, dx_base0, dy0, i, W, H);
-                        rgb_buffer[fb_index++] = rot_lut(src, dx_base2, dy2, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut(power, src, dx_base0, dy0, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut(power, src, dx_base2, dy2, i, W, H);
                     }
                 }
             }
@@ -1360,23 +3560,212 @@ __attribute__((optimize("unroll-loops"))) void update(
     }
 #endif
 #endif
-    // Kick off building bitplanes from rgb_buffer to be written to frame_buffer
-    dma_channel_set_write_addr(write_chan, frame_buffer, false);
-    dma_channel_set_read_addr(read_chan, rgb_buffer, false);
-    dma_start_channel_mask((1u << read_chan) | (1u << write_chan));
-}
+
+#if INTERP_MAPPING == true
+    interp_lut_end(interp_state);
 #endif
+    power_part_done(part, power);
+}
 
 /**
- * @brief Updates the frame buffer with pixel data from the source array.
+ * @brief Update frame_buffer from PicoGraphics source (RGB888 / packed 32-bit),
  *
- * This function takes a source array of pixel data and updates the frame buffer
- * with interleaved pixel values. The pixel values are CIE-corrected to 10 bits using a lookup table.
+ * A PicoGraphics_PenHUB75 source already lives in rgb_buffer in scan order,
+ * so only the bitplane extraction is started. Other sources are mapped by both
+ * cores if the other one calls hub75_map_poll().
  *
  * @param src Graphics object to be updated - RGB888 format, 24-bits in uint32_t array
  */
-__attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
+void update(
+    PicoGraphics const *graphics // Graphics object to be updated - RGB888 format, 24-bits in uint32_t array
+)
+{
+    if (graphics->pen_type == PicoGraphics::PEN_HUB75)
+    {
+        start_bitplane_build();
+        return;
+    }
+
+    if (graphics->pen_type != PicoGraphics::PEN_RGB888)
+        return;
+
+    hub75_trace(HUB75_TRACE_UPDATE_BEGIN, 0);
+
+#if DISPLAY_ROTATION == 90 || DISPLAY_ROTATION == 270
+    constexpr int expected_w = DISPLAY_HEIGHT;
+    constexpr int expected_h = DISPLAY_WIDTH;
+    const char *const error_msg = "For DISPLAY_ROTATION 90/270, width must be DISPLAY_HEIGHT and height must be DISPLAY_WIDTH!";
+#else
+    constexpr int expected_w = DISPLAY_WIDTH;
+    constexpr int expected_h = DISPLAY_HEIGHT;
+    const char *const error_msg = "For DISPLAY_ROTATION 0/180, width must be DISPLAY_WIDTH and height must be DISPLAY_HEIGHT!";
+#endif
+
+    if (graphics->bounds.w != expected_w || graphics->bounds.h != expected_h)
+    {
+        printf("\n[HUB75 ERROR] Dimension Mismatch!\n");
+        printf("Expected: %dx%d, Got: %dx%d\n", expected_w, expected_h, graphics->bounds.w, graphics->bounds.h);
+
+        // Hard panic halts both pico cores and prints a clean debug trace over the terminal
+        panic(error_msg);
+    }
+
+    map_parallel(map_rgb888, graphics->frame_buffer);
+
+    hub75_trace(HUB75_TRACE_UPDATE_END, 0);
+
+    // Kick off building bitplanes from rgb_buffer to be written to frame_buffer
+    start_bitplane_build();
+}
+
+// ---------------------------------------------------------------------------
+// Render/map pipeline
+//
+// Two RGB888 source buffers circulate between the render core and the mapping
+// core through two single-producer single-consumer queues: `ready` carries
+// rendered frames to the mapping core, `free` hands mapped buffers back. Each
+// buffer is owned by exactly one side at a time - the renderer owns the one its
+// PicoGraphics object points to, the mapper owns the head of `ready` until it
+// has been mapped. Each queue index is written by one core only, so no lock is
+// needed, just a barrier between the slot and the index.
+// ---------------------------------------------------------------------------
+
+constexpr uint32_t PIPELINE_BUFFERS = 2;
+
+struct frame_queue_t
+{
+    void *slots[PIPELINE_BUFFERS];
+    volatile uint32_t head; ///< frames pushed, written by the producer only
+    volatile uint32_t tail; ///< frames popped, written by the consumer only
+};
+
+static struct
+{
+    frame_queue_t ready; ///< render core → mapping core
+    frame_queue_t free;  ///< mapping core → render core
+    PicoGraphics *graphics;
+    volatile bool active;
+} pipeline;
+
+static void queue_push(frame_queue_t &q, void *buffer)
+{
+    // Never full: there are only PIPELINE_BUFFERS buffers and the producer holds this one
+    q.slots[q.head % PIPELINE_BUFFERS] = buffer;
+    __dmb();
+    q.head = q.head + 1;
+    __sev();
+}
+
+// Oldest buffer in the queue, nullptr if empty
+static void *queue_front(const frame_queue_t &q)
+{
+    if (q.head == q.tail)
+        return nullptr;
+    __dmb();
+    return q.slots[q.tail % PIPELINE_BUFFERS];
+}
+
+static void queue_pop(frame_queue_t &q)
+{
+    __dmb();
+    q.tail = q.tail + 1;
+}
+
+/**
+ * @brief Start the render/map pipeline.
+ *
+ * The render core draws into `graphics` while the other core maps the previous frame and
+ * starts its bitplane build in hub75_pipeline_poll(). `graphics` keeps its current frame
+ * buffer as the first of the two buffers; `second_buffer` must have the same size
+ * (HUB75_SCREEN_WIDTH * HUB75_SCREEN_HEIGHT uint32_t). Call this before hub75_pipeline_poll()
+ * runs and don't use update() for `graphics` afterwards.
+ *
+ * @param graphics      RGB888 PicoGraphics object of the screen size, owned by the render core
+ * @param second_buffer second RGB888 frame buffer
+ * @return false if `graphics` is not RGB888 or does not match the screen size
+ */
+bool hub75_pipeline_init(PicoGraphics *graphics, void *second_buffer)
+{
+    if (graphics->pen_type != PicoGraphics::PEN_RGB888 ||
+        graphics->bounds.w != (int)HUB75_SCREEN_WIDTH || graphics->bounds.h != (int)HUB75_SCREEN_HEIGHT)
+        return false;
+
+    pipeline.active = false;
+    __dmb();
+
+    pipeline.graphics = graphics;
+    pipeline.ready.head = pipeline.ready.tail = 0;
+    pipeline.free.head = pipeline.free.tail = 0;
+    queue_push(pipeline.free, second_buffer);
+
+    __dmb();
+    pipeline.active = true;
+    return true;
+}
+
+/**
+ * @brief Hand the rendered frame to the mapping core and switch `graphics` to the other buffer.
+ *
+ * Waits until the mapping core has released the other buffer, i.e. until the frame before
+ * has been mapped. While waiting the render core helps with the mapping (hub75_map_poll()).
+ * The buffer handed back still holds the frame before last - redraw it completely.
+ */
+void hub75_pipeline_submit(void)
+{
+    PicoGraphics *graphics = pipeline.graphics;
+    queue_push(pipeline.ready, graphics->frame_buffer);
+
+    void *next;
+    while (!(next = queue_front(pipeline.free)))
+    {
+        if (!hub75_map_poll())
+            __wfe();
+    }
+    queue_pop(pipeline.free);
+
+    graphics->set_framebuffer(next);
+}
+
+/**
+ * @brief Map the oldest submitted frame and start its bitplane build.
+ *
+ * Call this frequently from an idle loop on the other core, e.g. core1_entry(). A frame is
+ * only taken once the previous one has reached the panel, so every rendered frame is shown
+ * and a renderer that is faster than the panel is throttled in hub75_pipeline_submit().
+ *
+ * @return true if a frame was mapped
+ */
+bool hub75_pipeline_poll(void)
+{
+    if (!pipeline.active || hub75_present_pending())
+        return false;
+
+    void *src = queue_front(pipeline.ready);
+    if (!src)
+        return false;
+
+    hub75_trace(HUB75_TRACE_UPDATE_BEGIN, 4);
+
+    map_parallel(map_rgb888, src);
+
+    // The source buffer goes back to the renderer, the frame lives on in rgb_buffer
+    queue_pop(pipeline.ready);
+    queue_push(pipeline.free, src);
+
+    hub75_trace(HUB75_TRACE_UPDATE_END, 0);
+
+    // Kick off building bitplanes from rgb_buffer to be written to frame_buffer
+    start_bitplane_build();
+    return true;
+}
+#endif
+
+// Scan rows of part `part` (0 .. MAP_PARTS-1) of a BGR source, see map_parallel()
+__attribute__((optimize("unroll-loops"))) static void HUB75_RAM_FUNC(map_bgr)(const void *source, uint part)
 {
+    const uint8_t *src = static_cast<const uint8_t *>(source);
+    map_power_t power;
+
 #if ROW_MAPPING == ROW_MAP_STANDARD
 #if CHAIN_COLS == 1 && CHAIN_ROWS == 1
     // HUB75_MULTIPLEX_2_ROWS — single panel, with display rotation support (BGR byte layout).
@@ -1389,17 +3778,20 @@ __attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
 
     constexpr int rows_per_bank = H / PanelConfig::ROWS_IN_PARALLEL;
 
-    int32_t fb_index = 0;
+    const int row_begin = part_begin(rows_per_bank, part);
+    const int row_end = part_begin(rows_per_bank, part + 1);
+
+    int32_t fb_index = row_begin * W * PanelConfig::ROWS_IN_PARALLEL;
 
     int dx = 0;
-    int row_in_bank = 0;
+    int row_in_bank = row_begin;
 
-    for (int32_t i = 0; i < PanelConfig::stride_to_paired_row; ++i)
+    for (int32_t i = row_begin * W; i < row_end * W; ++i)
     {
         for (int p = 0; p < PanelConfig::ROWS_IN_PARALLEL; ++p)
         {
             const int dy = p * rows_per_bank + row_in_bank;
-            rgb_buffer[fb_index++] = rot_lut_rgb(src, dx, dy, 0, W, H);
+            rgb_buffer[fb_index++] = rot_lut_rgb(power, src, dx, dy, 0, W, H);
         }
 
         if (++dx == W)
@@ -1439,9 +3831,12 @@ __attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
     // DISPLAY_HEIGHT / ROWS_IN_PARALLEL. The two only coincide when CHAIN_ROWS == 1.
     constexpr int rows_per_bank = PanelConfig::SCAN_DEPTH;
 
-    size_t fb_index = 0;
+    const int row_begin = part_begin(PanelConfig::SCAN_DEPTH, part);
+    const int row_end = part_begin(PanelConfig::SCAN_DEPTH, part + 1);
 
-    for (int row = 0; row < PanelConfig::SCAN_DEPTH; row++)
+    size_t fb_index = row_begin * (TOTAL_PIXELS / PanelConfig::SCAN_DEPTH);
+
+    for (int row = row_begin; row < row_end; row++)
     {
         for (int v = 0; v < CHAIN_ROWS; v++)
         {
@@ -1478,7 +3873,7 @@ __attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
                         for (int p = 0; p < PanelConfig::ROWS_IN_PARALLEL; ++p)
                         {
                             const int dy = dy_base - p * rows_per_bank;
-                            rgb_buffer[fb_index++] = rot_lut_rgb(src, dx_base, dy, i, W, H);
+                            rgb_buffer[fb_index++] = rot_lut_rgb(power, src, dx_base, dy, i, W, H);
                         }
                     }
                 }
@@ -1489,7 +3884,7 @@ __attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
                         for (int p = 0; p < PanelConfig::ROWS_IN_PARALLEL; ++p)
                         {
                             const int dy = dy_base + p * rows_per_bank;
-                            rgb_buffer[fb_index++] = rot_lut_rgb(src, dx_base, dy, i, W, H);
+                            rgb_buffer[fb_index++] = rot_lut_rgb(power, src, dx_base, dy, i, W, H);
                         }
                     }
                 }
@@ -1507,7 +3902,6 @@ __attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
     constexpr int W = DISPLAY_WIDTH;
     constexpr int H = DISPLAY_HEIGHT;
 
-    int line = 0;
     int counter = 0;
 
     constexpr int COLUMN_PAIRS = MATRIX_PANEL_WIDTH >> 1;
@@ -1523,13 +3917,17 @@ __attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
 
     constexpr int total_pairs = (MATRIX_PANEL_WIDTH * MATRIX_PANEL_HEIGHT) >> 1;
 
-    for (int j = 0, fb_index = 0; j < total_pairs; ++j, fb_index += 2)
+    constexpr int lines = total_pairs / COLUMN_PAIRS;
+    int line = part_begin(lines, part);
+    const int j_end = part_begin(lines, part + 1) * COLUMN_PAIRS;
+
+    for (int j = line * COLUMN_PAIRS, fb_index = 2 * j; j < j_end; ++j, fb_index += 2)
     {
         const int32_t pf = !(j & PAIR_HALF_BIT) ? j - (line << PAIR_HALF_SHIFT) : GROUP_ROW_OFFSET + j - ((line + 1) << PAIR_HALF_SHIFT);
         const int32_t pf2 = pf + HALF_PANEL_OFFSET_PX;
 
-        rgb_buffer[fb_index] = rot_lut_rgb(src, pf % W, pf / W, 0, W, H);
-        rgb_buffer[fb_index + 1] = rot_lut_rgb(src, pf2 % W, pf2 / W, 0, W, H);
+        rgb_buffer[fb_index] = rot_lut_rgb(power, src, pf % W, pf / W, 0, W, H);
+        rgb_buffer[fb_index + 1] = rot_lut_rgb(power, src, pf2 % W, pf2 / W, 0, W, H);
 
         if (++counter >= COLUMN_PAIRS)
         {
@@ -1544,9 +3942,12 @@ __attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
     constexpr int W = DISPLAY_WIDTH;
     constexpr int H = DISPLAY_HEIGHT;
 
-    size_t fb_index = 0;
+    const int row_begin = part_begin(PanelConfig::SCAN_DEPTH, part);
+    const int row_end = part_begin(PanelConfig::SCAN_DEPTH, part + 1);
 
-    for (int row = 0; row < PanelConfig::SCAN_DEPTH; ++row)
+    size_t fb_index = row_begin * (TOTAL_PIXELS / PanelConfig::SCAN_DEPTH);
+
+    for (int row = row_begin; row < row_end; ++row)
     {
         for (int v = 0; v < CHAIN_ROWS; ++v)
         {
@@ -1557,11 +3958,13 @@ __attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
                 const int32_t row_base = map_panel_row(row, v, h, reverse);
 
                 // Pixel-domain row pointers (no byte multiply yet — rot_lut_rgb performs the *3 conversion internally after rotation).
+                // Scan groups step downwards from the mirrored row on reversed panels (same as S31).
+                const int32_t sign = reverse ? -1 : 1;
                 const int32_t row_ptr[4] = {
-                    row_base + scan_map[0] * PanelConfig::stride_to_paired_row,
-                    row_base + scan_map[1] * PanelConfig::stride_to_paired_row,
-                    row_base + scan_map[2] * PanelConfig::stride_to_paired_row,
-                    row_base + scan_map[3] * PanelConfig::stride_to_paired_row,
+                    row_base + sign * scan_map[0] * PanelConfig::stride_to_paired_row,
+                    row_base + sign * scan_map[1] * PanelConfig::stride_to_paired_row,
+                    row_base + sign * scan_map[2] * PanelConfig::stride_to_paired_row,
+                    row_base + sign * scan_map[3] * PanelConfig::stride_to_paired_row,
                 };
 
                 // row_ptr[p] is only guaranteed W-aligned when CHAIN_COLS == 1.
@@ -1576,13 +3979,13 @@ __attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
                     // reverse:
                     //   - scan row       (map_panel_row)
                     //   - traversal      (reverse i)
-                    //   - scan group     (reverse p)
+                    //   - scan group     (negative sign on row_ptr)
                     // DISPLAY_ROTATION composited independently via rot_lut_rgb().
                     for (int i = MATRIX_PANEL_WIDTH - 1; i >= 0; --i)
                     {
-                        for (int p = 3; p >= 0; --p)
+                        for (int p = 0; p < 4; ++p)
                         {
-                            rgb_buffer[fb_index++] = rot_lut_rgb(src, dx_base[p], dy[p], i, W, H);
+                            rgb_buffer[fb_index++] = rot_lut_rgb(power, src, dx_base[p], dy[p], i, W, H);
                         }
                     }
                 }
@@ -1592,7 +3995,7 @@ __attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
                     {
                         for (int p = 0; p < 4; ++p)
                         {
-                            rgb_buffer[fb_index++] = rot_lut_rgb(src, dx_base[p], dy[p], i, W, H);
+                            rgb_buffer[fb_index++] = rot_lut_rgb(power, src, dx_base[p], dy[p], i, W, H);
                         }
                     }
                 }
@@ -1631,9 +4034,12 @@ __attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
     constexpr int W = DISPLAY_WIDTH;
     constexpr int H = DISPLAY_HEIGHT;
 
-    size_t fb_index = 0;
+    const int row_begin = part_begin(PanelConfig::SCAN_DEPTH, part);
+    const int row_end = part_begin(PanelConfig::SCAN_DEPTH, part + 1);
+
+    size_t fb_index = row_begin * (TOTAL_PIXELS / PanelConfig::SCAN_DEPTH);
 
-    for (int row = 0; row < PanelConfig::SCAN_DEPTH; row++)
+    for (int row = row_begin; row < row_end; row++)
     {
         for (int v = 0; v < CHAIN_ROWS; v++)
         {
@@ -1667,13 +4073,13 @@ __attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
                     // DISPLAY_ROTATION composited independently via rot_lut_rgb().
                     for (int i = MATRIX_PANEL_WIDTH - 1; i >= 0; --i)
                     {
-                        rgb_buffer[fb_index++] = rot_lut_rgb(src, dx_base1, dy1, i, W, H);
-                        rgb_buffer[fb_index++] = rot_lut_rgb(src, dx_base3, dy3, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut_rgb(power, src, dx_base1, dy1, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut_rgb(power, src, dx_base3, dy3, i, W, H);
                     }
                     for (int i = MATRIX_PANEL_WIDTH - 1; i >= 0; --i)
                     {
-                        rgb_buffer[fb_index++] = rot_lut_rgb(src, dx_base0, dy0, i, W, H);
-                        rgb_buffer[fb_index++] = rot_lut_rgb(src, dx_base2, dy2, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut_rgb(power, src, dx_base0, dy0, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut_rgb(power, src, dx_base2, dy2, i, W, H);
                     }
                 }
                 else
@@ -1681,22 +4087,399 @@ __attribute__((optimize("unroll-loops"))) void update_bgr(const uint8_t *src)
                     // Normal orientation
                     for (int i = 0; i < MATRIX_PANEL_WIDTH; ++i)
                     {
-                        rgb_buffer[fb_index++] = rot_lut_rgb(src, dx_base1, dy1, i, W, H);
-                        rgb_buffer[fb_index++] = rot_lut_rgb(src, dx_base3, dy3, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut_rgb(power, src, dx_base1, dy1, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut_rgb(power, src, dx_base3, dy3, i, W, H);
                     }
 
                     for (int i = 0; i < MATRIX_PANEL_WIDTH; ++i)
                     {
-                        rgb_buffer[fb_index++] = rot_lut_rgb(src, dx_base0, dy0, i, W, H);
-                        rgb_buffer[fb_index++] = rot_lut_rgb(src, dx_base2, dy2, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut_rgb(power, src, dx_base0, dy0, i, W, H);
+                        rgb_buffer[fb_index++] = rot_lut_rgb(power, src, dx_base2, dy2, i, W, H);
                     }
                 }
             }
         }
     }
 #endif
+    power_part_done(part, power);
+}
+
+/**
+ * @brief Updates the frame buffer with pixel data from the source array.
+ *
+ * This function takes a source array of pixel data and updates the frame buffer
+ * with interleaved pixel values. The pixel values are CIE-corrected to 10 bits using a lookup table.
+ * Half of the scan rows are mapped by the other core if it calls hub75_map_poll().
+ *
+ * @param src Graphics object to be updated - RGB888 format, 24-bits in uint32_t array
+ */
+void update_bgr(const uint8_t *src)
+{
+    hub75_trace(HUB75_TRACE_UPDATE_BEGIN, 1);
+
+    map_parallel(map_bgr, src);
+
+    hub75_trace(HUB75_TRACE_UPDATE_END, 0);
+
+    // Kick off building bitplanes from rgb_buffer to be written to frame_buffer
+    start_bitplane_build();
+}
+
+// ---------------------------------------------------------------------------
+// Linear 16-bit input
+//
+// The RGB888 paths are limited by their 8-bit input: neighbouring entries of the
+// CIE tables lie up to several output steps apart, and that is what bands, not
+// the BITPLANES depth. update_linear16() takes linear light with 16 bits per
+// channel and quantises it straight to the output depth:
+//
+//   c = v * top >> 12          Q4 output value, top = LUT_*[255] (white point)
+//   out = (c + t(x, y)) >> 4   t: 4x4 Bayer threshold 0..15, or 8 without dither
+//
+// The CIE tables are skipped - the input is already linear - but their white
+// point applies, and so does the CCM. Pixels are written in screen order into
+// their scan slot like the decoders below, so every ROW_MAPPING and rotation is
+// covered and the dither pattern stays fixed to the screen.
+// ---------------------------------------------------------------------------
+
+constexpr int LINEAR16_FRAC = 4; ///< fractional bits between scaling and dithering
+
+#if LINEAR16_DITHER == true
+// Bayer 4x4 thresholds in 1/16 output steps
+static const uint8_t HUB75_RAM_DATA LINEAR16_BAYER[4][4] = {
+    {0, 8, 2, 10},
+    {12, 4, 14, 6},
+    {3, 11, 1, 9},
+    {15, 7, 13, 5},
+};
+#endif
+
+#if CCM_MATRIX == true
+// Row o of the matrix applied to Q4 channel values, clamped to 0 .. CCM_MAX_VAL in Q4
+static inline int32_t linear16_ccm_row(const int16_t row[3], int32_t cr, int32_t cg, int32_t cb)
+{
+    // |m| <= 2^15 and c < 2^14: the sum stays below 3 * 2^29
+    const int32_t v = (row[0] * cr + row[1] * cg + row[2] * cb + (1 << (CCM_COEF_BITS - 1))) >> CCM_COEF_BITS;
+    return v < 0 ? 0 : (v > (int32_t)(CCM_MAX_VAL << LINEAR16_FRAC) ? (int32_t)(CCM_MAX_VAL << LINEAR16_FRAC) : v);
+}
+#endif
+
+// Screen rows of part `part` (0 .. MAP_PARTS-1) of a linear RGB48 source, see map_parallel()
+static void HUB75_RAM_FUNC(map_linear16)(const void *source, uint part)
+{
+    constexpr int W = HUB75_SCREEN_WIDTH;
+    constexpr uint32_t shift = 16 - LINEAR16_FRAC;
+
+    const int y_begin = part_begin(HUB75_SCREEN_HEIGHT, part);
+    const int y_end = part_begin(HUB75_SCREEN_HEIGHT, part + 1);
+    const uint16_t *src = static_cast<const uint16_t *>(source) + 3 * W * y_begin;
+    map_power_t power;
+
+    const uint32_t top_r = LUT_RED[255];
+    const uint32_t top_g = LUT_GREEN[255];
+    const uint32_t top_b = LUT_BLUE[255];
+#if CCM_MATRIX == true
+    hub75_ccm_t ccm;
+    hub75_get_ccm(&ccm);
+#endif
+
+    for (int sy = y_begin; sy < y_end; ++sy)
+    {
+#if LINEAR16_DITHER == true
+        const uint8_t *bayer = LINEAR16_BAYER[sy & 3];
+#endif
+        for (int sx = 0; sx < W; ++sx, src += 3)
+        {
+            int32_t cr = (int32_t)((src[0] * top_r + (1u << (shift - 1))) >> shift);
+            int32_t cg = (int32_t)((src[1] * top_g + (1u << (shift - 1))) >> shift);
+            int32_t cb = (int32_t)((src[2] * top_b + (1u << (shift - 1))) >> shift);
+#if CCM_MATRIX == true
+            const int32_t mr = linear16_ccm_row(ccm.m[0], cr, cg, cb);
+            const int32_t mg = linear16_ccm_row(ccm.m[1], cr, cg, cb);
+            cb = linear16_ccm_row(ccm.m[2], cr, cg, cb);
+            cr = mr;
+            cg = mg;
+#endif
+
+#if LINEAR16_DITHER == true
+            const int32_t t = bayer[sx & 3];
+#else
+            const int32_t t = 1 << (LINEAR16_FRAC - 1);
+#endif
+            uint32_t rv = (uint32_t)(cr + t) >> LINEAR16_FRAC;
+            uint32_t gv = (uint32_t)(cg + t) >> LINEAR16_FRAC;
+            uint32_t bv = (uint32_t)(cb + t) >> LINEAR16_FRAC;
+#if CCM_MATRIX != true
+            CCM_APPLY(rv, gv, bv);
+#endif
+            rgb_buffer[scan_slot_index(sx, sy)] = power.add((bv << 20u) | (gv << 10u) | rv);
+        }
+    }
+    power_part_done(part, power);
+}
+
+/**
+ * @brief Updates the frame buffer from linear-light pixels with 16 bits per channel.
+ *
+ * Quantises straight to the BITPLANES depth, with ordered dithering if LINEAR16_DITHER
+ * is true, instead of going through the 8-bit CIE tables - for procedural effects or
+ * HDR sources whose dark gradients would band at 8 bits. The white point of the CIE
+ * tables and the CCM are applied. Half of the screen rows are mapped by the other core
+ * if it calls hub75_map_poll().
+ *
+ * @param src HUB75_SCREEN_WIDTH x HUB75_SCREEN_HEIGHT pixels of R, G, B (0 .. 65535 linear light)
+ */
+void update_linear16(const uint16_t *src)
+{
+    hub75_trace(HUB75_TRACE_UPDATE_BEGIN, 5);
+
+    map_parallel(map_linear16, src);
+
+    hub75_trace(HUB75_TRACE_UPDATE_END, 0);
+
     // Kick off building bitplanes from rgb_buffer to be written to frame_buffer
-    dma_channel_set_write_addr(write_chan, frame_buffer, false);
-    dma_channel_set_read_addr(read_chan, rgb_buffer, false);
-    dma_start_channel_mask((1u << read_chan) | (1u << write_chan));
+    start_bitplane_build();
+}
+
+// ---------------------------------------------------------------------------
+// Compressed still images
+//
+// Both decoders produce pixels in screen order and write them straight into
+// their rgb_buffer slot via scan_slot_index() - there is no intermediate RGB
+// framebuffer. A pixel is only pushed through the LUT/CCM when its colour
+// changes, so runs cost one store per pixel.
+// ---------------------------------------------------------------------------
+
+// Screen-order cursor over rgb_buffer
+struct scan_writer
+{
+    int x = 0;
+    int y = 0;
+    uint32_t remaining = TOTAL_PIXELS;
+    map_power_t power;
+
+    inline void put(uint32_t value, uint32_t count)
+    {
+        if (count > remaining)
+            count = remaining;
+        remaining -= count;
+        power.add(value, count);
+        while (count--)
+        {
+            rgb_buffer[scan_slot_index(x, y)] = value;
+            if (++x == (int)HUB75_SCREEN_WIDTH)
+            {
+                x = 0;
+                ++y;
+            }
+        }
+    }
+};
+
+constexpr uint8_t QOI_OP_INDEX = 0x00;
+constexpr uint8_t QOI_OP_DIFF = 0x40;
+constexpr uint8_t QOI_OP_LUMA = 0x80;
+constexpr uint8_t QOI_OP_RUN = 0xc0;
+constexpr uint8_t QOI_OP_RGB = 0xfe;
+constexpr uint8_t QOI_OP_RGBA = 0xff;
+constexpr uint8_t QOI_MASK_2 = 0xc0;
+constexpr size_t QOI_HEADER_SIZE = 14;
+constexpr uint8_t QOI_END_MARKER[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+
+// Walk the QOI ops without decoding them: true if the header matches the screen and the
+// data covers every pixel without an op cut off, followed by the end marker
+static bool qoi_covers_screen(const uint8_t *qoi, size_t size)
+{
+    if (size < QOI_HEADER_SIZE || qoi[0] != 'q' || qoi[1] != 'o' || qoi[2] != 'i' || qoi[3] != 'f')
+        return false;
+
+    const uint32_t width = (qoi[4] << 24) | (qoi[5] << 16) | (qoi[6] << 8) | qoi[7];
+    const uint32_t height = (qoi[8] << 24) | (qoi[9] << 16) | (qoi[10] << 8) | qoi[11];
+    if (width != HUB75_SCREEN_WIDTH || height != HUB75_SCREEN_HEIGHT)
+        return false;
+
+    uint32_t pixels = 0;
+    size_t p = QOI_HEADER_SIZE;
+    while (pixels < TOTAL_PIXELS && p < size)
+    {
+        const uint8_t b1 = qoi[p++];
+        if (b1 == QOI_OP_RGB)
+            p += 3;
+        else if (b1 == QOI_OP_RGBA)
+            p += 4;
+        else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA)
+            p += 1;
+        else if ((b1 & QOI_MASK_2) == QOI_OP_RUN)
+            pixels += b1 & 0x3f; // run of (b1 & 0x3f) + 1
+        if (p > size)
+            return false;
+        ++pixels;
+    }
+    if (pixels < TOTAL_PIXELS || size - p < sizeof(QOI_END_MARKER))
+        return false;
+    for (size_t i = 0; i < sizeof(QOI_END_MARKER); ++i)
+        if (qoi[p + i] != QOI_END_MARKER[i])
+            return false;
+    return true;
+}
+
+// Walk the RLE packets without decoding them: true if they cover every pixel without a
+// packet cut off by the end of the data
+static bool rle_covers_screen(const uint8_t *rle, size_t size)
+{
+    uint32_t pixels = 0;
+    size_t p = 0;
+    while (pixels < TOTAL_PIXELS && p < size)
+    {
+        const uint8_t ctrl = rle[p++];
+        const uint32_t n = (ctrl & 0x7f) + 1;
+        p += (ctrl & 0x80) ? 3 : 3 * n;
+        if (p > size)
+            return false;
+        pixels += n;
+    }
+    return pixels >= TOTAL_PIXELS;
+}
+
+/**
+ * @brief Decode a QOI image (https://qoiformat.org) into rgb_buffer and display it.
+ *
+ * The image must have the screen size (HUB75_SCREEN_WIDTH x HUB75_SCREEN_HEIGHT).
+ * 3 and 4 channel images are accepted, alpha is ignored. The file is checked completely
+ * before the first pixel is written.
+ *
+ * @param qoi  QOI file contents, e.g. a const array in flash
+ * @param size size of the QOI file in bytes
+ * @return false if the header does not match the screen or the data is truncated (including
+ *         a missing end marker); rgb_buffer and the displayed frame are then left unchanged
+ */
+bool update_qoi(const uint8_t *qoi, size_t size)
+{
+    if (!qoi_covers_screen(qoi, size))
+        return false;
+
+    hub75_trace(HUB75_TRACE_UPDATE_BEGIN, 2);
+    colour_sync();
+
+    uint8_t index[64][4] = {};
+    uint8_t r = 0, g = 0, b = 0, a = 255;
+    uint32_t value = LUT_MAPPING_RGB(r, g, b);
+
+    scan_writer out;
+    size_t p = QOI_HEADER_SIZE;
+
+    while (out.remaining && p < size)
+    {
+        const uint8_t b1 = qoi[p++];
+
+        if (b1 == QOI_OP_RGB)
+        {
+            r = qoi[p++];
+            g = qoi[p++];
+            b = qoi[p++];
+        }
+        else if (b1 == QOI_OP_RGBA)
+        {
+            r = qoi[p++];
+            g = qoi[p++];
+            b = qoi[p++];
+            a = qoi[p++];
+        }
+        else if ((b1 & QOI_MASK_2) == QOI_OP_INDEX)
+        {
+            r = index[b1][0];
+            g = index[b1][1];
+            b = index[b1][2];
+            a = index[b1][3];
+        }
+        else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF)
+        {
+            r += ((b1 >> 4) & 0x03) - 2;
+            g += ((b1 >> 2) & 0x03) - 2;
+            b += (b1 & 0x03) - 2;
+        }
+        else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA)
+        {
+            const uint8_t b2 = qoi[p++];
+            const int vg = (b1 & 0x3f) - 32;
+            r += vg - 8 + ((b2 >> 4) & 0x0f);
+            g += vg;
+            b += vg - 8 + (b2 & 0x0f);
+        }
+        else // QOI_OP_RUN
+        {
+            out.put(value, (b1 & 0x3f) + 1);
+            continue;
+        }
+
+        uint8_t *slot = index[(r * 3 + g * 5 + b * 7 + a * 11) & 63];
+        slot[0] = r;
+        slot[1] = g;
+        slot[2] = b;
+        slot[3] = a;
+
+        value = LUT_MAPPING_RGB(r, g, b);
+        out.put(value, 1);
+    }
+
+    power_mapped(out.power);
+
+    hub75_trace(HUB75_TRACE_UPDATE_END, 0);
+
+    // Kick off building bitplanes from rgb_buffer to be written to frame_buffer
+    start_bitplane_build();
+    return true;
+}
+
+/**
+ * @brief Decode a run-length encoded BGR image into rgb_buffer and display it.
+ *
+ * Stream of packets covering the screen in row-major order (HUB75_SCREEN_WIDTH x HUB75_SCREEN_HEIGHT),
+ * pixels stored as B, G, R bytes like the update_bgr() input:
+ *   0x80 | (n - 1), B, G, R        → run of n identical pixels (n = 1..128)
+ *   0x00 | (n - 1), n × (B, G, R)  → n literal pixels (n = 1..128)
+ *
+ * utils/compress.py creates both RLE and QOI assets.
+ *
+ * The packets are checked completely before the first pixel is written.
+ *
+ * @param rle  encoded image, e.g. a const array in flash
+ * @param size size of the encoded image in bytes
+ * @return false if the data is truncated; rgb_buffer and the displayed frame are then left unchanged
+ */
+bool update_rle(const uint8_t *rle, size_t size)
+{
+    if (!rle_covers_screen(rle, size))
+        return false;
+
+    hub75_trace(HUB75_TRACE_UPDATE_BEGIN, 3);
+    colour_sync();
+
+    scan_writer out;
+    size_t p = 0;
+
+    while (out.remaining && p < size)
+    {
+        const uint8_t ctrl = rle[p++];
+        const uint32_t n = (ctrl & 0x7f) + 1;
+
+        if (ctrl & 0x80)
+        {
+            out.put(LUT_MAPPING_RGB(rle[p + 2], rle[p + 1], rle[p]), n);
+            p += 3;
+        }
+        else
+        {
+            for (uint32_t k = 0; k < n; ++k, p += 3)
+                out.put(LUT_MAPPING_RGB(rle[p + 2], rle[p + 1], rle[p]), 1);
+        }
+    }
+
+    power_mapped(out.power);
+
+    hub75_trace(HUB75_TRACE_UPDATE_END, 0);
+
+    // Kick off building bitplanes from rgb_buffer to be written to frame_buffer
+    start_bitplane_build();
+    return true;
 }
@@ -0,0 +1,131 @@
+#include "pico/stdlib.h"
+
+#include "hub75.hpp"
+
+// Animation currently playing, nullptr when idle.
+// Written by hub75_anim_play()/hub75_anim_stop() (any core), read by hub75_anim_poll().
+static const hub75_animation_t *volatile current_anim = nullptr;
+static bool anim_loop = false;
+static uint32_t next_frame = 0; ///< index of the next frame to apply
+static uint64_t start_us = 0;   ///< time of timestamp 0 of the current loop iteration
+
+/**
+ * @brief Map one keyframe or delta frame into rgb_buffer.
+ *
+ * Keyframes replace the whole screen. Delta frames only touch the tiles listed,
+ * everything else keeps the content of the previous frame.
+ */
+static void apply_frame(const hub75_animation_t *a, const hub75_anim_frame_t *f)
+{
+    if (f->type == HUB75_ANIM_KEYFRAME)
+    {
+        hub75_write_rect_bgr(0, 0, a->width, a->height, f->data, a->width * 3);
+        return;
+    }
+
+    const uint32_t tiles_per_row = a->width / a->tile_width;
+    const uint32_t tile_bytes = a->tile_width * a->tile_height * 3;
+    const uint8_t *p = f->data;
+
+    for (uint32_t t = 0; t < f->tile_count; ++t)
+    {
+        const uint32_t index = p[0] | (p[1] << 8);
+        p += 2;
+
+        const int tx = (index % tiles_per_row) * a->tile_width;
+        const int ty = (index / tiles_per_row) * a->tile_height;
+        hub75_write_rect_bgr(tx, ty, a->tile_width, a->tile_height, p, a->tile_width * 3);
+        p += tile_bytes;
+    }
+}
+
+/**
+ * @brief Start playing an animation from its first frame.
+ *
+ * @param a    animation created by utils/animation.py
+ * @param loop restart at frame 0 after duration_ms
+ * @return false if the animation does not match the screen size or does not start with a keyframe
+ */
+bool hub75_anim_play(const hub75_animation_t *a, bool loop)
+{
+    if (a->width != HUB75_SCREEN_WIDTH || a->height != HUB75_SCREEN_HEIGHT ||
+        a->frame_count == 0 || a->frames[0].type != HUB75_ANIM_KEYFRAME ||
+        a->width % a->tile_width || a->height % a->tile_height ||
+        a->duration_ms <= a->frames[a->frame_count - 1].timestamp_ms)
+        return false;
+
+    current_anim = nullptr;
+    __dmb();
+
+    anim_loop = loop;
+    next_frame = 0;
+    start_us = time_us_64();
+
+    __dmb();
+    current_anim = a;
+    return true;
+}
+
+void hub75_anim_stop(void)
+{
+    current_anim = nullptr;
+}
+
+bool hub75_anim_playing(void)
+{
+    return current_anim != nullptr;
+}
+
+/**
+ * @brief Advance the animation; call this frequently from an idle loop (e.g. core1_entry()).
+ *
+ * Every frame whose timestamp has passed is mapped into rgb_buffer, then a single
+ * hub75_present() hands the result to the driver, which swaps it in at its next frame
+ * boundary. Nothing is done while the previous frame is still being built or waiting
+ * for its swap. If playback falls behind, deltas preceding a due keyframe are skipped.
+ *
+ * @return true if a new frame was presented
+ */
+bool hub75_anim_poll(void)
+{
+    const hub75_animation_t *a = current_anim;
+    if (!a || hub75_present_pending())
+        return false;
+
+    const uint64_t now = time_us_64();
+    if (now < start_us + a->frames[next_frame].timestamp_ms * 1000ull)
+        return false;
+
+    for (;;)
+    {
+        // Skip straight to the newest due keyframe, the deltas before it are overwritten anyway
+        uint32_t last_due = next_frame;
+        while (last_due + 1 < a->frame_count && now >= start_us + a->frames[last_due + 1].timestamp_ms * 1000ull)
+        {
+            ++last_due;
+            if (a->frames[last_due].type == HUB75_ANIM_KEYFRAME)
+                next_frame = last_due;
+        }
+
+        for (; next_frame <= last_due; ++next_frame)
+            apply_frame(a, &a->frames[next_frame]);
+
+        if (next_frame < a->frame_count)
+            break;
+
+        if (!anim_loop)
+        {
+            current_anim = nullptr;
+            break;
+        }
+
+        // Wrap around; frames of the next iteration may already be due as well
+        next_frame = 0;
+        start_us += a->duration_ms * 1000ull;
+        if (now < start_us)
+            break;
+    }
+
+    hub75_present();
+    return true;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+// 3x3 colour correction matrix as partial-product tables (CCM_MATRIX)
+//
+// The matrix acts on the CIE corrected channel values c_r, c_g, c_b (0..max):
+//
+//   out[o] = clamp(m[o][0] * c_r + m[o][1] * c_g + m[o][2] * c_b, 0, max)
+//
+// c_s only depends on the source byte of channel s, so every product m[o][s] * c_s is
+// precomputed for all 256 source bytes, in 1/16 output steps:
+//
+//   table[s][v][o] = round(m[o][s] * cie_s[v] * 16)
+//
+// A pixel then costs three entry addresses, nine int16_t loads, six adds, one rounding shift
+// and a clamp per channel; the CIE lookup is part of the tables. Entries are padded to 8 bytes,
+// so the entry address is base + (byte << 3) - one shift in C, or the interpolators
+// (see hub75_interp.hpp).
+//
+// Coefficients are Q2.14 (HUB75_CCM_ONE = 1.0, range -2.0 .. +2.0), so |table| < 2 * 1023 * 16
+// fits into int16_t. utils/hub75_ccm_check.cpp compares the result with a float reference.
+
+constexpr int CCM_COEF_BITS = 14;       ///< fractional bits of the coefficients
+constexpr int CCM_TABLE_FRAC = 4;       ///< fractional bits of the table entries
+constexpr uint32_t CCM_ENTRY_SHIFT = 3; ///< log2 of the entry size in bytes
+
+typedef int16_t ccm_table_t[3][256][4];
+
+/**
+ * @brief Fold the matrix m (rows: output red, green, blue; columns: source channel) and the CIE tables into table.
+ */
+static inline void ccm_build_tables(ccm_table_t &table, const int16_t m[3][3], const uint16_t *red, const uint16_t *green,
+                                    const uint16_t *blue)
+{
+    constexpr int shift = CCM_COEF_BITS - CCM_TABLE_FRAC;
+    const uint16_t *const cie[3] = {red, green, blue};
+
+    for (int s = 0; s < 3; ++s)
+    {
+        for (int v = 0; v < 256; ++v)
+        {
+            for (int o = 0; o < 3; ++o)
+                table[s][v][o] = (int16_t)(((int32_t)m[o][s] * cie[s][v] + (1 << (shift - 1))) >> shift);
+            table[s][v][3] = 0;
+        }
+    }
+}
+
+// Round the sum of three entries to an output value and clamp it to 0..max
+static inline uint32_t ccm_channel(int32_t sum, int32_t max)
+{
+    const int32_t v = (sum + (1 << (CCM_TABLE_FRAC - 1))) >> CCM_TABLE_FRAC;
+    return (uint32_t)(v < 0 ? 0 : (v > max ? max : v));
+}
+
+/**
+ * @brief Corrected colour packed into 30 bits (b << 20 | g << 10 | r) from the entries of the red, green and blue byte.
+ */
+static inline uint32_t ccm_pack(const int16_t *er, const int16_t *eg, const int16_t *eb, int32_t max)
+{
+    const uint32_t rv = ccm_channel(er[0] + eg[0] + eb[0], max);
+    const uint32_t gv = ccm_channel(er[1] + eg[1] + eb[1], max);
+    const uint32_t bv = ccm_channel(er[2] + eg[2] + eb[2], max);
+    return (bv << 20u) | (gv << 10u) | rv;
+}
@@ -0,0 +1,191 @@
+#include <cstring>
+
+#include "pico/stdlib.h"
+
+#if CYW43_LWIP
+#include "pico/cyw43_arch.h"
+#include "lwip/igmp.h"
+#include "lwip/pbuf.h"
+#include "lwip/udp.h"
+#endif
+
+#include "hub75.hpp"
+
+// Art-Net / E1.31 receive path (see include/hub75_dmx_decoder.h)
+//
+//   UDP (lwIP) → decoder → slot table → hub75_write_slots_rgb() → rgb_buffer
+//
+// Each universe's channels land in their scan-ordered rgb_buffer slots straight from the
+// received packet; there is no RGB framebuffer in between. From a completed frame until its
+// bitplanes are swapped in, rgb_buffer belongs to the build: packets arriving then wait in a
+// queue of DMX_QUEUE_PACKETS, which hub75_dmx_poll() feeds in arrival order afterwards.
+//
+// The UDP receive needs an lwIP variant of the CYW43 architecture library (CYW43_LWIP=1),
+// e.g. pico_cyw43_arch_lwip_threadsafe_background; with pico_cyw43_arch_none or without
+// a radio, packets received by other means can still be passed to hub75_dmx_feed().
+
+static_assert(DMX_NO_SLOT == HUB75_NO_SLOT, "the slot table goes to hub75_write_slots_rgb() unchanged");
+static_assert(HUB75::TOTAL_PIXELS < HUB75_NO_SLOT, "rgb_buffer slots must fit the uint16_t slot table");
+
+static uint16_t slots[HUB75_SCREEN_WIDTH * HUB75_SCREEN_HEIGHT + DMX_MAX_PIXELS - 1];
+static hub75_dmx_decoder_t decoder;
+static bool decoder_ready = false;
+static volatile bool present_requested = false;
+
+static uint8_t queue[DMX_QUEUE_PACKETS][DMX_PACKET_MAX];
+static uint16_t queue_len[DMX_QUEUE_PACKETS];
+static uint32_t queue_ms[DMX_QUEUE_PACKETS]; ///< arrival time, for the sync timeout
+static uint32_t queue_in = 0;                ///< packets queued
+static uint32_t queue_out = 0;               ///< packets fed from the queue
+
+static void sink_write(const uint16_t *s, int n, const uint8_t *rgb)
+{
+    hub75_write_slots_rgb(s, n, rgb);
+}
+
+static void sink_present(void)
+{
+    // Runs in the lwIP callback context (or while hub75_dmx_poll() feeds the queue); the poll
+    // presents once the previous bitplane build is done
+    present_requested = true;
+}
+
+// rgb_buffer is free for the decoder: no frame waiting to be presented or being built
+static bool writable(void)
+{
+    return !present_requested && !hub75_present_pending();
+}
+
+// Decode now, or queue behind a pending present (and behind packets already queued)
+static void receive(const uint8_t *packet, size_t len, uint32_t now_ms)
+{
+    if (queue_in == queue_out && writable())
+    {
+        hub75_dmx_decoder_feed(&decoder, packet, len, now_ms);
+        return;
+    }
+    if (queue_in - queue_out == DMX_QUEUE_PACKETS)
+    {
+        decoder.stats.dropped++;
+        return;
+    }
+    const uint32_t i = queue_in % DMX_QUEUE_PACKETS;
+    if (len > DMX_PACKET_MAX)
+        len = DMX_PACKET_MAX;
+    memcpy(queue[i], packet, len);
+    queue_len[i] = (uint16_t)len;
+    queue_ms[i] = now_ms;
+    queue_in++;
+}
+
+#if CYW43_LWIP
+static void udp_receive(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t port)
+{
+    static uint8_t packet[DMX_PACKET_MAX];
+    const u16_t len = pbuf_copy_partial(p, packet, sizeof(packet), 0);
+    pbuf_free(p);
+    receive(packet, len, to_ms_since_boot(get_absolute_time()));
+}
+
+static bool bind_port(u16_t port)
+{
+    struct udp_pcb *pcb = udp_new_ip_type(IPADDR_TYPE_ANY);
+    if (!pcb)
+        return false;
+    if (udp_bind(pcb, IP_ANY_TYPE, port) != ERR_OK)
+    {
+        udp_remove(pcb);
+        return false;
+    }
+    udp_recv(pcb, udp_receive, nullptr);
+    return true;
+}
+#endif
+
+/**
+ * @brief Start the Art-Net / E1.31 receiver.
+ *
+ * Call after the network is up (cyw43_arch_init() and a Wi-Fi connection). Binds the
+ * Art-Net and/or E1.31 UDP ports and joins the E1.31 multicast group of every universe
+ * on the screen (239.255.hi.lo).
+ *
+ * @param layout    universe layout of the screen, see hub75_dmx_layout_t
+ * @param protocols DMX_ARTNET and/or DMX_SACN
+ * @return false if the layout is invalid or a socket could not be set up. Without
+ *         CYW43_LWIP only the decoder is initialised, for hub75_dmx_feed().
+ */
+bool hub75_dmx_init(const hub75_dmx_layout_t *layout, uint32_t protocols)
+{
+    const hub75_dmx_sink_t sink = {sink_write, sink_present};
+    if (hub75_dmx_table_size(layout, HUB75_SCREEN_WIDTH, HUB75_SCREEN_HEIGHT) > count_of(slots) ||
+        !hub75_dmx_decoder_init(&decoder, layout, HUB75_SCREEN_WIDTH, HUB75_SCREEN_HEIGHT, slots, hub75_scan_slot, &sink))
+        return false;
+    decoder_ready = true;
+
+#if CYW43_LWIP
+    bool ok = true;
+    cyw43_arch_lwip_begin();
+    if (protocols & DMX_ARTNET)
+        ok &= bind_port(DMX_ARTNET_PORT);
+    if (protocols & DMX_SACN)
+    {
+        ok &= bind_port(DMX_SACN_PORT);
+        for (uint32_t u = 0; u < decoder.universes; ++u)
+        {
+            const uint32_t universe = layout->first_universe + u;
+            ip4_addr_t group;
+            IP4_ADDR(&group, 239, 255, universe >> 8, universe & 0xff);
+            ok &= igmp_joingroup(IP4_ADDR_ANY4, &group) == ERR_OK;
+        }
+    }
+    cyw43_arch_lwip_end();
+    return ok;
+#else
+    (void)protocols;
+    return true;
+#endif
+}
+
+/**
+ * @brief Decode one Art-Net or E1.31 UDP payload received outside lwIP (e.g. a wired
+ * Ethernet MAC). Do not mix with the lwIP receive path.
+ */
+void hub75_dmx_feed(const uint8_t *packet, size_t len)
+{
+    if (decoder_ready)
+        receive(packet, len, to_ms_since_boot(get_absolute_time()));
+}
+
+/**
+ * @brief Present completed frames and decode the packets queued meanwhile; call this frequently.
+ *
+ * A frame is presented as soon as the previous one has reached the panel.
+ */
+void hub75_dmx_poll(void)
+{
+#if PICO_CYW43_ARCH_POLL
+    cyw43_arch_poll();
+#endif
+#if CYW43_LWIP
+    cyw43_arch_lwip_begin(); // udp_receive() may run in the background and touches the same state
+#endif
+    if (present_requested && !hub75_present_pending())
+    {
+        present_requested = false;
+        hub75_present();
+    }
+    while (queue_out != queue_in && writable())
+    {
+        const uint32_t i = queue_out % DMX_QUEUE_PACKETS;
+        hub75_dmx_decoder_feed(&decoder, queue[i], queue_len[i], queue_ms[i]);
+        queue_out++;
+    }
+#if CYW43_LWIP
+    cyw43_arch_lwip_end();
+#endif
+}
+
+void hub75_dmx_get_stats(hub75_dmx_stats_t *stats)
+{
+    *stats = decoder.stats;
+}
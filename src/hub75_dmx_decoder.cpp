@@ -0,0 +1,253 @@
+#include <cstring>
+
+#include "hub75_dmx_decoder.h"
+
+#define ARTNET_OP_DMX 0x5000
+#define ARTNET_OP_SYNC 0x5200
+#define ARTNET_DATA 18 ///< offset of the channel data in ArtDmx
+
+#define E131_ROOT_DATA 0x00000004
+#define E131_ROOT_EXTENDED 0x00000008
+#define E131_FRAMING_DATA 0x00000002
+#define E131_EXTENDED_SYNC 0x00000001
+#define E131_DATA 126 ///< offset of the channel data after the start code
+#define E131_SYNC_LENGTH 49
+
+#define E131_OPT_PREVIEW 0x80
+#define E131_OPT_TERMINATED 0x40
+
+static const uint8_t artnet_id[8] = {'A', 'r', 't', '-', 'N', 'e', 't', 0};
+static const uint8_t e131_id[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+
+static inline uint32_t get_be16(const uint8_t *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+static inline uint32_t get_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static void present(hub75_dmx_decoder_t *dec)
+{
+    memset(dec->received, 0, sizeof(dec->received));
+    dec->received_count = 0;
+    dec->stats.frames++;
+    dec->sink.present();
+}
+
+// Synchronized output is on while sync packets keep coming
+static bool synchronous(hub75_dmx_decoder_t *dec, uint32_t now_ms)
+{
+    if (dec->synced && now_ms - dec->sync_ms > DMX_SYNC_TIMEOUT_MS)
+        dec->synced = false;
+    return dec->synced;
+}
+
+static void sync_packet(hub75_dmx_decoder_t *dec, uint32_t now_ms)
+{
+    dec->stats.syncs++;
+    dec->synced = true;
+    dec->sync_ms = now_ms;
+    if (dec->received_count)
+        present(dec);
+}
+
+// E1.31 section 6.7.2: a packet up to 20 sequence numbers behind the last one is stale
+static bool in_sequence(hub75_dmx_decoder_t *dec, uint32_t u, uint8_t seq)
+{
+    const uint8_t bit = 1u << (u & 7);
+    if (dec->seq_valid[u >> 3] & bit)
+    {
+        const int8_t diff = (int8_t)(seq - dec->seq[u]);
+        if (diff <= 0 && diff > -20)
+            return false;
+    }
+    dec->seq_valid[u >> 3] |= bit;
+    dec->seq[u] = seq;
+    return true;
+}
+
+// Returns false if the universe is not on the screen or out of sequence
+static bool write_universe(hub75_dmx_decoder_t *dec, uint32_t universe, uint8_t seq, bool check_seq, const uint8_t *data,
+                           size_t len, bool sync)
+{
+    const uint32_t u = universe - dec->layout.first_universe; // wraps below first_universe
+    if (u >= dec->universes)
+    {
+        dec->stats.ignored++;
+        return false;
+    }
+    if (check_seq && !in_sequence(dec, u, seq))
+    {
+        dec->stats.out_of_order++;
+        return false;
+    }
+
+    const uint8_t bit = 1u << (u & 7);
+    if (!sync && (dec->received[u >> 3] & bit))
+        present(dec); // the sender moved on to the next frame without sending every universe
+
+    size_t pixels = len / 3;
+    if (pixels > dec->layout.pixels_per_universe)
+        pixels = dec->layout.pixels_per_universe;
+    dec->sink.write(&dec->slots[u * dec->layout.pixels_per_universe], (int)pixels, data);
+    dec->stats.dmx++;
+
+    if (!(dec->received[u >> 3] & bit))
+    {
+        dec->received[u >> 3] |= bit;
+        dec->received_count++;
+    }
+    if (!sync && dec->received_count == dec->universes)
+        present(dec);
+    return true;
+}
+
+static void artnet_packet(hub75_dmx_decoder_t *dec, const uint8_t *p, size_t len, uint32_t now_ms)
+{
+    const uint32_t op = p[8] | (p[9] << 8);
+    if (op == ARTNET_OP_SYNC)
+        return sync_packet(dec, now_ms);
+    if (op != ARTNET_OP_DMX)
+    {
+        dec->stats.ignored++; // ArtPoll, ArtAddress, ... - this node is receive-only
+        return;
+    }
+
+    if (len < ARTNET_DATA)
+    {
+        dec->stats.errors++;
+        return;
+    }
+    const uint32_t length = get_be16(p + 16);
+    if (length < 2 || length > DMX_CHANNELS || ARTNET_DATA + length > len)
+    {
+        dec->stats.errors++;
+        return;
+    }
+
+    const uint32_t universe = ((p[15] & 0x7f) << 8) | p[14];
+    write_universe(dec, universe, p[12], p[12] != 0, p + ARTNET_DATA, length, synchronous(dec, now_ms));
+}
+
+static void e131_packet(hub75_dmx_decoder_t *dec, const uint8_t *p, size_t len, uint32_t now_ms)
+{
+    const uint32_t root = get_be32(p + 18);
+    const uint32_t framing = get_be32(p + 40);
+
+    if (root == E131_ROOT_EXTENDED)
+    {
+        if (framing != E131_EXTENDED_SYNC)
+        {
+            dec->stats.ignored++; // universe discovery
+            return;
+        }
+        if (len < E131_SYNC_LENGTH)
+        {
+            dec->stats.errors++;
+            return;
+        }
+        const uint32_t address = get_be16(p + 45);
+        if (address == 0 || address != dec->sacn_sync)
+        {
+            dec->stats.ignored++;
+            return;
+        }
+        return sync_packet(dec, now_ms);
+    }
+
+    if (root != E131_ROOT_DATA || framing != E131_FRAMING_DATA || len < E131_DATA)
+    {
+        dec->stats.errors++;
+        return;
+    }
+    const uint32_t count = get_be16(p + 123); // start code + channels
+    if (p[117] != 0x02 || p[118] != 0xa1 || count < 1 || count > DMX_CHANNELS + 1 || E131_DATA - 1 + count > len)
+    {
+        dec->stats.errors++;
+        return;
+    }
+    if (p[112] & (E131_OPT_PREVIEW | E131_OPT_TERMINATED) || p[125] != 0)
+    {
+        dec->stats.ignored++;
+        return;
+    }
+
+    // Only universes of this screen choose the sync address; other senders' packets must
+    // not make sync packets meant for this screen look foreign
+    const uint16_t address = get_be16(p + 109);
+    const bool sync = address != 0 && synchronous(dec, now_ms);
+    if (write_universe(dec, get_be16(p + 113), p[111], true, p + E131_DATA, count - 1, sync))
+        dec->sacn_sync = address;
+}
+
+/**
+ * @brief Slot table entries needed for layout: the universes covering the screen, each
+ * pixels_per_universe long. 0 if pixels_per_universe is 0.
+ */
+size_t hub75_dmx_table_size(const hub75_dmx_layout_t *layout, int width, int height)
+{
+    const size_t n = layout->pixels_per_universe;
+    if (n == 0)
+        return 0;
+    return ((size_t)width * height + n - 1) / n * n;
+}
+
+/**
+ * @brief Resolve layout into the slot table and reset the decoder.
+ *
+ * @param slots   hub75_dmx_table_size() entries, must stay valid while the decoder is used
+ * @param slot_of slot of screen pixel (x, y), or a negative value to drop the pixel
+ * @return false if the layout is invalid or needs more than DMX_MAX_UNIVERSES universes
+ */
+bool hub75_dmx_decoder_init(hub75_dmx_decoder_t *dec, const hub75_dmx_layout_t *layout, int width, int height,
+                            uint16_t *slots, int (*slot_of)(int x, int y), const hub75_dmx_sink_t *sink)
+{
+    const size_t table = hub75_dmx_table_size(layout, width, height);
+    if (width <= 0 || height <= 0 || table == 0 || layout->pixels_per_universe > DMX_MAX_PIXELS)
+        return false;
+    const size_t universes = table / layout->pixels_per_universe;
+    if (universes > DMX_MAX_UNIVERSES || layout->first_universe + universes - 1 > 0xFFFF)
+        return false;
+
+    const size_t pixels = (size_t)width * height;
+    for (size_t i = 0; i < table; ++i)
+    {
+        int slot = -1;
+        if (i < pixels)
+        {
+            const int y = (int)(i / width);
+            int x = (int)(i % width);
+            if (layout->serpentine && (y & 1))
+                x = width - 1 - x;
+            slot = slot_of(x, y);
+        }
+        slots[i] = slot < 0 ? DMX_NO_SLOT : (uint16_t)slot;
+    }
+
+    memset(dec, 0, sizeof(*dec));
+    dec->layout = *layout;
+    dec->sink = *sink;
+    dec->slots = slots;
+    dec->universes = (uint16_t)universes;
+    return true;
+}
+
+/**
+ * @brief Decode one UDP payload received on DMX_ARTNET_PORT or DMX_SACN_PORT.
+ *
+ * @param now_ms millisecond clock, only used for the sync timeout
+ */
+void hub75_dmx_decoder_feed(hub75_dmx_decoder_t *dec, const uint8_t *packet, size_t len, uint32_t now_ms)
+{
+    dec->stats.packets++;
+
+    if (len >= 12 && memcmp(packet, artnet_id, sizeof(artnet_id)) == 0)
+        artnet_packet(dec, packet, len, now_ms);
+    else if (len >= 46 && get_be16(packet) == 0x0010 && memcmp(packet + 4, e131_id, sizeof(e131_id)) == 0)
+        e131_packet(dec, packet, len, now_ms);
+    else
+        dec->stats.errors++;
+}
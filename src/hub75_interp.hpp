@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+
+// Table lookups of the RGB888 mapping kernel on the SIO interpolators
+//
+// For a packed 0x00RRGGBB colour the plain C path (pack_lut_rgb()) computes three table
+// addresses with a shift, a mask and an add each. The interpolator lanes do exactly that:
+// after one write of the colour per interpolator each PEEK register holds the address of
+// a table entry. With entries of 2^k bytes (k = 1 for the uint16_t CIE tables, 3 for the
+// partial-product tables of hub75_ccm.hpp) both interpolators get accum0 = colour << k:
+//
+//   interp0 lane 0: (accum0 >> 16) & mask k..k+7 + red table     red byte * 2^k
+//   interp0 lane 1: (accum0 >>  8) & mask k..k+7 + green table   cross input, reads accum0 too
+//   interp1 lane 0: (accum0 >>  0) & mask k..k+7 + blue table    lanes only shift right
+//
+// The interpolators belong to the calling core. Their state is saved and restored around a
+// mapping run, so both cores can map at the same time and application code using them is
+// not disturbed - as long as no IRQ handler uses them without saving them itself.
+//
+// utils/hub75_interp_check.cpp runs this header against a host model of the interpolator
+// (utils/interp_emu.h); include "hardware/interp.h" or the model before this file.
+
+struct interp_lut_t
+{
+    interp_hw_save_t saved0;
+    interp_hw_save_t saved1;
+};
+
+/**
+ * @brief Save interp0 / interp1 of the calling core and set them up for interp_lut_lookup().
+ *
+ * @param red, green, blue tables with 256 entries
+ * @param entry_shift      log2 of the entry size in bytes
+ */
+static inline void interp_lut_begin(interp_lut_t &state, const void *red, const void *green, const void *blue,
+                                    uint32_t entry_shift)
+{
+    interp_save(interp0, &state.saved0);
+    interp_save(interp1, &state.saved1);
+
+    interp_config cfg = interp_default_config();
+    interp_config_set_shift(&cfg, 16);
+    interp_config_set_mask(&cfg, entry_shift, entry_shift + 7);
+    interp_set_config(interp0, 0, &cfg);
+
+    interp_config_set_shift(&cfg, 8);
+    interp_config_set_cross_input(&cfg, true);
+    interp_set_config(interp0, 1, &cfg);
+
+    cfg = interp_default_config();
+    interp_config_set_mask(&cfg, entry_shift, entry_shift + 7);
+    interp_set_config(interp1, 0, &cfg);
+
+    interp0->base[0] = (uintptr_t)red;
+    interp0->base[1] = (uintptr_t)green;
+    interp1->base[0] = (uintptr_t)blue;
+}
+
+/**
+ * @brief Restore the interpolator state saved by interp_lut_begin().
+ */
+static inline void interp_lut_end(interp_lut_t &state)
+{
+    interp_restore(interp0, &state.saved0);
+    interp_restore(interp1, &state.saved1);
+}
+
+/**
+ * @brief Addresses of the table entries of a 0x00RRGGBB colour (the alpha byte is ignored).
+ *
+ * @param entry_shift same as passed to interp_lut_begin()
+ */
+static inline void interp_lut_lookup(uint32_t colour, uint32_t entry_shift, const void *&r, const void *&g, const void *&b)
+{
+    const uint32_t accum = colour << entry_shift;
+    interp0->accum[0] = accum;
+    interp1->accum[0] = accum;
+    r = (const void *)(uintptr_t)interp0->peek[0];
+    g = (const void *)(uintptr_t)interp0->peek[1];
+    b = (const void *)(uintptr_t)interp1->peek[0];
+}
+
+/**
+ * @brief Look up the CIE values of a 0x00RRGGBB colour, tables set up with entry_shift 1.
+ */
+static inline void interp_lut_channels(uint32_t colour, uint32_t &rv, uint32_t &gv, uint32_t &bv)
+{
+    const void *r, *g, *b;
+    interp_lut_lookup(colour, 1, r, g, b);
+    rv = *(const uint16_t *)r;
+    gv = *(const uint16_t *)g;
+    bv = *(const uint16_t *)b;
+}
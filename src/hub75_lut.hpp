@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+
+// Integer-only generator for the brightness LUTs (RUNTIME_LUT)
+//
+// Same tables as utils/cie.py, computed on the device: a normalised curve Y(v) for the
+// input byte v, scaled per channel by the white-point cap, with an optional black level:
+//
+//   out(0) = 0
+//   out(v) = black + round(Y(v) * (max * cap - black))
+//
+// Y(v) is the CIE 1931 lightness curve of cie.py, or (v / 255)^gamma. Everything runs in
+// fixed point: Y in Q24, caps and gamma in Q16, one 64-bit division per entry for the CIE
+// curve and a bit-serial log2 / exp2 pair for gamma. The curve is built separately from the
+// scaling, so a caller that keeps it only pays 768 multiplies when caps or black change.
+//
+// With black 0 and the caps of cie.py the CIE tables match src/cie.hpp - 2 of 768 entries
+// differ by one step, where 0.988 in Q16 tips a value lying within 0.005 of .5.
+// utils/hub75_lut_check.cpp checks that and compares the gamma curves with pow().
+
+constexpr int LUT_Y_BITS = 24;   ///< fractional bits of the normalised curve
+constexpr int LUT_LOG_BITS = 24; ///< fractional bits of log2 / exp2
+
+// Y(v) of the CIE 1931 lightness formula for L = 100 * v / 255, in Q24
+static inline uint32_t lut_cie1931(uint32_t v)
+{
+    // L <= 8: Y = L / 903.3 (exactly ((L + 16) / 116 - 4 / 29) * 3 * (6 / 29)^2 as in cie.py)
+    //         = 10800 * v / 24877020
+    if (100u * v <= 8u * 255u)
+        return (uint32_t)((((uint64_t)10800u * v << LUT_Y_BITS) + 24877020u / 2) / 24877020u);
+
+    // L > 8:  Y = ((L + 16) / 116)^3 = (n / 29580)^3 with n = 100 * v + 16 * 255
+    const uint64_t n = 100u * v + 16u * 255u;
+    const uint64_t f = ((n << 31) + 29580u / 2) / 29580u; // Q31, <= 1.0
+    const uint64_t f2 = (f * f + (1ull << 30)) >> 31;
+    return (uint32_t)((f2 * f + (1ull << 37)) >> 38); // Q31 * Q31 >> 38 = Q24
+}
+
+// log2(v) for v >= 1 in Q24
+static inline int32_t lut_log2(uint32_t v)
+{
+    int k = 31 - __builtin_clz(v);
+    uint64_t x = ((uint64_t)v << 30) >> k; // v / 2^k in [1, 2), Q30
+    int32_t result = k << LUT_LOG_BITS;
+
+    for (int bit = LUT_LOG_BITS - 1; bit >= 0; --bit)
+    {
+        x = (x * x) >> 30;
+        if (x >= (2ull << 30))
+        {
+            x >>= 1;
+            result |= 1 << bit;
+        }
+    }
+    return result;
+}
+
+// 2^-e for e >= 0 in Q24, result in Q24
+static inline uint32_t lut_exp2_neg(uint32_t e)
+{
+    static const uint32_t EXP2_NEG[LUT_LOG_BITS] = {
+    1518500250u, // 2^-(2^-1)
+    1805811301u, // 2^-(2^-2)
+    1969251188u, // 2^-(2^-3)
+    2056437387u, // 2^-(2^-4)
+    2101467502u, // 2^-(2^-5)
+    2124350982u, // 2^-(2^-6)
+    2135885998u, // 2^-(2^-7)
+    2141676973u, // 2^-(2^-8)
+    2144578345u, // 2^-(2^-9)
+    2146030505u, // 2^-(2^-10)
+    2146756953u, // 2^-(2^-11)
+    2147120270u, // 2^-(2^-12)
+    2147301951u, // 2^-(2^-13)
+    2147392798u, // 2^-(2^-14)
+    2147438222u, // 2^-(2^-15)
+    2147460935u, // 2^-(2^-16)
+    2147472292u, // 2^-(2^-17)
+    2147477970u, // 2^-(2^-18)
+    2147480809u, // 2^-(2^-19)
+    2147482228u, // 2^-(2^-20)
+    2147482938u, // 2^-(2^-21)
+    2147483293u, // 2^-(2^-22)
+    2147483471u, // 2^-(2^-23)
+    2147483559u, // 2^-(2^-24)
+    };
+
+    const uint32_t k = e >> LUT_LOG_BITS;
+    if (k > LUT_Y_BITS)
+        return 0;
+
+    uint64_t y = 1ull << 31; // Q31
+    for (int i = 0; i < LUT_LOG_BITS; ++i)
+    {
+        if (e & (1u << (LUT_LOG_BITS - 1 - i)))
+            y = (y * EXP2_NEG[i] + (1ull << 30)) >> 31;
+    }
+    const uint32_t shift = 31 - LUT_Y_BITS + k;
+    return (uint32_t)((y + (1ull << (shift - 1))) >> shift);
+}
+
+// Y(v) = (v / 255)^gamma in Q24, gamma in Q16
+static inline uint32_t lut_gamma(uint32_t v, uint32_t gamma_q16, int32_t log2_255)
+{
+    if (v == 0)
+        return 0;
+    // log2(v / 255) <= 0, times gamma
+    const int64_t e = ((int64_t)(log2_255 - lut_log2(v)) * gamma_q16 + (1 << 15)) >> 16;
+    return lut_exp2_neg(e > (int64_t)UINT32_MAX ? UINT32_MAX : (uint32_t)e);
+}
+
+/**
+ * @brief Normalised curve Y(v) in Q24 for the 256 input bytes.
+ *
+ * @param gamma_q16 exponent in Q16, 0 selects the CIE 1931 curve
+ */
+static inline void lut_build_curve(uint32_t curve[256], uint32_t gamma_q16)
+{
+    const int32_t log2_255 = lut_log2(255);
+    for (uint32_t v = 0; v < 256; ++v)
+        curve[v] = gamma_q16 ? lut_gamma(v, gamma_q16, log2_255) : lut_cie1931(v);
+}
+
+/**
+ * @brief Fill the red, green and blue tables from a curve of lut_build_curve().
+ *
+ * @param tables  three tables of 256 entries
+ * @param cap_q16 white-point scale per channel in Q16 (65536 = 1.0)
+ * @param max     highest output value (1023 for 10 bitplanes, 255 for 8)
+ * @param black   output of the darkest non-zero input, 0 .. max
+ */
+static inline void lut_scale_tables(uint16_t *const tables[3], const uint32_t curve[256], const uint32_t cap_q16[3], uint32_t max,
+                                    uint32_t black)
+{
+    // Output span above the black level in Q16: max * cap - black
+    uint64_t span[3];
+    for (int c = 0; c < 3; ++c)
+    {
+        const uint64_t cap = cap_q16[c] > 65536u ? 65536u : cap_q16[c];
+        const uint64_t top = (uint64_t)max * cap;
+        span[c] = top > ((uint64_t)black << 16) ? top - ((uint64_t)black << 16) : 0;
+    }
+
+    for (int c = 0; c < 3; ++c)
+    {
+        tables[c][0] = 0;
+        for (uint32_t v = 1; v < 256; ++v)
+            tables[c][v] = (uint16_t)(black + ((curve[v] * span[c] + (1ull << (LUT_Y_BITS + 15))) >> (LUT_Y_BITS + 16)));
+    }
+}
+
+/**
+ * @brief Fill the red, green and blue tables, lut_build_curve() and lut_scale_tables() in one go.
+ */
+static inline void lut_build_tables(uint16_t *const tables[3], uint32_t gamma_q16, const uint32_t cap_q16[3], uint32_t max,
+                                    uint32_t black)
+{
+    uint32_t curve[256];
+    lut_build_curve(curve, gamma_q16);
+    lut_scale_tables(tables, curve, cap_q16, max, black);
+}
@@ -0,0 +1,282 @@
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/pio.h"
+#include "hardware/uart.h"
+
+#if LIB_PICO_STDIO_USB
+#include "tusb.h"
+#endif
+
+#include "hub75.hpp"
+#include "hub75.pio.h"
+
+// Receive path for the framed frame-stream protocol (see include/hub75_stream_decoder.h)
+//
+//   UART → DMA ring buffer → decoder → hub75_write_rect_bgr() → rgb_buffer
+//   SPI / 8080 bus → PIO slave → DMA ring buffer → decoder → ...
+//   USB CDC → TinyUSB FIFO → decoder → ...
+//
+// Pixels go straight from the receive buffer into their scan-ordered rgb_buffer slots;
+// there is no frame-sized staging buffer.
+//
+// The bus slaves add back-pressure: the host waits for READY high, then sends at most
+// STREAM_BUS_CHUNK bytes in one CS assertion. The PIO program pulls READY low as soon as the
+// chunk starts; hub75_stream_poll() raises it again once the ring has room for the next one.
+
+constexpr uint32_t RING_SIZE = 1u << STREAM_RING_BITS;
+constexpr uint32_t RING_ARM_COUNT = 0x0fffffffu; // largest count valid on RP2040 and RP2350
+constexpr uint32_t TRANSFER_COUNT_MASK = 0x0fffffffu; // RP2350 keeps the transfer mode in bits 31:28
+
+alignas(RING_SIZE) static uint8_t ring[RING_SIZE];
+static int ring_chan = -1;
+static uint32_t ring_read = 0;  ///< total bytes consumed from the ring
+static uint32_t ring_armed = 0; ///< total bytes received when ring_chan was last (re)armed
+
+static PIO bus_pio = nullptr;
+static uint bus_sm = 0;
+static uint bus_offset = 0;
+static bool bus_spi = false;
+static uint bus_cs_pin = 0;
+static uint bus_ready_pin = 0;
+
+static bool usb_enabled = false;
+static bool decoder_ready = false;
+static bool present_deferred = false;
+static hub75_stream_decoder_t decoder;
+
+static void sink_write(int x, int y, int n, const uint8_t *bgr)
+{
+    hub75_write_rect_bgr(x, y, n, 1, bgr, n * 3);
+}
+
+static void sink_fill(int x, int y, int n, uint8_t b, uint8_t g, uint8_t r)
+{
+    hub75_fill_rect(x, y, n, 1, r, g, b);
+}
+
+static void sink_present(void)
+{
+    // Never restart a bitplane build that is still running
+    if (hub75_present_pending())
+        present_deferred = true;
+    else
+        hub75_present();
+}
+
+static void init_decoder()
+{
+    if (decoder_ready)
+        return;
+
+    const hub75_stream_sink_t sink = {sink_write, sink_fill, sink_present};
+    hub75_stream_decoder_init(&decoder, HUB75_SCREEN_WIDTH, HUB75_SCREEN_HEIGHT, &sink);
+    decoder_ready = true;
+}
+
+// Total bytes written into the ring by ring_chan so far
+static inline uint32_t ring_produced()
+{
+    return ring_armed + (RING_ARM_COUNT - (dma_channel_hw_addr(ring_chan)->transfer_count & TRANSFER_COUNT_MASK));
+}
+
+// Start ring_chan on a byte-wide receive FIFO
+static void start_ring(uint dreq, const volatile void *fifo)
+{
+    ring_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(ring_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, STREAM_RING_BITS); // wrap write address at RING_SIZE
+    channel_config_set_dreq(&c, dreq);
+
+    ring_read = 0;
+    ring_armed = 0;
+    dma_channel_configure(
+        ring_chan,
+        &c,
+        ring,                                      // Write into ring buffer
+        fifo,                                      // Read from the receive FIFO
+        dma_encode_transfer_count(RING_ARM_COUNT), // Re-armed by hub75_stream_poll() long before it runs out
+        true                                       // Start immediately
+    );
+}
+
+/**
+ * @brief Receive frames on a UART through a DMA-fed ring buffer.
+ *
+ * @param uart_num UART instance (0 or 1)
+ * @param rx_pin   GPIO with UART RX function for that instance
+ * @param baudrate e.g. 3000000 for a USB-UART bridge
+ */
+void hub75_stream_init_uart(int uart_num, uint rx_pin, uint baudrate)
+{
+    uart_inst_t *uart = UART_INSTANCE(uart_num);
+    uart_init(uart, baudrate);
+    gpio_set_function(rx_pin, GPIO_FUNC_UART);
+
+    start_ring(uart_get_dreq(uart, false), &uart_get_hw(uart)->dr);
+    init_decoder();
+}
+
+// Claim a state machine for a bus slave program; pins first_pin .. first_pin + n_pins - 1 and ready_pin
+static void start_bus(const pio_program_t *program, uint first_pin, uint n_pins, uint ready_pin, uint cs_pin)
+{
+    const uint lo = ready_pin < first_pin ? ready_pin : first_pin;
+    const uint hi = ready_pin >= first_pin + n_pins ? ready_pin + 1 : first_pin + n_pins;
+    hard_assert(pio_claim_free_sm_and_add_program_for_gpio_range(program, &bus_pio, &bus_sm, &bus_offset, lo, hi - lo, true));
+    bus_spi = program == &hub75_spi_slave_program;
+    bus_cs_pin = cs_pin;
+    bus_ready_pin = ready_pin;
+}
+
+/**
+ * @brief Receive frames as an SPI slave (mode 0, MSB first) through a PIO state machine and a DMA-fed ring buffer.
+ *
+ * @param mosi_pin  MOSI; SCK is mosi_pin + 1, CS (active low) mosi_pin + 2
+ * @param ready_pin READY output: high when the host may send the next chunk of up to STREAM_BUS_CHUNK bytes
+ *
+ * SCK may run up to clk_sys / 8 (33 MHz at 266 MHz, 16.6 MHz at 133 MHz); the state machine
+ * itself needs 3 cycles high and 2 low (utils/stream_bus_check.cpp).
+ */
+void hub75_stream_init_spi(uint mosi_pin, uint ready_pin)
+{
+    start_bus(&hub75_spi_slave_program, mosi_pin, 3, ready_pin, mosi_pin + 2);
+    hub75_spi_slave_program_init(bus_pio, bus_sm, bus_offset, mosi_pin, ready_pin);
+
+    start_ring(pio_get_dreq(bus_pio, bus_sm, false), &bus_pio->rxf[bus_sm]);
+    init_decoder();
+}
+
+/**
+ * @brief Receive frames on an 8080-style write-only parallel bus through a PIO state machine and a DMA-fed ring buffer.
+ *
+ * @param data_pin  D0; D1..D7 follow, WR (active low, data latched on the rising edge) is data_pin + 8, CS (active low) data_pin + 9
+ * @param ready_pin READY output, as for hub75_stream_init_spi()
+ *
+ * A write cycle may be as short as 6 clk_sys cycles, 3 low and 3 high (the state machine needs 2 high).
+ */
+void hub75_stream_init_parallel(uint data_pin, uint ready_pin)
+{
+    start_bus(&hub75_parallel_slave_program, data_pin, 10, ready_pin, data_pin + 9);
+    hub75_parallel_slave_program_init(bus_pio, bus_sm, bus_offset, data_pin, ready_pin);
+
+    start_ring(pio_get_dreq(bus_pio, bus_sm, false), &bus_pio->rxf[bus_sm]);
+    init_decoder();
+}
+
+/**
+ * @brief Receive frames on the USB CDC interface also used by stdio.
+ *
+ * Only available when the application is built with pico_enable_stdio_usb().
+ */
+void hub75_stream_init_usb(void)
+{
+#if LIB_PICO_STDIO_USB
+    usb_enabled = true;
+    init_decoder();
+#endif
+}
+
+/**
+ * @brief Decode everything received since the last call; call this frequently.
+ *
+ * Complete frames are presented as soon as the previous one has reached the panel.
+ */
+void hub75_stream_poll(void)
+{
+    if (!decoder_ready)
+        return;
+
+    if (present_deferred && !hub75_present_pending())
+    {
+        present_deferred = false;
+        hub75_present();
+    }
+
+    // A presented frame is built from rgb_buffer until it is on the panel. The decoder stops
+    // right after a present, and the next frame's bytes wait in the ring (bus slaves: behind
+    // READY) or in the USB FIFO until then.
+    const bool hold = present_deferred || hub75_present_pending();
+
+    if (ring_chan >= 0)
+    {
+        const uint32_t produced = ring_produced();
+
+        if (produced - ring_read > RING_SIZE)
+        {
+            // The DMA lapped the decoder - drop what was lost and resync on the next packet
+            decoder.stats.overruns++;
+            ring_read = produced;
+            hub75_stream_decoder_reset(&decoder);
+        }
+
+        while (!hold && ring_read != produced)
+        {
+            const uint32_t offset = ring_read & (RING_SIZE - 1);
+            uint32_t n = produced - ring_read;
+            if (n > RING_SIZE - offset)
+                n = RING_SIZE - offset;
+
+            const uint32_t used = (uint32_t)hub75_stream_decoder_feed(&decoder, ring + offset, n);
+            ring_read += used;
+            if (used < n)
+                break; // presented
+        }
+
+        // Bus slaves: nothing arrives while READY is low and CS high
+        const bool bus_idle = bus_pio && !gpio_get(bus_ready_pin) && gpio_get(bus_cs_pin);
+
+        // Re-arm long before the transfer count runs out.
+        // Bytes arriving meanwhile wait in the UART RX FIFO; a bus slave re-arms between chunks.
+        if ((!bus_pio || bus_idle) && (dma_channel_hw_addr(ring_chan)->transfer_count & TRANSFER_COUNT_MASK) < (RING_ARM_COUNT >> 1))
+        {
+            dma_channel_abort(ring_chan);
+            ring_armed = ring_produced();
+            dma_channel_set_write_addr(ring_chan, ring + (ring_armed & (RING_SIZE - 1)), false);
+            dma_channel_set_trans_count(ring_chan, dma_encode_transfer_count(RING_ARM_COUNT), true);
+        }
+
+        // SPI chunk cut off in the middle of a byte: the slave still waits for SCK inside its bit
+        // loop. Drop the partial byte so the next chunk does not complete it with its first bits.
+        if (bus_idle && bus_spi && pio_sm_get_pc(bus_pio, bus_sm) != bus_offset)
+        {
+            pio_sm_exec(bus_pio, bus_sm, pio_encode_jmp(bus_offset + hub75_spi_slave_offset_abort));
+            decoder.stats.aborted_chunks++;
+        }
+
+        // Bus slaves: let the host send its next chunk once it fits. Only between chunks (CS high) -
+        // the host does not start one while READY is low, so READY can not rise under a running chunk.
+        if (bus_idle && RING_SIZE - (ring_produced() - ring_read) >= STREAM_BUS_CHUNK)
+            pio_sm_exec(bus_pio, bus_sm, pio_encode_nop() | pio_encode_sideset_opt(1, 1));
+    }
+
+#if LIB_PICO_STDIO_USB
+    if (usb_enabled && !hold)
+    {
+        // Bytes read from the FIFO but not decoded before a present
+        static uint8_t buf[64];
+        static uint32_t buf_pos = 0, buf_len = 0;
+        for (;;)
+        {
+            if (buf_pos == buf_len)
+            {
+                if (!tud_cdc_available())
+                    break;
+                buf_len = tud_cdc_read(buf, sizeof(buf));
+                buf_pos = 0;
+            }
+            const uint32_t n = buf_len - buf_pos;
+            const uint32_t used = (uint32_t)hub75_stream_decoder_feed(&decoder, buf + buf_pos, n);
+            buf_pos += used;
+            if (used < n)
+                break; // presented
+        }
+    }
+#endif
+}
+
+void hub75_stream_get_stats(hub75_stream_stats_t *stats)
+{
+    *stats = decoder.stats;
+}
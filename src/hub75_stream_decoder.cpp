@@ -0,0 +1,349 @@
+#include "hub75_stream_decoder.h"
+
+enum
+{
+    S_SYNC0,
+    S_SYNC1,
+    S_HEADER,  ///< type, flags, length
+    S_RECT,    ///< x, y, w, h of STREAM_RECT / STREAM_RLE
+    S_PIXELS,  ///< raw BGR pixels of STREAM_FULL / STREAM_RECT
+    S_RLE_CTRL,
+    S_RLE_RUN, ///< BGR pixel of a run
+    S_RLE_LIT, ///< literal BGR pixels
+    S_SUM,
+};
+
+static inline uint32_t get_u16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static inline void fail(hub75_stream_decoder_t *dec)
+{
+    dec->stats.errors++;
+    dec->state = S_SYNC0;
+    dec->carry_len = 0;
+}
+
+// Account for n payload bytes
+static inline void take(hub75_stream_decoder_t *dec, const uint8_t *p, size_t n)
+{
+    uint16_t sum = dec->sum;
+    for (size_t k = 0; k < n; ++k)
+        sum += p[k];
+    dec->sum = sum;
+    dec->length -= n;
+}
+
+static inline void advance(hub75_stream_decoder_t *dec, int n)
+{
+    dec->pixels -= n;
+    dec->cx += n;
+    if (dec->cx == dec->rw)
+    {
+        dec->cx = 0;
+        dec->cy++;
+    }
+}
+
+static void set_rect(hub75_stream_decoder_t *dec, int x, int y, int w, int h)
+{
+    dec->rx = x;
+    dec->ry = y;
+    dec->rw = w;
+    dec->rh = h;
+    dec->cx = 0;
+    dec->cy = 0;
+    dec->pixels = (uint32_t)w * h;
+    dec->carry_len = 0;
+}
+
+// Pixels of the current rectangle are done (or an RLE packet is), pick the next state
+static void pixels_done(hub75_stream_decoder_t *dec)
+{
+    if (dec->pixels == 0)
+    {
+        if (dec->length != 0)
+            return fail(dec); // payload longer than the rectangle
+        dec->state = S_SUM;
+        dec->hdr_len = 0;
+    }
+    else if (dec->length == 0)
+    {
+        fail(dec); // payload ends before the rectangle is complete
+    }
+    else if (dec->type == STREAM_RLE)
+    {
+        dec->state = S_RLE_CTRL;
+    }
+}
+
+/**
+ * @brief Hand raw BGR pixels to the sink, one row segment at a time.
+ *
+ * @return bytes consumed, at most max_pixels pixels are written
+ */
+static size_t write_raw(hub75_stream_decoder_t *dec, const uint8_t *p, size_t n, uint32_t max_pixels)
+{
+    if (n > dec->length)
+        n = dec->length;
+
+    size_t used = 0;
+
+    // Complete a pixel split across feed() calls
+    if (dec->carry_len)
+    {
+        while (dec->carry_len < 3 && used < n)
+            dec->carry[dec->carry_len++] = p[used++];
+        if (dec->carry_len < 3)
+        {
+            take(dec, p, used);
+            return used;
+        }
+        dec->sink.write(dec->rx + dec->cx, dec->ry + dec->cy, 1, dec->carry);
+        advance(dec, 1);
+        dec->carry_len = 0;
+        max_pixels--;
+    }
+
+    while (max_pixels && n - used >= 3)
+    {
+        uint32_t seg = dec->rw - dec->cx;
+        if (seg > (n - used) / 3)
+            seg = (n - used) / 3;
+        if (seg > max_pixels)
+            seg = max_pixels;
+
+        dec->sink.write(dec->rx + dec->cx, dec->ry + dec->cy, seg, p + used);
+        advance(dec, seg);
+        used += seg * 3;
+        max_pixels -= seg;
+    }
+
+    // Keep a trailing partial pixel for the next call
+    if (max_pixels && used < n)
+    {
+        while (used < n)
+            dec->carry[dec->carry_len++] = p[used++];
+    }
+
+    take(dec, p, used);
+    return used;
+}
+
+static void fill(hub75_stream_decoder_t *dec, uint32_t n, const uint8_t *bgr)
+{
+    while (n)
+    {
+        uint32_t seg = dec->rw - dec->cx;
+        if (seg > n)
+            seg = n;
+        dec->sink.fill(dec->rx + dec->cx, dec->ry + dec->cy, seg, bgr[0], bgr[1], bgr[2]);
+        advance(dec, seg);
+        n -= seg;
+    }
+}
+
+static void begin_packet(hub75_stream_decoder_t *dec)
+{
+    dec->type = dec->hdr[0];
+    dec->flags = dec->hdr[1];
+    dec->length = dec->hdr[2] | (dec->hdr[3] << 8) | (dec->hdr[4] << 16) | ((uint32_t)dec->hdr[5] << 24);
+    dec->sum = 0;
+    dec->hdr_len = 0;
+
+    switch (dec->type)
+    {
+    case STREAM_FULL:
+        if (dec->length != (uint32_t)dec->width * dec->height * 3)
+            return fail(dec);
+        set_rect(dec, 0, 0, dec->width, dec->height);
+        dec->state = S_PIXELS;
+        break;
+    case STREAM_RECT:
+    case STREAM_RLE:
+        if (dec->length < 8)
+            return fail(dec);
+        dec->state = S_RECT;
+        break;
+    case STREAM_PRESENT:
+        if (dec->length != 0)
+            return fail(dec);
+        dec->state = S_SUM;
+        break;
+    default:
+        fail(dec);
+    }
+}
+
+static void begin_rect(hub75_stream_decoder_t *dec)
+{
+    const int x = get_u16(dec->hdr);
+    const int y = get_u16(dec->hdr + 2);
+    const int w = get_u16(dec->hdr + 4);
+    const int h = get_u16(dec->hdr + 6);
+
+    if (w == 0 || h == 0 || x + w > dec->width || y + h > dec->height)
+        return fail(dec);
+
+    set_rect(dec, x, y, w, h);
+
+    if (dec->type == STREAM_RECT)
+    {
+        if (dec->length != dec->pixels * 3)
+            return fail(dec);
+        dec->state = S_PIXELS;
+    }
+    else
+    {
+        if (dec->length == 0)
+            return fail(dec);
+        dec->state = S_RLE_CTRL;
+    }
+}
+
+static void end_packet(hub75_stream_decoder_t *dec)
+{
+    dec->state = S_SYNC0;
+
+    if (get_u16(dec->hdr) != dec->sum)
+    {
+        dec->stats.checksum_errors++;
+        return;
+    }
+
+    dec->stats.packets++;
+    if (dec->type == STREAM_FULL || dec->type == STREAM_PRESENT || (dec->flags & STREAM_FLAG_PRESENT))
+    {
+        dec->stats.frames++;
+        dec->sink.present();
+    }
+}
+
+void hub75_stream_decoder_init(hub75_stream_decoder_t *dec, int width, int height, const hub75_stream_sink_t *sink)
+{
+    dec->width = width;
+    dec->height = height;
+    dec->sink = *sink;
+    dec->stats = {};
+    hub75_stream_decoder_reset(dec);
+}
+
+void hub75_stream_decoder_reset(hub75_stream_decoder_t *dec)
+{
+    dec->state = S_SYNC0;
+    dec->hdr_len = 0;
+    dec->carry_len = 0;
+}
+
+/**
+ * @brief Feed received bytes into the decoder.
+ *
+ * Chunks may be split anywhere, including inside headers and pixels.
+ */
+size_t hub75_stream_decoder_feed(hub75_stream_decoder_t *dec, const uint8_t *data, size_t len)
+{
+    const uint32_t frames = dec->stats.frames;
+    size_t i = 0;
+
+    while (i < len)
+    {
+        switch (dec->state)
+        {
+        case S_SYNC0:
+            if (data[i++] == STREAM_SYNC0)
+                dec->state = S_SYNC1;
+            break;
+
+        case S_SYNC1:
+        {
+            const uint8_t b = data[i++];
+            if (b == STREAM_SYNC1)
+            {
+                dec->state = S_HEADER;
+                dec->hdr_len = 0;
+            }
+            else if (b != STREAM_SYNC0)
+            {
+                dec->state = S_SYNC0;
+            }
+            break;
+        }
+
+        case S_HEADER:
+            dec->hdr[dec->hdr_len++] = data[i++];
+            if (dec->hdr_len == 6)
+                begin_packet(dec);
+            break;
+
+        case S_RECT:
+            take(dec, data + i, 1);
+            dec->hdr[dec->hdr_len++] = data[i++];
+            if (dec->hdr_len == 8)
+                begin_rect(dec);
+            break;
+
+        case S_PIXELS:
+            i += write_raw(dec, data + i, len - i, dec->pixels);
+            if (dec->pixels == 0 || dec->length == 0)
+                pixels_done(dec);
+            break;
+
+        case S_RLE_CTRL:
+            dec->rle_ctrl = data[i];
+            dec->rle_n = (data[i] & 0x7f) + 1;
+            take(dec, data + i, 1);
+            ++i;
+            if (dec->rle_n > dec->pixels || dec->length == 0)
+            {
+                fail(dec);
+                break;
+            }
+            dec->state = (dec->rle_ctrl & 0x80) ? S_RLE_RUN : S_RLE_LIT;
+            dec->hdr_len = 0;
+            break;
+
+        case S_RLE_RUN:
+            take(dec, data + i, 1);
+            dec->hdr[dec->hdr_len++] = data[i++];
+            if (dec->hdr_len == 3)
+            {
+                fill(dec, dec->rle_n, dec->hdr);
+                pixels_done(dec);
+            }
+            else if (dec->length == 0)
+            {
+                fail(dec);
+            }
+            break;
+
+        case S_RLE_LIT:
+        {
+            const uint32_t before = dec->pixels;
+            i += write_raw(dec, data + i, len - i, dec->rle_n);
+            dec->rle_n -= before - dec->pixels;
+            if (dec->rle_n == 0)
+                pixels_done(dec);
+            else if (dec->length == 0)
+                fail(dec);
+            break;
+        }
+
+        case S_SUM:
+            dec->hdr[dec->hdr_len++] = data[i++];
+            if (dec->hdr_len == 2)
+            {
+                end_packet(dec);
+                if (dec->stats.frames != frames)
+                {
+                    // The next frame must not be written while this one is built
+                    dec->stats.bytes += i;
+                    return i;
+                }
+            }
+            break;
+        }
+    }
+    dec->stats.bytes += len;
+    return len;
+}
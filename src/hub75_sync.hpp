@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cstdint>
+
+// Frame sync decisions (FRAME_SYNC), without hardware access
+//
+// The controllers of a wall share one pulse: a rising edge on FRAME_SYNC_PIN. hub75.cpp
+// feeds three events into a sync_t and carries out what comes back:
+//
+//   sync_pulse()  edge interrupt                                -> restart a stopped stream?
+//   sync_frame()  ctrl_chan_handler(), row_ctrl_chan completed  -> continue, cut the chain, wait or restart
+//   sync_swap()   ctrl_chan_handler(), pixel frame boundary     -> may a pending swap happen?
+//
+// Swaps: a pending swap waits for the first pixel frame boundary after a pulse, so all
+// controllers show a new frame within one refresh period of the pulse. With refresh
+// alignment the window opens when the stream restarts, so every controller swaps at the
+// end of the first frame after the pulse.
+//
+// Refresh alignment (align): every pulse starts a refresh frame. When a frame starts, the
+// frame after it must end before the next expected pulse + late_us. If it would not, the
+// chain row_ctrl_chan -> row_chan is cut, the stream stops at the end of the current frame
+// with OE off and the pulse restarts it. A pulse that arrives while that frame still runs
+// restarts the stream right at its end (late). A pulse while no stop is armed (locking on,
+// or an early pulse) is a resync; the frames line up from the next pulse on.
+//
+// Without a pulse for 1.5 periods the sync counts as lost: swaps are no longer held, no
+// stream is stopped, and a stopped stream restarts from sync_timeout().
+//
+// Times are time_us_32() values; all comparisons are wrap-safe differences.
+// utils/hub75_sync_check.cpp runs this header against simulated pulse trains.
+
+enum sync_state_t : uint8_t
+{
+    SYNC_RUNNING, ///< streaming
+    SYNC_ARMED,   ///< chain cut, the frame in flight is the last one before the pulse
+    SYNC_STOPPED, ///< waiting for the pulse, OE off
+};
+
+enum sync_action_t : uint8_t
+{
+    SYNC_CONTINUE, ///< nothing to do
+    SYNC_CUT,      ///< cut the chain row_ctrl_chan -> row_chan
+    SYNC_WAIT,     ///< the stream has stopped, arm the timeout (sync_timeout_in())
+    SYNC_RESTART,  ///< restore the chain and start row_chan
+};
+
+struct sync_t
+{
+    bool align;         ///< start a refresh frame at every pulse
+    uint32_t late_us;   ///< a frame may end this long after the expected pulse
+    uint8_t state;      ///< sync_state_t
+    bool gap;           ///< the last pulse interval was a gap
+    bool have_pulse;    ///< pulse_us is valid
+    bool pulse_pending; ///< pulse not yet matched with a frame start
+    bool swap_window;   ///< pulse since the last pixel frame boundary
+    bool holding;       ///< a pending swap waits for a pulse
+    bool have_phase;    ///< last_phase is valid
+    uint32_t pulse_us;  ///< time of the last pulse
+    uint32_t period_us; ///< last regular pulse interval, 0 = unknown
+    uint32_t stop_us;   ///< time the stream stopped
+    int32_t last_phase; ///< phase at the previous pulse
+
+    // Statistics
+    uint32_t pulses;
+    uint32_t missed;
+    uint32_t late;
+    uint32_t resyncs;
+    uint32_t stops;
+    uint32_t held_swaps;
+    uint64_t waited_us;
+    uint32_t period_min, period_max, period_count;
+    uint64_t period_sum;
+    int32_t phase, phase_min, phase_max;
+    int64_t drift_us;       ///< sum of the phase changes between consecutive pulses
+    uint64_t drift_span_us; ///< time over which drift_us was collected
+};
+
+static inline void sync_init(sync_t &s, bool align, uint32_t late_us)
+{
+    s = sync_t{};
+    s.align = align;
+    s.late_us = late_us;
+    s.state = SYNC_RUNNING;
+    s.period_min = UINT32_MAX;
+    s.phase_min = INT32_MAX;
+    s.phase_max = INT32_MIN;
+}
+
+/**
+ * @brief True without a pulse for 1.5 periods (or before the period is known).
+ */
+static inline bool sync_lost(const sync_t &s, uint32_t now)
+{
+    return !s.have_pulse || !s.period_us || now - s.pulse_us > s.period_us + (s.period_us >> 1);
+}
+
+// A local frame started phase us after the pulse
+static inline void sync_phase(sync_t &s, int32_t phase, uint32_t frame_us)
+{
+    s.phase = phase;
+    if (phase < s.phase_min)
+        s.phase_min = phase;
+    if (phase > s.phase_max)
+        s.phase_max = phase;
+
+    // Free running, the phase wanders by the rate difference; wrapped into +- half a frame
+    if (!s.align && s.have_phase && !s.gap && frame_us)
+    {
+        int32_t d = phase - s.last_phase;
+        while (d > (int32_t)(frame_us >> 1))
+            d -= (int32_t)frame_us;
+        while (d < -(int32_t)(frame_us >> 1))
+            d += (int32_t)frame_us;
+        s.drift_us += d;
+        s.drift_span_us += s.period_us;
+    }
+    s.last_phase = phase;
+    s.have_phase = true;
+}
+
+/**
+ * @brief A rising edge at now. Returns true if the stopped stream must restart now.
+ */
+static inline bool sync_pulse(sync_t &s, uint32_t now)
+{
+    if (s.have_pulse)
+    {
+        const uint32_t interval = now - s.pulse_us;
+        if (s.period_us && interval > s.period_us + (s.period_us >> 1) && !s.gap)
+        {
+            // Pulses were lost; a second gap in a row is a new period
+            s.missed += (interval + (s.period_us >> 1)) / s.period_us - 1;
+            s.gap = true;
+        }
+        else
+        {
+            s.period_us = interval;
+            s.gap = false;
+            if (interval < s.period_min)
+                s.period_min = interval;
+            if (interval > s.period_max)
+                s.period_max = interval;
+            s.period_sum += interval;
+            ++s.period_count;
+        }
+    }
+    s.pulse_us = now;
+    s.have_pulse = true;
+    ++s.pulses;
+    if (!s.align || s.state != SYNC_ARMED)
+        s.swap_window = true; // armed: opened by the restart at the end of the frame
+
+    if (s.align && s.state == SYNC_STOPPED)
+    {
+        s.state = SYNC_RUNNING;
+        s.waited_us += now - s.stop_us;
+        sync_phase(s, 0, 0);
+        return true;
+    }
+    s.pulse_pending = true;
+    return false;
+}
+
+/**
+ * @brief row_ctrl_chan completed at now: a frame started or, when armed, the stream stopped.
+ *
+ * @param frame_us length of the last refresh frame, 0 = unknown (no frames are cut then)
+ */
+static inline sync_action_t sync_frame(sync_t &s, uint32_t now, uint32_t frame_us)
+{
+    if (s.state == SYNC_ARMED)
+    {
+        if (s.pulse_pending)
+        {
+            // The pulse came while the last frame was still running
+            s.pulse_pending = false;
+            s.state = SYNC_RUNNING;
+            s.swap_window = true;
+            ++s.late;
+            sync_phase(s, (int32_t)(now - s.pulse_us), frame_us);
+            return SYNC_RESTART;
+        }
+        s.state = SYNC_STOPPED;
+        s.stop_us = now;
+        return SYNC_WAIT;
+    }
+    if (s.state == SYNC_STOPPED)
+        return SYNC_CONTINUE;
+
+    if (s.pulse_pending)
+    {
+        s.pulse_pending = false;
+        if (s.align)
+            ++s.resyncs; // no stop was armed for it: locking on, or the pulse was early
+        else
+            sync_phase(s, (int32_t)(now - s.pulse_us), frame_us);
+    }
+
+    if (s.align && frame_us && !sync_lost(s, now))
+    {
+        // The frame after this one would end at now + 2 * frame_us
+        const uint32_t next = s.pulse_us + s.period_us;
+        if ((int32_t)(now + 2 * frame_us - next) > (int32_t)s.late_us)
+        {
+            s.state = SYNC_ARMED;
+            ++s.stops;
+            return SYNC_CUT;
+        }
+    }
+    return SYNC_CONTINUE;
+}
+
+/**
+ * @brief Delay from now after which a stopped stream gives up waiting (1.5 periods after the last pulse).
+ */
+static inline uint32_t sync_timeout_in(const sync_t &s, uint32_t now)
+{
+    const int32_t d = (int32_t)(s.pulse_us + s.period_us + (s.period_us >> 1) - now);
+    return d > 0 ? (uint32_t)d : 0;
+}
+
+/**
+ * @brief The timeout armed at SYNC_WAIT expired. Returns true if the stream must restart.
+ */
+static inline bool sync_timeout(sync_t &s, uint32_t now)
+{
+    if (s.state != SYNC_STOPPED)
+        return false;
+    s.state = SYNC_RUNNING;
+    s.waited_us += now - s.stop_us;
+    return true;
+}
+
+/**
+ * @brief Pixel frame boundary at now. Returns true if a pending swap may happen.
+ */
+static inline bool sync_swap(sync_t &s, uint32_t now, bool pending)
+{
+    const bool allowed = s.swap_window || sync_lost(s, now);
+    s.swap_window = false;
+    if (pending && !allowed && !s.holding)
+        ++s.held_swaps;
+    s.holding = pending && !allowed;
+    return allowed;
+}
@@ -0,0 +1,144 @@
+#include <cstdio>
+
+#include "pico/stdlib.h"
+#include "pico/sync.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+
+#include "hub75.hpp"
+
+// Event trace: one ring per core, newest events overwrite the oldest.
+//
+// Each core only writes its own ring, and the index bump plus the two stores run with the
+// local interrupts masked, so a thread and an IRQ handler on the same core cannot interleave
+// and the cores never wait for each other. The timestamps come from the shared 1 MHz timer,
+// so events of both cores can be merged. utils/trace2json.py turns hub75_trace_print()
+// output into Chrome / Perfetto trace JSON.
+
+#if TRACE_BUFFER_BITS > 0
+constexpr uint32_t TRACE_SIZE = 1u << TRACE_BUFFER_BITS;
+
+static struct
+{
+    hub75_trace_event_t events[TRACE_SIZE];
+    volatile uint32_t head; ///< total events written
+} trace_rings[NUM_CORES];
+
+static volatile bool trace_enabled = true;
+
+/**
+ * @brief Record an event on the calling core. Safe from threads and IRQ handlers.
+ *
+ * @param type HUB75_TRACE_* event
+ * @param arg  event specific (slice index, brightness, ...)
+ */
+void HUB75_RAM_FUNC(hub75_trace)(uint8_t type, uint16_t arg)
+{
+    if (!trace_enabled)
+        return;
+
+    const uint core = get_core_num();
+    auto &ring = trace_rings[core];
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    hub75_trace_event_t &e = ring.events[ring.head & (TRACE_SIZE - 1)];
+    e.time_us = time_us_32();
+    e.type = type;
+    e.core = (uint8_t)core;
+    e.arg = arg;
+    ring.head = ring.head + 1;
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Stop or resume recording, e.g. to freeze the rings around a glitch before dumping them.
+ */
+void hub75_trace_enable(bool enable)
+{
+    trace_enabled = enable;
+}
+
+// Merge cursor over the rings of both cores
+struct trace_cursor_t
+{
+    uint32_t pos[NUM_CORES];
+    uint32_t end[NUM_CORES];
+};
+
+static void trace_cursor_init(trace_cursor_t &cur)
+{
+    for (uint c = 0; c < NUM_CORES; ++c)
+    {
+        cur.end[c] = trace_rings[c].head;
+        cur.pos[c] = cur.end[c] > TRACE_SIZE ? cur.end[c] - TRACE_SIZE : 0;
+    }
+}
+
+// Oldest pending event of both cores (compared by time difference, the timer may wrap)
+static const hub75_trace_event_t *trace_cursor_next(trace_cursor_t &cur)
+{
+    const hub75_trace_event_t *oldest = nullptr;
+    int core = -1;
+    for (uint c = 0; c < NUM_CORES; ++c)
+    {
+        if (cur.pos[c] == cur.end[c])
+            continue;
+        const hub75_trace_event_t *e = &trace_rings[c].events[cur.pos[c] & (TRACE_SIZE - 1)];
+        if (!oldest || (int32_t)(e->time_us - oldest->time_us) < 0)
+        {
+            oldest = e;
+            core = (int)c;
+        }
+    }
+    if (oldest)
+        cur.pos[core]++;
+    return oldest;
+}
+
+/**
+ * @brief Copy the recorded events of both cores, oldest first, merged by time.
+ *
+ * Stop recording with hub75_trace_enable(false) first for a consistent copy.
+ *
+ * @return number of events copied
+ */
+size_t hub75_trace_snapshot(hub75_trace_event_t *out, size_t max)
+{
+    trace_cursor_t cur;
+    trace_cursor_init(cur);
+
+    size_t n = 0;
+    const hub75_trace_event_t *e;
+    while (n < max && (e = trace_cursor_next(cur)))
+        out[n++] = *e;
+    return n;
+}
+
+/**
+ * @brief Print the recorded events for utils/trace2json.py.
+ *
+ * One `core time_us type arg` line per event between `hub75_trace begin` / `hub75_trace end`.
+ * Recording is paused while printing.
+ */
+void hub75_trace_print(void)
+{
+    const bool was_enabled = trace_enabled;
+    trace_enabled = false;
+
+    trace_cursor_t cur;
+    trace_cursor_init(cur);
+
+    printf("hub75_trace begin\n");
+    const hub75_trace_event_t *e;
+    while ((e = trace_cursor_next(cur)))
+        printf("%u %lu %u %u\n", e->core, (unsigned long)e->time_us, e->type, e->arg);
+    printf("hub75_trace end\n");
+
+    trace_enabled = was_enabled;
+}
+#else
+void hub75_trace(uint8_t type, uint16_t arg) {}
+void hub75_trace_enable(bool enable) {}
+size_t hub75_trace_snapshot(hub75_trace_event_t *out, size_t max) { return 0; }
+void hub75_trace_print(void) {}
+#endif
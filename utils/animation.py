@@ -0,0 +1,133 @@
+"""Create a keyframe + delta animation for hub75_anim_play().
+
+Every frame is compared to the previous one tile by tile; only changed tiles are
+stored. A keyframe (full BGR image) is written at the start, every --keyframe-interval
+frames and whenever a delta would not be smaller than a full frame. Mostly static
+content with small moving parts therefore costs a fraction of a full frame per step,
+both in flash and in CPU time on the device.
+
+Frames must have the screen size (HUB75_SCREEN_WIDTH x HUB75_SCREEN_HEIGHT).
+Include the generated header after hub75.hpp.
+
+Usage examples:
+    python utils/animation.py --fps 25 --tile 8x8 -o clock_anim.h frames/*.png
+    python utils/animation.py --fps 10 --tile 64x1 --bgr-header -o rows_anim.h a.h b.h c.h
+"""
+
+import argparse
+import os
+import re
+from sys import stdout
+
+
+def read_bgr_header(path):
+    """Read a BGR byte array as used by update_bgr() (e.g. examples/taylor_swift_64x64.h)."""
+    text = open(path).read()
+    body = text[text.index("{") + 1 : text.rindex("}")]
+    return bytes(int(v, 0) for v in re.findall(r"0x[0-9a-fA-F]+|\d+", body))
+
+
+def read_image(path):
+    from PIL import Image  # only needed for image files
+
+    img = Image.open(path).convert("RGB")
+    bgr = bytearray()
+    for r, g, b in img.getdata():
+        bgr.extend((b, g, r))
+    return img.size, bytes(bgr)
+
+
+def tile_bytes(frame, width, tw, th, tx, ty):
+    return b"".join(frame[((ty * th + j) * width + tx * tw) * 3 : ((ty * th + j) * width + (tx + 1) * tw) * 3] for j in range(th))
+
+
+def encode(frames, width, height, tw, th, keyframe_interval):
+    """Return a list of (type, tile_count, payload) per frame."""
+    tiles_x, tiles_y = width // tw, height // th
+    full_size = width * height * 3
+    out = []
+    prev = None
+    for n, frame in enumerate(frames):
+        if prev is not None and (keyframe_interval == 0 or n % keyframe_interval):
+            payload = bytearray()
+            count = 0
+            for ty in range(tiles_y):
+                for tx in range(tiles_x):
+                    tile = tile_bytes(frame, width, tw, th, tx, ty)
+                    if tile != tile_bytes(prev, width, tw, th, tx, ty):
+                        payload += (ty * tiles_x + tx).to_bytes(2, "little") + tile
+                        count += 1
+            if len(payload) < full_size:
+                out.append(("HUB75_ANIM_DELTA", count, bytes(payload)))
+                prev = frame
+                continue
+        out.append(("HUB75_ANIM_KEYFRAME", 0, frame))
+        prev = frame
+    return out
+
+
+def write_c_header(f, name, width, height, tw, th, encoded, timestamps, duration):
+    total = sum(len(p) for _, _, p in encoded)
+    keyframes = sum(1 for t, _, _ in encoded if t == "HUB75_ANIM_KEYFRAME")
+    f.write(f"// Animation {name}: {len(encoded)} frames ({keyframes} keyframes), {total} bytes pixel data "
+            f"({100.0 * total / (len(encoded) * width * height * 3):.1f} % of raw BGR)\n")
+    f.write("// Generated by utils/animation.py - do not edit manually. Include after hub75.hpp.\n")
+    for n, (_, _, payload) in enumerate(encoded):
+        f.write(f"static const uint8_t {name}_data_{n}[] = {{")
+        for i, v in enumerate(payload):
+            if i % 24 == 0:
+                f.write("\n")
+            f.write("0x%02x, " % v)
+        f.write("\n};\n")
+    f.write(f"\nstatic const hub75_anim_frame_t {name}_frames[] = {{\n")
+    for n, (kind, count, _) in enumerate(encoded):
+        f.write(f"    {{{timestamps[n]}, {kind}, {count}, {name}_data_{n}}},\n")
+    f.write("};\n\n")
+    f.write(f"static const hub75_animation_t {name} = {{{width}, {height}, {tw}, {th}, {duration}, {len(encoded)}, {name}_frames}};\n")
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Create a keyframe + delta animation for hub75_anim_play()")
+    ap.add_argument("frames", nargs="+", help="frame images (Pillow) or, with --bgr-header, BGR C headers")
+    ap.add_argument("--bgr-header", action="store_true", help="frames are C headers with BGR byte arrays")
+    ap.add_argument("--width", type=int, help="screen width, required with --bgr-header unless square")
+    ap.add_argument("--fps", type=float, default=25.0, help="frame rate, frames are evenly spaced")
+    ap.add_argument("--tile", default="8x8", help="delta tile size WxH, e.g. 8x8 or 64x1 for per-row deltas")
+    ap.add_argument("--keyframe-interval", type=int, default=0, help="force a keyframe every N frames (0 = first frame only)")
+    ap.add_argument("-o", "--output", help="output C header (default: stdout)")
+    ap.add_argument("--name", help="C name (default: derived from the output file name)")
+    args = ap.parse_args()
+
+    frames = []
+    size = None
+    for path in args.frames:
+        if args.bgr_header:
+            data = read_bgr_header(path)
+            w = args.width or int((len(data) // 3) ** 0.5)
+            frame_size = (w, len(data) // 3 // w)
+        else:
+            frame_size, data = read_image(path)
+        if size and frame_size != size:
+            ap.error(f"{path}: all frames must have the same size")
+        size = frame_size
+        frames.append(data)
+    width, height = size
+
+    tw, th = (int(v) for v in args.tile.lower().split("x"))
+    if width % tw or height % th:
+        ap.error(f"tile {tw}x{th} does not divide the screen {width}x{height}")
+
+    encoded = encode(frames, width, height, tw, th, args.keyframe_interval)
+    timestamps = [round(n * 1000.0 / args.fps) for n in range(len(frames))]
+    duration = round(len(frames) * 1000.0 / args.fps)
+
+    name = args.name or re.sub(r"\W", "_", os.path.splitext(os.path.basename(args.output or "animation"))[0])
+    if args.output:
+        with open(args.output, "w") as f:
+            write_c_header(f, name, width, height, tw, th, encoded, timestamps, duration)
+    else:
+        write_c_header(stdout, name, width, height, tw, th, encoded, timestamps, duration)
+
+
+if __name__ == "__main__":
+    main()
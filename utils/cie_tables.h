@@ -0,0 +1,54 @@
+// The four CIE table sets of src/cie.hpp side by side, for the host checks in utils/.
+//
+// src/cie.hpp picks one set by SEPARATE_CIE_CHANNELS and BITPLANES. Each namespace below
+// includes it with one combination:
+//
+//   cie_separate_10::CIE_RED / CIE_GREEN / CIE_BLUE   SEPARATE_CIE_CHANNELS true,  BITPLANES 10
+//   cie_separate_8::CIE_RED / CIE_GREEN / CIE_BLUE    SEPARATE_CIE_CHANNELS true,  BITPLANES 8
+//   cie_shared_10::CIE                                SEPARATE_CIE_CHANNELS false, BITPLANES 10
+//   cie_shared_8::CIE                                 SEPARATE_CIE_CHANNELS false, BITPLANES 8
+//
+// Both defines are left undefined afterwards.
+
+#pragma once
+
+#include <cstdint>
+
+#undef SEPARATE_CIE_CHANNELS
+#undef BITPLANES
+
+namespace cie_separate_10
+{
+#define SEPARATE_CIE_CHANNELS true
+#define BITPLANES 10
+#include "../src/cie.hpp"
+#undef SEPARATE_CIE_CHANNELS
+#undef BITPLANES
+} // namespace cie_separate_10
+
+namespace cie_separate_8
+{
+#define SEPARATE_CIE_CHANNELS true
+#define BITPLANES 8
+#include "../src/cie.hpp"
+#undef SEPARATE_CIE_CHANNELS
+#undef BITPLANES
+} // namespace cie_separate_8
+
+namespace cie_shared_10
+{
+#define SEPARATE_CIE_CHANNELS false
+#define BITPLANES 10
+#include "../src/cie.hpp"
+#undef SEPARATE_CIE_CHANNELS
+#undef BITPLANES
+} // namespace cie_shared_10
+
+namespace cie_shared_8
+{
+#define SEPARATE_CIE_CHANNELS false
+#define BITPLANES 8
+#include "../src/cie.hpp"
+#undef SEPARATE_CIE_CHANNELS
+#undef BITPLANES
+} // namespace cie_shared_8
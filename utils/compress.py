@@ -0,0 +1,163 @@
+"""Compress a still image for update_qoi() / update_rle().
+
+Raw BGR arrays as used by update_bgr() cost 3 bytes per pixel in flash
+(12 KB at 64x64). QOI shrinks flat graphics to a few percent and still
+saves a quarter on small photos; the simpler RLE format suits graphics
+with large uniform areas.
+
+The image must already have the screen size (HUB75_SCREEN_WIDTH x HUB75_SCREEN_HEIGHT,
+i.e. after DISPLAY_ROTATION), the decoders write it in row-major screen order.
+
+Usage examples:
+    python utils/compress.py --qoi --bgr-header examples/taylor_swift_64x64.h -o taylor_swift_64x64_qoi.h
+    python utils/compress.py --rle --image logo.png -o logo_rle.h
+"""
+
+import argparse
+import os
+import re
+from sys import stdout
+
+
+def read_bgr_header(path):
+    """Read a BGR byte array as used by update_bgr() (e.g. examples/taylor_swift_64x64.h)."""
+    text = open(path).read()
+    body = text[text.index("{") + 1 : text.rindex("}")]
+    data = [int(v, 0) for v in re.findall(r"0x[0-9a-fA-F]+|\d+", body)]
+    return [(data[k + 2], data[k + 1], data[k]) for k in range(0, len(data) - 2, 3)]
+
+
+def read_image(path):
+    from PIL import Image  # only needed for image files
+
+    img = Image.open(path).convert("RGB")
+    return img.size, list(img.getdata())
+
+
+def encode_qoi(width, height, pixels):
+    """QOI encoder following https://qoiformat.org/qoi-specification.pdf (3 channels)."""
+    out = bytearray(b"qoif")
+    out += width.to_bytes(4, "big") + height.to_bytes(4, "big") + bytes([3, 0])
+
+    index = [(0, 0, 0, 0)] * 64
+    prev = (0, 0, 0, 255)
+    run = 0
+
+    for n, (r, g, b) in enumerate(pixels):
+        px = (r, g, b, 255)
+        if px == prev:
+            run += 1
+            if run == 62 or n == len(pixels) - 1:
+                out.append(0xC0 | (run - 1))
+                run = 0
+            continue
+
+        if run:
+            out.append(0xC0 | (run - 1))
+            run = 0
+
+        h = (r * 3 + g * 5 + b * 7 + 255 * 11) % 64
+        if index[h] == px:
+            out.append(h)
+        else:
+            index[h] = px
+            vr = (r - prev[0] + 128) % 256 - 128
+            vg = (g - prev[1] + 128) % 256 - 128
+            vb = (b - prev[2] + 128) % 256 - 128
+            vg_r, vg_b = vr - vg, vb - vg
+            if -2 <= vr <= 1 and -2 <= vg <= 1 and -2 <= vb <= 1:
+                out.append(0x40 | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2))
+            elif -32 <= vg <= 31 and -8 <= vg_r <= 7 and -8 <= vg_b <= 7:
+                out.append(0x80 | (vg + 32))
+                out.append((vg_r + 8) << 4 | (vg_b + 8))
+            else:
+                out += bytes([0xFE, r, g, b])
+        prev = px
+
+    out += bytes([0, 0, 0, 0, 0, 0, 0, 1])
+    return bytes(out)
+
+
+def encode_rle(pixels):
+    """Packets of 0x80|(n-1) + one BGR pixel (run) or 0x00|(n-1) + n BGR pixels (literals)."""
+    out = bytearray()
+    literals = []
+
+    def flush():
+        while literals:
+            chunk = literals[:128]
+            del literals[:128]
+            out.append(len(chunk) - 1)
+            for r, g, b in chunk:
+                out.extend((b, g, r))
+
+    i = 0
+    while i < len(pixels):
+        n = 1
+        while i + n < len(pixels) and n < 128 and pixels[i + n] == pixels[i]:
+            n += 1
+        if n >= 2:
+            flush()
+            r, g, b = pixels[i]
+            out += bytes([0x80 | (n - 1), b, g, r])
+        else:
+            literals.append(pixels[i])
+        i += n
+    flush()
+    return bytes(out)
+
+
+def write_c_header(f, name, source, fmt, blob, raw_size):
+    f.write('#include "pico.h"\n')
+    f.write(f"// {fmt.upper()} compressed {os.path.basename(source)}: {len(blob)} bytes ({100.0 * len(blob) / raw_size:.1f} % of raw BGR)\n")
+    f.write("// Generated by utils/compress.py - do not edit manually.\n")
+    f.write(f"static const uint8_t {name}[] = {{")
+    for i, v in enumerate(blob):
+        if i % 24 == 0:
+            f.write("\n")
+        f.write("0x%02x, " % v)
+    f.write("\n};\n")
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Compress an image for update_qoi() / update_rle()")
+    fmt = ap.add_mutually_exclusive_group(required=True)
+    fmt.add_argument("--qoi", action="store_true", help="QOI output for update_qoi()")
+    fmt.add_argument("--rle", action="store_true", help="RLE output for update_rle()")
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument("--image", help="image file (requires Pillow)")
+    src.add_argument("--bgr-header", help="C header holding a BGR byte array as used by update_bgr()")
+    ap.add_argument("--width", type=int, help="screen width, required with --bgr-header unless the image is square")
+    ap.add_argument("-o", "--output", help="output file (.h for a C array, anything else for raw binary)")
+    ap.add_argument("--name", help="C array name (default: derived from the output file name)")
+    args = ap.parse_args()
+
+    if args.image:
+        (width, height), pixels = read_image(args.image)
+    else:
+        pixels = read_bgr_header(args.bgr_header)
+        width = args.width or int(len(pixels) ** 0.5)
+        height = len(pixels) // width
+        if width * height != len(pixels):
+            ap.error("cannot derive the image size, pass --width")
+
+    blob = encode_qoi(width, height, pixels) if args.qoi else encode_rle(pixels)
+
+    source = args.image or args.bgr_header
+    if args.output and not args.output.endswith(".h"):
+        with open(args.output, "wb") as f:
+            f.write(blob)
+        return
+
+    stem = os.path.splitext(os.path.basename(args.output or source))[0]
+    name = args.name or re.sub(r"\W", "_", stem)
+    fmt_name = "qoi" if args.qoi else "rle"
+    if args.output:
+        with open(args.output, "w") as f:
+            write_c_header(f, name, source, fmt_name, blob, 3 * len(pixels))
+    else:
+        write_c_header(stdout, name, source, fmt_name, blob, 3 * len(pixels))
+
+
+if __name__ == "__main__":
+    main()
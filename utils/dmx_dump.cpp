@@ -0,0 +1,285 @@
+// Linux stand-in for the device side of the Art-Net / E1.31 (sACN) ingest.
+//
+// Runs the same decoder as the firmware (src/hub75_dmx_decoder.cpp) on recorded UDP
+// packets (a pcap capture from tcpdump, Wireshark or utils/dmx_send.py) or on live UDP
+// ports 6454 and 5568, and writes every presented frame as PPM:
+//
+//   g++ -O2 -Iinclude utils/dmx_dump.cpp src/hub75_dmx_decoder.cpp -o dmx_dump
+//   python utils/dmx_send.py dmx.pcap --protocol sacn --universe 1 --bgr-header examples/taylor_swift_64x64.h
+//   ./dmx_dump dmx.pcap 64 64 -u 1 -o frame_
+//
+//   tcpdump -i eth0 -w console.pcap 'udp port 6454 or udp port 5568'
+//   ./dmx_dump udp 64 64 -u 0 -p 128 -s -o frame_
+//
+// Captures may use Ethernet, Linux cooked (SLL, SLL2) or raw IPv4 link types; IPv4
+// fragments and IPv6 are skipped. Packet timestamps drive the sync timeout.
+//
+// Usage: dmx_dump <capture.pcap|udp> <width> <height> [-u first universe] [-p pixels per universe]
+//                 [-s (serpentine)] [-o ppm prefix]
+//
+// Exit status: 0 ok, 1 bad arguments or input.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "hub75_dmx_decoder.h"
+
+static int width;
+static int height;
+static std::vector<uint8_t> screen; // RGB
+static const char *prefix = nullptr;
+
+// Screen slot = linear pixel index, the decoder's slot table does the universe mapping
+static int slot_of(int x, int y)
+{
+    return y * width + x;
+}
+
+static void sink_write(const uint16_t *slots, int n, const uint8_t *rgb)
+{
+    for (int k = 0; k < n; ++k, rgb += 3)
+    {
+        if (slots[k] != DMX_NO_SLOT)
+            memcpy(&screen[slots[k] * 3], rgb, 3);
+    }
+}
+
+static void sink_present(void)
+{
+    static int frame = 0;
+    if (prefix)
+    {
+        char name[256];
+        snprintf(name, sizeof(name), "%s%04d.ppm", prefix, frame);
+        FILE *f = fopen(name, "wb");
+        if (f)
+        {
+            fprintf(f, "P6\n%d %d\n255\n", width, height);
+            fwrite(screen.data(), 1, screen.size(), f);
+            fclose(f);
+        }
+    }
+    frame++;
+}
+
+static uint32_t rd32(const uint8_t *p, bool swap)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return swap ? __builtin_bswap32(v) : v;
+}
+
+// UDP payload of an IPv4 packet to one of the DMX ports, or nullptr
+static const uint8_t *udp_payload(const uint8_t *ip, size_t len, size_t *payload_len)
+{
+    if (len < 20 || (ip[0] >> 4) != 4 || ip[9] != 17)
+        return nullptr;
+    const size_t ihl = (ip[0] & 0x0f) * 4;
+    const uint32_t frag = (ip[6] << 8) | ip[7];
+    if (frag & 0x3fff) // more fragments or a fragment offset
+        return nullptr;
+    if (len < ihl + 8)
+        return nullptr;
+    const uint8_t *udp = ip + ihl;
+    const uint32_t port = (udp[2] << 8) | udp[3];
+    const size_t udp_len = (udp[4] << 8) | udp[5];
+    if ((port != DMX_ARTNET_PORT && port != DMX_SACN_PORT) || udp_len < 8 || ihl + udp_len > len)
+        return nullptr;
+    *payload_len = udp_len - 8;
+    return udp + 8;
+}
+
+static bool replay_pcap(FILE *f, hub75_dmx_decoder_t *dec)
+{
+    uint8_t hdr[24];
+    if (fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr))
+        return false;
+
+    uint32_t magic;
+    memcpy(&magic, hdr, 4);
+    const bool swap = magic == 0xd4c3b2a1 || magic == 0x4d3cb2a1;
+    const bool nano = magic == 0xa1b23c4d || magic == 0x4d3cb2a1;
+    if (!swap && magic != 0xa1b2c3d4 && !nano)
+    {
+        fprintf(stderr, "not a pcap capture (pcapng is not supported, convert with editcap -F pcap)\n");
+        return false;
+    }
+    const uint32_t linktype = rd32(hdr + 20, swap) & 0xffff;
+
+    std::vector<uint8_t> rec;
+    uint8_t rh[16];
+    while (fread(rh, 1, sizeof(rh), f) == sizeof(rh))
+    {
+        const uint32_t caplen = rd32(rh + 8, swap);
+        rec.resize(caplen);
+        if (fread(rec.data(), 1, caplen, f) != caplen)
+            break;
+        const uint32_t now_ms = rd32(rh, swap) * 1000u + rd32(rh + 4, swap) / (nano ? 1000000u : 1000u);
+
+        size_t off, type_off;
+        switch (linktype)
+        {
+        case 1: // Ethernet
+            off = 14;
+            type_off = 12;
+            if (caplen >= 18 && rec[12] == 0x81 && rec[13] == 0x00) // 802.1Q VLAN tag
+            {
+                off = 18;
+                type_off = 16;
+            }
+            break;
+        case 113: // Linux cooked
+            off = 16;
+            type_off = 14;
+            break;
+        case 276: // Linux cooked v2
+            off = 20;
+            type_off = 0;
+            break;
+        case 101: // raw IP
+        case 228: // raw IPv4
+            off = 0;
+            type_off = SIZE_MAX;
+            break;
+        default:
+            fprintf(stderr, "unsupported link type %u\n", linktype);
+            return false;
+        }
+        if (caplen < off || (type_off != SIZE_MAX && (rec[type_off] != 0x08 || rec[type_off + 1] != 0x00)))
+            continue;
+
+        size_t len;
+        const uint8_t *payload = udp_payload(rec.data() + off, caplen - off, &len);
+        if (payload)
+            hub75_dmx_decoder_feed(dec, payload, len, now_ms);
+    }
+    return true;
+}
+
+static int open_port(uint16_t port)
+{
+    const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    const int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(fd, (sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        perror("bind");
+        exit(EXIT_FAILURE);
+    }
+    return fd;
+}
+
+static void listen_udp(hub75_dmx_decoder_t *dec)
+{
+    pollfd fds[2] = {{open_port(DMX_ARTNET_PORT), POLLIN, 0}, {open_port(DMX_SACN_PORT), POLLIN, 0}};
+
+    // E1.31 multicast group of every universe on the screen
+    for (uint32_t u = 0; u < dec->universes; ++u)
+    {
+        const uint32_t universe = dec->layout.first_universe + u;
+        ip_mreq mreq = {};
+        mreq.imr_multiaddr.s_addr = htonl(0xefff0000u | (universe & 0xffff));
+        mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+        setsockopt(fds[1].fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq));
+    }
+
+    uint8_t buf[2048];
+    while (poll(fds, 2, -1) > 0)
+    {
+        for (pollfd &p : fds)
+        {
+            if (!(p.revents & POLLIN))
+                continue;
+            const ssize_t n = recv(p.fd, buf, sizeof(buf), 0);
+            timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            if (n > 0)
+                hub75_dmx_decoder_feed(dec, buf, (size_t)n, (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000));
+        }
+        const hub75_dmx_stats_t &s = dec->stats;
+        fprintf(stderr, "\rpackets %u dmx %u syncs %u frames %u ignored %u out of order %u errors %u",
+                s.packets, s.dmx, s.syncs, s.frames, s.ignored, s.out_of_order, s.errors);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "usage: %s <capture.pcap|udp> <width> <height> [-u first universe] [-p pixels per universe] "
+                        "[-s] [-o ppm prefix]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    width = atoi(argv[2]);
+    height = atoi(argv[3]);
+    hub75_dmx_layout_t layout = {0, DMX_MAX_PIXELS, false};
+    int opt;
+    optind = 4;
+    while ((opt = getopt(argc, argv, "u:p:so:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'u':
+            layout.first_universe = (uint16_t)atoi(optarg);
+            break;
+        case 'p':
+            layout.pixels_per_universe = (uint16_t)atoi(optarg);
+            break;
+        case 's':
+            layout.serpentine = true;
+            break;
+        case 'o':
+            prefix = optarg;
+            break;
+        default:
+            return EXIT_FAILURE;
+        }
+    }
+    screen.assign(width * height * 3, 0);
+
+    std::vector<uint16_t> slots(hub75_dmx_table_size(&layout, width, height));
+    hub75_dmx_decoder_t dec;
+    const hub75_dmx_sink_t sink = {sink_write, sink_present};
+    if (!hub75_dmx_decoder_init(&dec, &layout, width, height, slots.data(), slot_of, &sink))
+    {
+        fprintf(stderr, "invalid layout: 1..%d pixels per universe, at most %d universes\n", DMX_MAX_PIXELS, DMX_MAX_UNIVERSES);
+        return EXIT_FAILURE;
+    }
+    printf("%d universes %u..%u, %u pixels each\n", dec.universes, layout.first_universe,
+           layout.first_universe + dec.universes - 1, layout.pixels_per_universe);
+
+    if (strcmp(argv[1], "udp") == 0)
+    {
+        listen_udp(&dec);
+        return EXIT_SUCCESS;
+    }
+
+    FILE *f = fopen(argv[1], "rb");
+    if (!f)
+    {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+    const bool ok = replay_pcap(f, &dec);
+    fclose(f);
+
+    const hub75_dmx_stats_t &s = dec.stats;
+    printf("packets %u dmx %u syncs %u frames %u ignored %u out of order %u errors %u\n",
+           s.packets, s.dmx, s.syncs, s.frames, s.ignored, s.out_of_order, s.errors);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,179 @@
+"""Send frames to a HUB75 controller as Art-Net or E1.31 (sACN) DMX universes.
+
+See include/hub75_dmx_decoder.h for the universe layout: pixels are counted row by row
+from the top-left, pixels_per_universe RGB pixels per universe starting at --universe.
+Every frame is followed by an ArtSync / E1.31 sync packet unless --no-sync is given.
+
+The target is the controller's IP address, a broadcast address (Art-Net), "multicast"
+(E1.31, one group per universe), or a .pcap file to record the packets for
+utils/dmx_dump.cpp.
+
+Usage examples:
+    python utils/dmx_send.py 192.168.1.50 --fps 30 --loop frames/*.png
+    python utils/dmx_send.py multicast --protocol sacn --universe 1 --pixels 128 frames/*.png
+    python utils/dmx_send.py dmx.pcap --protocol sacn --universe 1 --bgr-header examples/taylor_swift_64x64.h
+"""
+
+import argparse
+import socket
+import struct
+import time
+import uuid
+
+from stream_send import read_bgr_header, read_image
+
+ARTNET_PORT = 6454
+SACN_PORT = 5568
+ARTNET_ID = b"Art-Net\0"
+E131_ID = b"ASC-E1.17\0\0\0"
+CID = uuid.uuid4().bytes
+
+
+def artdmx(universe, seq, data):
+    if len(data) & 1:
+        data += b"\0"  # ArtDmx lengths are even
+    return ARTNET_ID + struct.pack("<H", 0x5000) + struct.pack(">HBBBBH", 14, seq, 0, universe & 0xFF, (universe >> 8) & 0x7F, len(data)) + data
+
+
+def artsync():
+    return ARTNET_ID + struct.pack("<H", 0x5200) + struct.pack(">HBB", 14, 0, 0)
+
+
+def e131_data(universe, seq, data, sync_address):
+    n = len(data)
+    pkt = bytearray(126 + n)
+    struct.pack_into(">HH12s", pkt, 0, 0x0010, 0, E131_ID)
+    struct.pack_into(">HI16s", pkt, 16, 0x7000 | (110 + n), 4, CID)
+    struct.pack_into(">HI64sBHBBH", pkt, 38, 0x7000 | (88 + n), 2, b"hub75 dmx_send", 100, sync_address, seq, 0, universe)
+    struct.pack_into(">HBBHHH", pkt, 115, 0x7000 | (11 + n), 2, 0xA1, 0, 1, n + 1)
+    pkt[126:] = data
+    return bytes(pkt)
+
+
+def e131_sync(seq, sync_address):
+    pkt = bytearray(49)
+    struct.pack_into(">HH12s", pkt, 0, 0x0010, 0, E131_ID)
+    struct.pack_into(">HI16s", pkt, 16, 0x7000 | 33, 8, CID)
+    struct.pack_into(">HIBHH", pkt, 38, 0x7000 | 11, 1, seq, sync_address, 0)
+    return bytes(pkt)
+
+
+def universes(frame, width, height, pixels, serpentine):
+    """Split a BGR frame into RGB channel data per universe."""
+    rgb = bytearray()
+    for y in range(height):
+        xs = range(width - 1, -1, -1) if serpentine and y & 1 else range(width)
+        for x in xs:
+            b, g, r = frame[(y * width + x) * 3 : (y * width + x) * 3 + 3]
+            rgb += bytes((r, g, b))
+    step = pixels * 3
+    return [bytes(rgb[i : i + step]) for i in range(0, len(rgb), step)]
+
+
+class PcapWriter:
+    """Raw IPv4 capture (link type 101) of the UDP packets."""
+
+    def __init__(self, path):
+        self.f = open(path, "wb")
+        self.f.write(struct.pack("<IHHiIII", 0xA1B2C3D4, 2, 4, 0, 0, 65535, 101))
+        self.t = 0.0
+
+    def send(self, payload, addr, port):
+        udp = struct.pack(">HHHH", port, port, 8 + len(payload), 0) + payload
+        ip = struct.pack(">BBHHHBBH4s4s", 0x45, 0, 20 + len(udp), 0, 0, 64, 17, 0, socket.inet_aton("10.0.0.1"), socket.inet_aton(addr))
+        csum = sum(struct.unpack(">10H", ip))
+        csum = (csum & 0xFFFF) + (csum >> 16)
+        ip = ip[:10] + struct.pack(">H", ~((csum & 0xFFFF) + (csum >> 16)) & 0xFFFF) + ip[12:]
+        sec = int(self.t)
+        self.f.write(struct.pack("<IIII", sec, int((self.t - sec) * 1e6), len(ip) + len(udp), len(ip) + len(udp)) + ip + udp)
+
+    def close(self):
+        self.f.close()
+
+
+class UdpSender:
+    def __init__(self):
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.setsockopt(socket.SOL_SOCKET, socket.SO_BROADCAST, 1)
+        self.sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_TTL, 4)
+
+    def send(self, payload, addr, port):
+        self.sock.sendto(payload, (addr, port))
+
+    def close(self):
+        self.sock.close()
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Send frames as Art-Net or E1.31 DMX universes")
+    ap.add_argument("target", help='controller IP address, broadcast address, "multicast" (E1.31) or a .pcap file')
+    ap.add_argument("frames", nargs="+", help="frame images (Pillow) or, with --bgr-header, BGR C headers")
+    ap.add_argument("--bgr-header", action="store_true", help="frames are C headers with BGR byte arrays")
+    ap.add_argument("--width", type=int, help="screen width, required with --bgr-header unless square")
+    ap.add_argument("--protocol", choices=["artnet", "sacn"], default="artnet")
+    ap.add_argument("--universe", type=int, default=0, help="universe of the top-left pixel")
+    ap.add_argument("--pixels", type=int, default=170, help="RGB pixels per universe, at most 170")
+    ap.add_argument("--serpentine", action="store_true", help="every second row runs right to left")
+    ap.add_argument("--no-sync", action="store_true", help="no ArtSync / E1.31 sync packets")
+    ap.add_argument("--fps", type=float, default=0, help="frame rate, 0 = as fast as possible (25 fps in a capture)")
+    ap.add_argument("--loop", action="store_true", help="repeat the frame sequence until interrupted")
+    args = ap.parse_args()
+
+    frames = []
+    for path in args.frames:
+        if args.bgr_header:
+            data = read_bgr_header(path)
+            width = args.width or int((len(data) // 3) ** 0.5)
+            size = (width, len(data) // 3 // width)
+        else:
+            size, data = read_image(path)
+        frames.append(data)
+    width, height = size
+
+    pcap = args.target.endswith(".pcap")
+    out = PcapWriter(args.target) if pcap else UdpSender()
+    sacn = args.protocol == "sacn"
+    port = SACN_PORT if sacn else ARTNET_PORT
+    sync_address = 0 if args.no_sync else args.universe
+    seq = {}
+    sync_seq = 0
+    sent = 0
+    start = time.monotonic()
+
+    def dest(universe):
+        if args.target == "multicast" or (pcap and sacn):
+            return "239.255.%d.%d" % (universe >> 8, universe & 0xFF)
+        return "10.0.0.2" if pcap else args.target
+
+    try:
+        while True:
+            for n, frame in enumerate(frames):
+                for u, data in enumerate(universes(frame, width, height, args.pixels, args.serpentine)):
+                    universe = args.universe + u
+                    s = seq.get(universe, 0) % 255 + 1  # Art-Net: 0 disables the sequence check
+                    seq[universe] = s
+                    pkt = e131_data(universe, s, data, sync_address) if sacn else artdmx(universe, s, data)
+                    out.send(pkt, dest(universe), port)
+                    sent += 1
+                if not args.no_sync:
+                    sync_seq = (sync_seq + 1) & 0xFF
+                    out.send(e131_sync(sync_seq, sync_address) if sacn else artsync(), dest(sync_address), port)
+                    sent += 1
+                if pcap:
+                    out.t += 1 / (args.fps or 25)
+                elif args.fps:
+                    delay = start + (n + 1) / args.fps - time.monotonic()
+                    if delay > 0:
+                        time.sleep(delay)
+            if not args.loop:
+                break
+            start = time.monotonic()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        out.close()
+    print(f"sent {sent} packets")
+
+
+if __name__ == "__main__":
+    main()
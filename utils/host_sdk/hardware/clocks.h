@@ -0,0 +1,10 @@
+#pragma once
+
+#include "pico.h"
+
+enum clock_index
+{
+    clk_sys = 5
+};
+
+static inline uint32_t clock_get_hz(enum clock_index clk_index) { return 150000000u; }
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "pico.h"
+#include "hardware/irq.h"
+
+enum dma_channel_transfer_size
+{
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2
+};
+
+#define DREQ_FORCE 63
+
+typedef struct
+{
+    uint32_t ctrl;
+} dma_channel_config;
+
+typedef struct
+{
+    volatile uint32_t read_addr, write_addr, transfer_count, ctrl_trig;
+} dma_channel_hw_t;
+
+typedef struct
+{
+    dma_channel_hw_t ch[16];
+} dma_hw_t;
+
+static dma_hw_t host_dma;
+#define dma_hw (&host_dma)
+
+static inline int dma_claim_unused_channel(bool required)
+{
+    static int next;
+    return next++;
+}
+
+static inline dma_channel_config dma_channel_get_default_config(uint channel) { return {0}; }
+static inline dma_channel_config dma_get_channel_config(uint channel) { return {0}; }
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {}
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool incr) {}
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool incr) {}
+static inline void channel_config_set_dreq(dma_channel_config *c, uint dreq) {}
+static inline void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {}
+static inline void channel_config_set_high_priority(dma_channel_config *c, bool high_priority) {}
+static inline uint32_t dma_encode_transfer_count(uint32_t count) { return count; }
+
+static inline void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                                         const volatile void *read_addr, uint32_t transfer_count, bool trigger) {}
+static inline void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger) {}
+static inline void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger) {}
+static inline void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger) {}
+static inline void dma_channel_start(uint channel) {}
+static inline void dma_start_channel_mask(uint32_t chan_mask) {}
+static inline void dma_channel_wait_for_finish_blocking(uint channel) {}
+
+static inline bool dma_channel_get_irq0_status(uint channel) { return false; }
+static inline void dma_channel_acknowledge_irq0(uint channel) {}
+static inline void dma_channel_acknowledge_irq1(uint channel) {}
+static inline void dma_channel_set_irq0_enabled(uint channel, bool enabled) {}
+static inline void dma_channel_set_irq1_enabled(uint channel, bool enabled) {}
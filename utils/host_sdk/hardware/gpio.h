@@ -0,0 +1,15 @@
+#pragma once
+
+#include "pico.h"
+
+#define GPIO_OUT 1
+#define GPIO_IN 0
+
+static inline void gpio_init(uint gpio) {}
+static inline void gpio_set_dir(uint gpio, bool out) {}
+static inline void gpio_put(uint gpio, bool value) {}
+static inline void gpio_pull_down(uint gpio) {}
+static inline void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled) {}
+static inline void gpio_add_raw_irq_handler(uint gpio, void (*handler)(void)) {}
+static inline uint32_t gpio_get_irq_event_mask(uint gpio) { return 0; }
+static inline void gpio_acknowledge_irq(uint gpio, uint32_t event_mask) {}
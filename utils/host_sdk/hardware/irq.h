@@ -0,0 +1,11 @@
+#pragma once
+
+#include "pico.h"
+
+typedef void (*irq_handler_t)(void);
+
+#define DMA_IRQ_0 10
+#define DMA_IRQ_1 11
+
+static inline void irq_set_exclusive_handler(uint num, irq_handler_t handler) {}
+static inline void irq_set_enabled(uint num, bool enabled) {}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "pico.h"
+#include "hardware/clocks.h"
+
+typedef struct
+{
+    volatile uint32_t ctrl, fstat, fdebug, flevel;
+    volatile uint32_t txf[4];
+    volatile uint32_t rxf[4];
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+static pio_hw_t host_pio[3];
+#define pio0 (&host_pio[0])
+#define pio1 (&host_pio[1])
+#define pio2 (&host_pio[2])
+
+#define PIO_FDEBUG_TXSTALL_LSB 24
+#define PIO_FDEBUG_TXOVER_LSB 16
+
+typedef struct
+{
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+
+static inline uint pio_add_program(PIO pio, const pio_program_t *program) { return 0; }
+static inline int pio_claim_unused_sm(PIO pio, bool required) { return 1; }
+static inline bool pio_claim_free_sm_and_add_program(const pio_program_t *program, PIO *pio, uint *sm, uint *offset)
+{
+    *pio = pio1;
+    *sm = 0;
+    *offset = 0;
+    return true;
+}
+static inline bool pio_claim_free_sm_and_add_program_for_gpio_range(const pio_program_t *program, PIO *pio, uint *sm,
+                                                                    uint *offset, uint gpio_base, uint gpio_count,
+                                                                    bool set_gpio_base)
+{
+    *pio = pio0;
+    *sm = 0;
+    *offset = 0;
+    return true;
+}
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx) { return 0; }
+static inline void pio_sm_set_clkdiv(PIO pio, uint sm, float div) {}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "pico.h"
+
+typedef struct
+{
+    volatile uint32_t csr, rvr, cvr, calib;
+} systick_hw_t;
+
+static systick_hw_t host_systick;
+#define systick_hw (&host_systick)
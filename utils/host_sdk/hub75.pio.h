@@ -0,0 +1,16 @@
+// The programs of src/hub75.pio that src/hub75.cpp loads, without instructions.
+
+#pragma once
+
+#include "hardware/pio.h"
+
+static const pio_program_t hub75_row_program = {0, 0, -1};
+static const pio_program_t hub75_bitplane_stream_program = {0, 0, -1};
+static const pio_program_t hub75_bitplane_setup_program = {0, 0, -1};
+
+static inline void hub75_row_program_init(PIO pio, uint sm, uint offset, uint row_base_pin, uint n_row_pins,
+                                          uint latch_base_pin, uint t_latch, bool inverted_stb) {}
+static inline void hub75_bitplane_stream_program_init(PIO pio, uint sm, uint offset, uint rgb_base_pin,
+                                                      uint clock_pin, uint panel_width) {}
+static inline void hub75_bitplane_setup_program_init(PIO pio, uint sm, uint offset) {}
+static inline void hub75_bitplane_setup_set_shift(PIO pio, uint sm, uint offset, uint shamt) {}
@@ -0,0 +1,35 @@
+// No-op stand-ins for the Pico SDK, enough to compile src/hub75.cpp and src/hub75_trace.cpp on a
+// Linux host for the checks in utils/ that exercise the driver's own mapping and decoding code.
+//
+// Nothing here touches hardware: DMA channels, PIO state machines, GPIOs and IRQs are accepted and
+// ignored, the register blocks the driver reads (dma_hw, pio FIFOs, systick_hw) are plain structs,
+// and time_us_32() is the host's monotonic clock. hub75_init() therefore sets up the frame buffers
+// and tables but never refreshes a panel.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef unsigned int uint;
+
+#define NUM_CORES 2u
+
+#define __not_in_flash(group)
+#define __not_in_flash_func(func) func
+#define __time_critical_func(func) func
+#define __isr
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+static inline void panic(const char *fmt, ...)
+{
+    fprintf(stderr, "panic: %s\n", fmt);
+    abort();
+}
+
+static inline void tight_loop_contents() {}
+static inline void __dmb() {}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "pico.h"
+
+typedef struct
+{
+    volatile uint32_t lock;
+} spin_lock_t;
+
+static inline spin_lock_t *spin_lock_instance(uint lock_num)
+{
+    static spin_lock_t locks[32];
+    return &locks[lock_num];
+}
+static inline int spin_lock_claim_unused(bool required) { return 0; }
+static inline uint32_t spin_lock_blocking(spin_lock_t *lock) { return 0; }
+static inline void spin_unlock(spin_lock_t *lock, uint32_t saved_irq) {}
+
+static inline uint32_t save_and_disable_interrupts() { return 0; }
+static inline void restore_interrupts(uint32_t status) {}
+
+static inline uint get_core_num() { return 0; }
+static inline void __sev() {}
+static inline void __wfe() {}
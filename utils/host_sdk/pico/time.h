@@ -0,0 +1,14 @@
+#pragma once
+
+#include <time.h>
+
+#include "pico.h"
+
+static inline uint64_t time_us_64()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static inline uint32_t time_us_32() { return (uint32_t)time_us_64(); }
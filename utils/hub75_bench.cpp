@@ -0,0 +1,237 @@
+// Refresh-rate benchmark matrix for the HUB75 driver, simulated on a Linux host.
+//
+// Computes the refresh table of README.md (system clock x basis brightness x 8/10
+// bitplanes, 64x64 panel, 1/32 scan) by running src/hub75.pio cycle by cycle with
+// utils/hub75_emu.h and compares it with a checked-in baseline. A change to
+// hub75.pio, hub75_build_row_cmd_buffer() or a BCM sequence that lowers a refresh
+// rate by more than the tolerance makes the benchmark fail.
+//
+//   g++ -O2 -std=c++17 -o hub75_bench utils/hub75_bench.cpp
+//   ./hub75_bench                                        # compare with utils/hub75_bench_baseline.txt
+//   ./hub75_bench --tolerance 0.5 --markdown             # README table format
+//   ./hub75_bench --write-baseline utils/hub75_bench_baseline.txt
+//
+// Run from the repository root or pass --pio <path> and --baseline <path>.
+// Exit status: 0 ok, 1 regression or failed emulator checks, 2 usage / file errors.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <tuple>
+
+#include "hub75_emu.h"
+
+struct bench_point_t
+{
+    double clk_mhz;
+    uint32_t basis;
+    double readme_10; ///< hand-measured with FRAME_RATE=true, README.md
+    double readme_8;
+};
+
+/// Rows of the refresh table in README.md
+static const bench_point_t bench_points[] = {
+    {100, 8, 271, 519},  {150, 8, 398, 762},  {200, 8, 519, 993},   {250, 8, 634, 1216},  {266, 1, 1009, 1285},
+    {266, 2, 1009, 1285}, {266, 4, 951, 1285}, {266, 8, 670, 1285},  {266, 16, 412, 1121}, {266, 32, 230, 751},
+    {266, 64, 121, 441},  {266, 128, 62, 239}, {266, 255, 31, 124},
+};
+
+using bench_key_t = std::tuple<int, uint32_t, int>; // clk in kHz, basis, bitplanes
+
+struct bench_result_t
+{
+    uint64_t cycles; ///< system clocks per frame
+    double hz;
+};
+
+static bench_key_t key_of(double clk_mhz, uint32_t basis, int bitplanes)
+{
+    return bench_key_t((int)lround(clk_mhz * 1000.0), basis, bitplanes);
+}
+
+static bool read_baseline(const char *path, std::map<bench_key_t, bench_result_t> &out)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return false;
+    char line[256];
+    while (fgets(line, sizeof(line), f))
+    {
+        double clk, hz;
+        unsigned basis;
+        int bitplanes;
+        unsigned long long cycles;
+        if (line[0] == '#' || sscanf(line, "%lf %u %d %llu %lf", &clk, &basis, &bitplanes, &cycles, &hz) != 5)
+            continue;
+        // compare with the exact rate, the file holds it rounded
+        out[key_of(clk, basis, bitplanes)] = {(uint64_t)cycles, cycles ? clk * 1e6 / (double)cycles : hz};
+    }
+    fclose(f);
+    return true;
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --pio FILE              PIO source (default src/hub75.pio)\n"
+            "  --baseline FILE         baseline to compare with (default utils/hub75_bench_baseline.txt)\n"
+            "  --write-baseline FILE   write the computed matrix as new baseline\n"
+            "  --tolerance PCT         allowed refresh rate drop in percent (0.5)\n"
+            "  --frames N              measured frames per point (1)\n"
+            "  --markdown              print the matrix in the format of the README table\n",
+            argv0);
+}
+
+int main(int argc, char **argv)
+{
+    const char *pio_file = "src/hub75.pio";
+    const char *baseline_file = "utils/hub75_bench_baseline.txt";
+    const char *write_file = nullptr;
+    double tolerance = 0.5;
+    int frames = 1;
+    bool markdown = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *a = argv[i];
+        const bool has_arg = i + 1 < argc;
+        if (!strcmp(a, "--pio") && has_arg)
+            pio_file = argv[++i];
+        else if (!strcmp(a, "--baseline") && has_arg)
+            baseline_file = argv[++i];
+        else if (!strcmp(a, "--write-baseline") && has_arg)
+            write_file = argv[++i];
+        else if (!strcmp(a, "--tolerance") && has_arg)
+            tolerance = atof(argv[++i]);
+        else if (!strcmp(a, "--frames") && has_arg)
+            frames = atoi(argv[++i]);
+        else if (!strcmp(a, "--markdown"))
+            markdown = true;
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::map<bench_key_t, bench_result_t> baseline;
+    const bool have_baseline = !write_file && read_baseline(baseline_file, baseline);
+    if (!write_file && !have_baseline)
+        fprintf(stderr, "no baseline %s, only computing the matrix\n", baseline_file);
+
+    std::map<bench_key_t, bench_result_t> results;
+    int regressions = 0, improvements = 0, failures = 0;
+
+    if (!markdown)
+        printf("%8s %6s %4s %12s %10s %10s %10s  %s\n", "clk MHz", "basis", "bp", "cycles", "Hz", "baseline", "change", "README");
+
+    for (const bench_point_t &p : bench_points)
+    {
+        for (int bitplanes : {10, 8})
+        {
+            hub75_emu_config_t cfg;
+            cfg.pio_file = pio_file;
+            cfg.clk_sys_mhz = p.clk_mhz;
+            cfg.basis = p.basis;
+            cfg.bitplanes = bitplanes;
+            cfg.frames = frames;
+
+            hub75_emu_result_t r;
+            try
+            {
+                r = hub75_emu_run(cfg);
+            }
+            catch (const std::exception &e)
+            {
+                fprintf(stderr, "%.0f MHz basis %u %d bitplanes: %s\n", p.clk_mhz, p.basis, bitplanes, e.what());
+                return 2;
+            }
+
+            hub75_emu_minmax_t period;
+            for (uint64_t c : r.frame_cycles)
+                period.add(c);
+            const bench_key_t key = key_of(p.clk_mhz, p.basis, bitplanes);
+            const bench_result_t res = {(uint64_t)llround(period.avg()), p.clk_mhz * 1e6 / period.avg()};
+            results[key] = res;
+
+            if (r.row_data_mismatch || r.row_addr_mismatch || r.addr_change_while_on || r.latch_while_on || r.clock_while_latch)
+            {
+                fprintf(stderr, "%.0f MHz basis %u %d bitplanes: emulator checks failed\n", p.clk_mhz, p.basis, bitplanes);
+                failures++;
+            }
+
+            if (markdown)
+                continue;
+
+            const double readme = bitplanes == 10 ? p.readme_10 : p.readme_8;
+            printf("%8.0f %6u %4d %12llu %10.1f", p.clk_mhz, p.basis, bitplanes, (unsigned long long)res.cycles, res.hz);
+
+            const char *flag = "";
+            auto b = baseline.find(key);
+            if (b == baseline.end())
+            {
+                printf(" %10s %10s ", "-", "");
+            }
+            else
+            {
+                const double change = 100.0 * (res.hz - b->second.hz) / b->second.hz;
+                if (change < -tolerance)
+                {
+                    flag = "  REGRESSION";
+                    regressions++;
+                }
+                else if (change > tolerance)
+                {
+                    flag = "  improved";
+                    improvements++;
+                }
+                printf(" %10.1f %+9.2f%%", b->second.hz, change);
+            }
+            printf("  ~%.0f%s\n", readme, flag);
+        }
+    }
+
+    if (markdown)
+    {
+        printf("| System Clock | Basis Brightness | Refresh Rate for 10 Bitplanes |  Refresh Rate for 8 Bitplanes |\n");
+        printf("|--------------|------------------|-------------------------------|-------------------------------|\n");
+        for (const bench_point_t &p : bench_points)
+        {
+            char r10[32], r8[32];
+            snprintf(r10, sizeof(r10), "~%.0f Hz", results[key_of(p.clk_mhz, p.basis, 10)].hz);
+            snprintf(r8, sizeof(r8), "~%.0f Hz", results[key_of(p.clk_mhz, p.basis, 8)].hz);
+            printf("| %3.0f MHz      | %-16u | %-29s | %-29s |\n", p.clk_mhz, p.basis, r10, r8);
+        }
+    }
+
+    if (write_file)
+    {
+        FILE *f = fopen(write_file, "w");
+        if (!f)
+        {
+            perror(write_file);
+            return 2;
+        }
+        fprintf(f, "# Refresh-rate baseline written by utils/hub75_bench.cpp - 64x64 panel, 1/32 scan,\n");
+        fprintf(f, "# balanced BCM, default BASE_LATCH_NS / BASE_ADDR_NS, SM_CLOCKDIV_FACTOR 1.\n");
+        fprintf(f, "# clk_mhz basis bitplanes cycles_per_frame refresh_hz\n");
+        for (const bench_point_t &p : bench_points)
+            for (int bitplanes : {10, 8})
+            {
+                const bench_result_t &res = results[key_of(p.clk_mhz, p.basis, bitplanes)];
+                fprintf(f, "%.0f %u %d %llu %.1f\n", p.clk_mhz, p.basis, bitplanes, (unsigned long long)res.cycles, res.hz);
+            }
+        fclose(f);
+        printf("baseline written to %s\n", write_file);
+    }
+
+    if (have_baseline && !markdown)
+        printf("\n%d regressions, %d improvements beyond %.2f %%\n", regressions, improvements, tolerance);
+    if (failures)
+        printf("%d points failed the emulator checks\n", failures);
+
+    return regressions || failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
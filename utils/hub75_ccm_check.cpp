@@ -0,0 +1,137 @@
+// Checks the fixed-point colour correction matrix (src/hub75_ccm.hpp) on a Linux host.
+//
+// Builds the partial-product tables for a set of matrices - identity, the CCM_*_SHIFT
+// equivalent, calibration-style matrices with negative terms, clamping extremes and random
+// ones - over every CIE table variant of src/cie.hpp, and compares ccm_pack() with a float
+// reference: out = clamp(round(sum of m[o][s] * cie_s[v]), 0, max). Fixed matrices are
+// checked for every 24-bit colour, random ones for a sample.
+//
+//   g++ -O2 -std=c++17 -o hub75_ccm_check utils/hub75_ccm_check.cpp
+//   ./hub75_ccm_check
+//
+// Exit status: 0 ok (no channel off by more than 1), 1 mismatch.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "../src/hub75_ccm.hpp"
+#include "cie_tables.h"
+
+struct cie_set_t
+{
+    const char *name;
+    const uint16_t *red, *green, *blue;
+    int32_t max;
+};
+
+struct matrix_t
+{
+    const char *name;
+    float m[3][3];
+};
+
+static const matrix_t matrices[] = {
+    {"identity", {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}},
+    {"CCM_RG_SHIFT 6, CCM_GB_SHIFT 7", {{1, 1 / 64.0f, 0}, {0, 1, 1 / 128.0f}, {0, 0, 1}}},
+    {"calibrated, subtracts bleed", {{1.12f, -0.08f, -0.03f}, {-0.05f, 0.97f, -0.06f}, {0.01f, -0.04f, 1.05f}}},
+    {"white point only", {{0.92f, 0, 0}, {0, 1, 0}, {0, 0, 0.85f}}},
+    {"extremes, clamps", {{1.99f, -2.0f, 0.5f}, {-1.5f, 1.99f, -1.0f}, {0.25f, 1.5f, -2.0f}}},
+};
+
+// hub75_ccm_from_float() of src/hub75.cpp
+static void to_fixed(const float f[3][3], int16_t m[3][3])
+{
+    for (int o = 0; o < 3; ++o)
+        for (int s = 0; s < 3; ++s)
+        {
+            float q = roundf(f[o][s] * (1 << CCM_COEF_BITS));
+            m[o][s] = (int16_t)(q < INT16_MIN ? INT16_MIN : (q > INT16_MAX ? INT16_MAX : q));
+        }
+}
+
+static ccm_table_t table;
+
+// Maximum deviation from the float reference over the colours produced by next(); fills exact with the exact share
+template <typename Next>
+static int check_matrix(const cie_set_t &cie, const float f[3][3], Next next, double &exact)
+{
+    int16_t m[3][3];
+    to_fixed(f, m);
+    ccm_build_tables(table, m, cie.red, cie.green, cie.blue);
+
+    int worst = 0;
+    uint64_t count = 0, hits = 0;
+    uint32_t colour;
+    while (next(colour))
+    {
+        const uint32_t r = (colour >> 16) & 0xFF, g = (colour >> 8) & 0xFF, b = colour & 0xFF;
+        const uint32_t packed = ccm_pack(table[0][r], table[1][g], table[2][b], cie.max);
+        const float in[3] = {(float)cie.red[r], (float)cie.green[g], (float)cie.blue[b]};
+
+        for (int o = 0; o < 3; ++o)
+        {
+            const double ref = (double)f[o][0] * in[0] + (double)f[o][1] * in[1] + (double)f[o][2] * in[2];
+            const long want = std::lround(ref < 0 ? 0 : (ref > cie.max ? cie.max : ref));
+            const long got = (packed >> (10 * o)) & 0x3FF;
+            const int err = (int)std::labs(got - want);
+            if (err > worst)
+                worst = err;
+            hits += err == 0;
+            ++count;
+        }
+    }
+    exact = count ? 100.0 * hits / count : 100.0;
+    return worst;
+}
+
+int main()
+{
+    const cie_set_t sets[] = {
+        {"separate, 10 bitplanes", cie_separate_10::CIE_RED, cie_separate_10::CIE_GREEN, cie_separate_10::CIE_BLUE, 1023},
+        {"separate, 8 bitplanes", cie_separate_8::CIE_RED, cie_separate_8::CIE_GREEN, cie_separate_8::CIE_BLUE, 255},
+        {"shared, 10 bitplanes", cie_shared_10::CIE, cie_shared_10::CIE, cie_shared_10::CIE, 1023},
+        {"shared, 8 bitplanes", cie_shared_8::CIE, cie_shared_8::CIE, cie_shared_8::CIE, 255},
+    };
+
+    int failed = 0;
+    std::mt19937 rng(75);
+    std::uniform_real_distribution<float> diag(0.5f, 1.5f), cross(-0.3f, 0.3f);
+
+    for (const cie_set_t &cie : sets)
+    {
+        printf("%s\n", cie.name);
+
+        for (const matrix_t &mat : matrices)
+        {
+            uint32_t c = 0;
+            double exact;
+            const int worst = check_matrix(cie, mat.m, [&](uint32_t &colour) { colour = c; return c++ < (1u << 24); }, exact);
+            printf("  %-32s max error %d, %.2f %% exact %s\n", mat.name, worst, exact, worst > 1 ? "FAILED" : "ok");
+            failed |= worst > 1;
+        }
+
+        int worst_random = 0;
+        double exact_min = 100.0;
+        for (int i = 0; i < 200; ++i)
+        {
+            float f[3][3];
+            for (int o = 0; o < 3; ++o)
+                for (int s = 0; s < 3; ++s)
+                    f[o][s] = o == s ? diag(rng) : cross(rng);
+
+            uint32_t n = 0;
+            double exact;
+            const int worst = check_matrix(cie, f, [&](uint32_t &colour) { colour = rng() & 0xFFFFFF; return n++ < 20000; }, exact);
+            if (worst > worst_random)
+                worst_random = worst;
+            if (exact < exact_min)
+                exact_min = exact;
+        }
+        printf("  %-32s max error %d, >= %.2f %% exact %s\n", "200 random matrices", worst_random, exact_min,
+               worst_random > 1 ? "FAILED" : "ok");
+        failed |= worst_random > 1;
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
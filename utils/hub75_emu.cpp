@@ -0,0 +1,247 @@
+// Cycle-counting emulation of the HUB75 PIO programs and DMA chains on a Linux host.
+//
+// Assembles src/hub75.pio, runs hub75_row and hub75_bitplane_stream (and optionally
+// hub75_bitplane_setup) against a model of the driver's DMA channels and reports refresh
+// rate, OE-on time per bitplane, latch/address settle windows and FIFO starvation.
+// Changes to hub75.pio delays, BASE_LATCH_NS / BASE_ADDR_NS or BCM sequences can be
+// evaluated before anyone flashes a board.
+//
+//   g++ -O2 -std=c++17 -o hub75_emu utils/hub75_emu.cpp
+//   ./hub75_emu                                  # 64x64, 1/32 scan, 10 bitplanes, 266 MHz
+//   ./hub75_emu --clk 150 --basis 8 --bitplanes 8
+//   ./hub75_emu --sequence 9,0,8,1,9,2,7,3,9,4,8,5,9,6 --latch-ns 120
+//   ./hub75_emu --build --bus-busy 0.3           # bitplane builds and bus load competing
+//   ./hub75_emu --width 64 --height 32 --rowsel-pins 4 --bitplanes 8 --refresh-hz 1920   # refresh lock
+//   ./hub75_emu --list                           # assembled programs
+//
+// Run from the repository root or pass --pio <path>.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "hub75_emu.h"
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --pio FILE          PIO source (default src/hub75.pio)\n"
+            "  --width N --height N            single panel size (64 x 64)\n"
+            "  --chain-rows N --chain-cols N   panel chain (1 x 1)\n"
+            "  --rowsel-pins N     address lines, ROWSEL_N_PINS (5)\n"
+            "  --bitplanes 8|10    (10)\n"
+            "  --unbalanced        BALANCED_LIGHT_OUTPUT=false\n"
+            "  --sequence LIST     custom BCM sequence, e.g. 9,0,8,1,9,2,7,3,9,4,8,5,9,6\n"
+            "  --basis N           setBasisBrightness() (6)\n"
+            "  --brightness F      setIntensity(F, false), 0..1 (1)\n"
+            "  --refresh-hz F      hub75_set_refresh_rate(F), pad the frames to F Hz (off)\n"
+            "  --clk MHZ           system clock (266)\n"
+            "  --clkdiv F          SM_CLOCKDIV_FACTOR (1)\n"
+            "  --latch-ns N        BASE_LATCH_NS (80)\n"
+            "  --addr-ns N         BASE_ADDR_NS (160)\n"
+            "  --frames N          measured frames (3)\n"
+            "  --build             rebuild the bitplanes continuously (hub75_bitplane_setup)\n"
+            "  --irq-latency N     system clocks until an IRQ handler acts (60)\n"
+            "  --dma-latency N     system clocks until a DMA transfer lands (4)\n"
+            "  --bus-busy F        fraction of cycles the DMA loses the bus (0)\n"
+            "  --list              print the assembled programs and exit\n",
+            argv0);
+}
+
+static void print_minmax(const char *name, const hub75_emu_minmax_t &m, double ns_per_cycle)
+{
+    if (!m.n)
+    {
+        printf("  %-34s -\n", name);
+        return;
+    }
+    printf("  %-34s min %6llu  max %6llu cycles  (%.1f .. %.1f ns)\n", name, (unsigned long long)m.min, (unsigned long long)m.max,
+           m.min * ns_per_cycle, m.max * ns_per_cycle);
+}
+
+int main(int argc, char **argv)
+{
+    hub75_emu_config_t cfg;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *a = argv[i];
+        auto next = [&]() -> const char * {
+            if (i + 1 >= argc)
+            {
+                usage(argv[0]);
+                exit(EXIT_FAILURE);
+            }
+            return argv[++i];
+        };
+        if (!strcmp(a, "--pio"))
+            cfg.pio_file = next();
+        else if (!strcmp(a, "--width"))
+            cfg.panel_width = atoi(next());
+        else if (!strcmp(a, "--height"))
+            cfg.panel_height = atoi(next());
+        else if (!strcmp(a, "--chain-rows"))
+            cfg.chain_rows = atoi(next());
+        else if (!strcmp(a, "--chain-cols"))
+            cfg.chain_cols = atoi(next());
+        else if (!strcmp(a, "--rowsel-pins"))
+            cfg.rowsel_pins = atoi(next());
+        else if (!strcmp(a, "--bitplanes"))
+            cfg.bitplanes = atoi(next());
+        else if (!strcmp(a, "--unbalanced"))
+            cfg.balanced = false;
+        else if (!strcmp(a, "--sequence"))
+        {
+            cfg.bcm_sequence.clear();
+            for (char *tok = strtok(const_cast<char *>(next()), ","); tok; tok = strtok(nullptr, ","))
+                cfg.bcm_sequence.push_back(atoi(tok));
+        }
+        else if (!strcmp(a, "--basis"))
+            cfg.basis = (uint32_t)atoi(next());
+        else if (!strcmp(a, "--brightness"))
+            cfg.brightness = atof(next());
+        else if (!strcmp(a, "--refresh-hz"))
+            cfg.refresh_hz = atof(next());
+        else if (!strcmp(a, "--clk"))
+            cfg.clk_sys_mhz = atof(next());
+        else if (!strcmp(a, "--clkdiv"))
+            cfg.clkdiv = atof(next());
+        else if (!strcmp(a, "--latch-ns"))
+            cfg.latch_ns = (uint32_t)atoi(next());
+        else if (!strcmp(a, "--addr-ns"))
+            cfg.addr_ns = (uint32_t)atoi(next());
+        else if (!strcmp(a, "--frames"))
+            cfg.frames = atoi(next());
+        else if (!strcmp(a, "--build"))
+            cfg.build = true;
+        else if (!strcmp(a, "--irq-latency"))
+            cfg.irq_latency = atoi(next());
+        else if (!strcmp(a, "--dma-latency"))
+            cfg.dma_latency = atoi(next());
+        else if (!strcmp(a, "--bus-busy"))
+            cfg.bus_busy = atof(next());
+        else if (!strcmp(a, "--list"))
+            list = true;
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (cfg.bitplanes != 8 && cfg.bitplanes != 10)
+    {
+        fprintf(stderr, "bitplanes must be 8 or 10\n");
+        return EXIT_FAILURE;
+    }
+    if (cfg.basis < 1)
+        cfg.basis = 1;
+    if (cfg.frames < 1)
+        cfg.frames = 1;
+
+    try
+    {
+        if (list)
+        {
+            for (const auto &p : pio_assemble_file(cfg.pio_file))
+            {
+                const pio_program_t &prog = p.second;
+                printf("%s: %zu instructions, wrap_target %d, wrap %d, side-set bits %d%s\n", prog.name.c_str(), prog.code.size(),
+                       prog.wrap_target, prog.wrap, prog.sideset_bits, prog.sideset_opt ? " (opt)" : "");
+                for (size_t k = 0; k < prog.code.size(); ++k)
+                    printf("  %2zu: 0x%04x\n", k, prog.code[k]);
+            }
+            return EXIT_SUCCESS;
+        }
+
+        const hub75_emu_result_t r = hub75_emu_run(cfg);
+        const double clk_hz = cfg.clk_sys_mhz * 1e6;
+        const double ns = 1e9 / clk_hz;
+
+        printf("Panel %dx%d, chain %dx%d, 1/%d scan, %d bytes per row\n", cfg.panel_width, cfg.panel_height, cfg.chain_rows, cfg.chain_cols,
+               r.scan_depth, r.stream_length);
+        printf("BCM sequence");
+        for (int bp : r.bcm_sequence)
+            printf(" %d", bp);
+        printf(" (%zu slices), basis %u, brightness %.3f\n", r.bcm_sequence.size(), cfg.basis, cfg.brightness);
+        printf("clk_sys %.1f MHz, clkdiv %.2f, latch %u ns = %u cycles, addr %u ns = %u cycles\n\n", cfg.clk_sys_mhz, cfg.clkdiv, cfg.latch_ns,
+               r.latch_cycles, cfg.addr_ns, r.addr_cycles);
+
+        hub75_emu_minmax_t period;
+        for (uint64_t c : r.frame_cycles)
+            period.add(c);
+        printf("Refresh rate over %zu frames: min %.1f Hz  avg %.1f Hz  max %.1f Hz  (%.0f cycles per frame)\n", r.frame_cycles.size(),
+               clk_hz / period.max, clk_hz / period.avg(), clk_hz / period.min, period.avg());
+
+        // The driver's cycle model must predict the emulated frame exactly (fractional dividers: on average)
+        const double clkdiv = cfg.clkdiv < 1.0 ? 1.0 : cfg.clkdiv;
+        const double predicted = (double)(r.locked ? r.lock_cycles : r.natural_cycles) * clkdiv;
+        const bool model_error = fabs(period.avg() - predicted) > clkdiv;
+        if (cfg.refresh_hz > 0.0)
+        {
+            if (r.locked)
+                printf("Refresh lock %.3f Hz: padded %llu -> %llu PIO cycles, %.3f Hz\n", cfg.refresh_hz,
+                       (unsigned long long)r.natural_cycles, (unsigned long long)r.lock_cycles, clk_hz / predicted);
+            else
+                printf("Refresh lock %.3f Hz: not reached, the frame takes %llu PIO cycles (%.1f Hz)\n", cfg.refresh_hz,
+                       (unsigned long long)r.natural_cycles, clk_hz / predicted);
+        }
+        printf("Driver frame model: %.0f cycles per frame%s\n\n", predicted, model_error ? " - MISMATCH" : "");
+
+        printf("Per bitplane and frame, averaged over rows:\n");
+        printf("  bp   lit cmd   OE on cycles      OE on ns   weight (ideal)   waiting for shift\n");
+        const double on0 = r.oe_on_cycles[0];
+        for (size_t bp = 0; bp < r.oe_on_cycles.size(); ++bp)
+        {
+            const double on = r.oe_on_cycles[bp];
+            printf("  %2zu  %8.0f  %13.1f  %12.1f  %7.2f (%4u)  %10.1f cycles\n", bp, r.lit_cmd_cycles[bp], on, on * ns, on0 > 0 ? on / on0 : 0.0,
+                   1u << bp, r.shift_bound_cycles[bp]);
+        }
+
+        printf("\nRow timing windows:\n");
+        print_minmax("latch pulse (STB high)", r.latch_pulse, ns);
+        print_minmax("OE off -> latch", r.blank_to_latch, ns);
+        print_minmax("latch -> address change", r.latch_to_addr, ns);
+        print_minmax("address settle (address -> OE on)", r.addr_settle, ns);
+        print_minmax("row shift (first -> last CLK)", r.row_shift, ns);
+
+        printf("\nFIFO starvation:\n");
+        printf("  hub75_bitplane_stream: %llu stalls, %llu cycles on an empty TX FIFO\n", (unsigned long long)r.stream_starved_events,
+               (unsigned long long)r.stream_starved_cycles);
+        printf("  hub75_row:             %llu stalls, %llu cycles on an empty TX FIFO\n", (unsigned long long)r.row_starved_events,
+               (unsigned long long)r.row_starved_cycles);
+        printf("  frames with TXSTALL (driver telemetry): stream %llu, row %llu of %zu\n", (unsigned long long)r.stream_starved_frames,
+               (unsigned long long)r.row_starved_frames, r.frame_cycles.size());
+        if (cfg.bus_busy > 0.0)
+            printf("  DMA lost the bus on %llu cycles\n", (unsigned long long)r.dma_bus_busy_cycles);
+
+        if (cfg.build)
+        {
+            printf("\nBitplane build:\n");
+            print_minmax("slice", r.slice_build, ns);
+            print_minmax("frame_buffer", r.frame_build, ns);
+            print_minmax("write_chan done after read_chan", r.drain, ns);
+            printf("  %llu frames built, %llu bytes differ from the reference, write_chan busy on restart %llu times\n",
+                   (unsigned long long)r.frames_built, (unsigned long long)r.build_mismatch, (unsigned long long)r.write_chan_busy);
+        }
+
+        const uint64_t errors = r.row_data_mismatch + r.row_addr_mismatch + r.addr_change_while_on + r.latch_while_on + r.clock_while_latch +
+                                r.build_mismatch + r.write_chan_busy + model_error;
+        printf("\nChecks over %llu rows: data %llu, address %llu, address change with OE on %llu, latch with OE on %llu, CLK during latch %llu\n",
+               (unsigned long long)r.rows_checked, (unsigned long long)r.row_data_mismatch, (unsigned long long)r.row_addr_mismatch,
+               (unsigned long long)r.addr_change_while_on, (unsigned long long)r.latch_while_on, (unsigned long long)r.clock_while_latch);
+        if (r.row_data_torn)
+            printf("  %llu of the data mismatches were rows of the back buffer while the next build overwrote it\n",
+                   (unsigned long long)r.row_data_torn);
+        printf("%s\n", errors ? "FAILED" : "OK");
+        return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+    catch (const std::exception &e)
+    {
+        fprintf(stderr, "%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,610 @@
+// Host model of the HUB75 display pipeline, built on utils/pio_emu.h.
+//
+// Mirrors the device setup: hub75_row and hub75_bitplane_stream on one PIO block
+// (sharing IRQ flags 0/1), row_chan/pixel_chan fed by their control channels, the row
+// command buffer of hub75_build_row_cmd_buffer() and, optionally, the bitplane builder
+// (hub75_bitplane_setup with read_chan/write_chan and read_chan_handler()).
+//
+// Pins are observed every system clock; the result holds refresh periods, OE-on time per
+// bitplane, latch/address timing windows, FIFO starvation and consistency checks.
+
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+#include "pio_emu.h"
+
+struct hub75_emu_config_t
+{
+    std::string pio_file = "src/hub75.pio";
+
+    // Panel (as MATRIX_PANEL_WIDTH, MATRIX_PANEL_HEIGHT, CHAIN_ROWS, CHAIN_COLS, ROWSEL_N_PINS)
+    int panel_width = 64;
+    int panel_height = 64;
+    int chain_rows = 1;
+    int chain_cols = 1;
+    int rowsel_pins = 5;
+
+    // BCM
+    int bitplanes = 10;
+    bool balanced = true;
+    std::vector<int> bcm_sequence; ///< empty: the driver's sequence for bitplanes/balanced
+    uint32_t basis = 6;            ///< setBasisBrightness()
+    double brightness = 1.0;       ///< setIntensity(brightness, false)
+    double refresh_hz = 0.0;       ///< hub75_set_refresh_rate(), 0 = no lock
+
+    // Clocks and timing (as set_sys_clock_khz(), SM_CLOCKDIV_FACTOR, BASE_LATCH_NS, BASE_ADDR_NS)
+    double clk_sys_mhz = 266.0;
+    double clkdiv = 1.0;
+    uint32_t latch_ns = 80;
+    uint32_t addr_ns = 160;
+
+    // Simulation
+    int frames = 3;        ///< measured frames, after one start-up frame
+    bool build = false;    ///< rebuild the bitplanes continuously, competing for the DMA
+    int irq_latency = 60;  ///< system clocks from a DMA completion to the handler's register writes
+    int dma_latency = 4;   ///< system clocks from issuing a DMA transfer until it lands
+    double bus_busy = 0.0; ///< fraction of cycles the DMA loses the bus to other masters
+};
+
+struct hub75_emu_minmax_t
+{
+    uint64_t min = UINT64_MAX;
+    uint64_t max = 0;
+    uint64_t sum = 0;
+    uint64_t n = 0;
+
+    void add(uint64_t v)
+    {
+        min = std::min(min, v);
+        max = std::max(max, v);
+        sum += v;
+        n++;
+    }
+    double avg() const { return n ? (double)sum / n : 0.0; }
+};
+
+struct hub75_emu_result_t
+{
+    // Derived configuration
+    std::vector<int> bcm_sequence;
+    int scan_depth = 0;
+    int stream_length = 0;  ///< bytes shifted per row (BITPLANE_STREAM_LENGTH)
+    uint32_t latch_cycles = 0;
+    uint32_t addr_cycles = 0;
+    std::vector<uint32_t> lit_cycles; ///< per slice, as in the row command buffer
+    uint64_t natural_cycles = 0;      ///< PIO cycles per frame without padding, as computed by the driver
+    uint64_t lock_cycles = 0;         ///< PIO cycles per frame the refresh lock pads to, 0 = no lock
+    bool locked = false;              ///< natural_cycles <= lock_cycles, the row commands are padded
+    uint64_t cycles = 0;              ///< system clocks simulated
+
+    // Refresh, in system clocks
+    std::vector<uint64_t> frame_cycles;
+
+    // Per bitplane and frame, summed over slices, averaged over rows (system clocks)
+    std::vector<double> oe_on_cycles;
+    std::vector<double> lit_cmd_cycles; ///< lit_cycles from the command buffer
+    std::vector<double> shift_bound_cycles; ///< hub75_row waiting for hub75_bitplane_stream
+
+    // Row timing windows, in system clocks
+    hub75_emu_minmax_t latch_pulse;    ///< STB high
+    hub75_emu_minmax_t blank_to_latch; ///< OE off → STB rising
+    hub75_emu_minmax_t latch_to_addr;  ///< STB falling → address change
+    hub75_emu_minmax_t addr_settle;    ///< address change → OE on
+    hub75_emu_minmax_t row_shift;      ///< first → last CLK rising edge of a row
+
+    // FIFO starvation (system clocks stalled on an empty TX FIFO, and stall events)
+    uint64_t stream_starved_cycles = 0, stream_starved_events = 0;
+    uint64_t row_starved_cycles = 0, row_starved_events = 0;
+    uint64_t stream_starved_frames = 0, row_starved_frames = 0; ///< as counted by the driver from FDEBUG TXSTALL
+    uint64_t dma_bus_busy_cycles = 0;
+
+    // Consistency checks
+    uint64_t rows_checked = 0;
+    uint64_t row_data_mismatch = 0;  ///< shifted pixels differ from the frame buffer
+    uint64_t row_data_torn = 0;      ///< ... of which the buffer was being rebuilt while scanned out
+    uint64_t row_addr_mismatch = 0;  ///< wrong row address while OE is on
+    uint64_t addr_change_while_on = 0;
+    uint64_t latch_while_on = 0;
+    uint64_t clock_while_latch = 0;
+
+    // Bitplane build (config.build)
+    hub75_emu_minmax_t slice_build;    ///< read_chan trigger → write_chan done, per slice
+    hub75_emu_minmax_t frame_build;    ///< whole frame_buffer
+    hub75_emu_minmax_t drain;          ///< read_chan done → write_chan done
+    uint64_t frames_built = 0;
+    uint64_t build_mismatch = 0;       ///< bytes differing from the reference extraction
+    uint64_t write_chan_busy = 0;      ///< read_chan_handler() reprogrammed a busy write_chan
+};
+
+/// BCM sequences of src/hub75.cpp
+inline std::vector<int> hub75_emu_default_sequence(int bitplanes, bool balanced)
+{
+    if (bitplanes == 10)
+        return balanced ? std::vector<int>{9, 0, 8, 1, 9, 2, 7, 3, 9, 4, 8, 5, 9, 6} : std::vector<int>{0, 9, 2, 7, 4, 5, 1, 8, 3, 6};
+    return balanced ? std::vector<int>{7, 0, 6, 1, 7, 2, 5, 3, 7, 4, 6} : std::vector<int>{0, 7, 2, 5, 1, 6, 3, 4};
+}
+
+// ns_to_pio_cycles() of src/hub75.cpp, same float arithmetic
+inline uint32_t hub75_emu_ns_to_cycles(uint32_t ns, float clk_sys_hz, float clkdiv)
+{
+    float t_cycle_ns = (clkdiv / clk_sys_hz) * 1e9f;
+    return (uint32_t)ceilf(ns / t_cycle_ns);
+}
+
+/**
+ * @brief Run the display pipeline cycle by cycle.
+ *
+ * Throws std::runtime_error if the .pio source cannot be assembled or the display stalls.
+ */
+inline hub75_emu_result_t hub75_emu_run(const hub75_emu_config_t &cfg)
+{
+    hub75_emu_result_t res;
+
+    const auto programs = pio_assemble_file(cfg.pio_file);
+    auto program = [&](const char *name) -> const pio_program_t & {
+        auto it = programs.find(name);
+        if (it == programs.end())
+            throw std::runtime_error(cfg.pio_file + ": program " + name + " not found");
+        return it->second;
+    };
+    const pio_program_t &row_prog = program("hub75_row");
+    const pio_program_t &stream_prog = program("hub75_bitplane_stream");
+    const pio_program_t &setup_prog = program("hub75_bitplane_setup");
+    auto shift_label = setup_prog.labels.find("shift");
+    if (shift_label == setup_prog.labels.end())
+        throw std::runtime_error("hub75_bitplane_setup: label 'shift' not found");
+    const int shift_offset = shift_label->second;
+
+    // --- Geometry (PanelConfig) ---
+    const std::vector<int> seq = cfg.bcm_sequence.empty() ? hub75_emu_default_sequence(cfg.bitplanes, cfg.balanced) : cfg.bcm_sequence;
+    const int slices = (int)seq.size();
+    const int scan_depth = 1 << cfg.rowsel_pins;
+    const int rows_in_parallel = cfg.panel_height / scan_depth;
+    if (rows_in_parallel < 1)
+        throw std::runtime_error("ROWSEL_N_PINS too large for the panel height");
+    const int total_pixels = cfg.panel_width * cfg.panel_height * cfg.chain_rows * cfg.chain_cols;
+    const int stream_length = ((cfg.panel_width * cfg.chain_rows * cfg.chain_cols) >> 1) * rows_in_parallel;
+    const int slice_bytes = total_pixels >> 1;
+    const int total_cmds = slices * scan_depth;
+
+    res.bcm_sequence = seq;
+    res.scan_depth = scan_depth;
+    res.stream_length = stream_length;
+
+    // --- Timing (hub75_timing_init) ---
+    const float clk_hz = (float)(cfg.clk_sys_mhz * 1e6);
+    const float clkdiv = cfg.clkdiv < 1.0 ? 1.0f : (float)cfg.clkdiv;
+    res.latch_cycles = hub75_emu_ns_to_cycles(cfg.latch_ns, clk_hz, clkdiv);
+    res.addr_cycles = hub75_emu_ns_to_cycles(cfg.addr_ns, clk_hz, clkdiv);
+
+    // --- Row command buffer (hub75_build_row_cmd_buffer) ---
+    const uint32_t brightness_fp = cfg.brightness <= 0.0 ? 0u : cfg.brightness >= 1.0 ? 65536u : (uint32_t)(cfg.brightness * 65536.0 + 0.5);
+    std::vector<uint32_t> row_cmds;
+    for (int bp : seq)
+    {
+        const uint32_t split_factor = (uint32_t)std::count(seq.begin(), seq.end(), bp);
+        const uint32_t base_per_slice = (cfg.basis << bp) / split_factor;
+        const uint32_t lit = (uint32_t)(((uint64_t)base_per_slice * brightness_fp) >> 16);
+        const uint32_t dark = base_per_slice - lit;
+        res.lit_cycles.push_back(lit);
+        for (int row = 0; row < scan_depth; ++row)
+        {
+            const uint32_t t_addr = res.addr_cycles + (bp >> 1);
+            row_cmds.push_back((t_addr << 5) | ((uint32_t)row & (uint32_t)(scan_depth - 1) & 0x1fu));
+            row_cmds.push_back(lit);
+            row_cmds.push_back(dark);
+        }
+    }
+
+    // --- Refresh lock (hub75_set_refresh_rate, fill_row_cmds) ---
+    const uint32_t shift_cycles = 9u * (uint32_t)stream_length + 3u;
+    auto shift_wait = [&](uint32_t t_addr, uint32_t period) {
+        const uint32_t display = t_addr + period + 8u;
+        return shift_cycles > display ? shift_cycles - display : 0u;
+    };
+    const size_t n_cmds = row_cmds.size() / 3;
+    for (size_t idx = 0; idx < n_cmds; ++idx)
+    {
+        const uint32_t t_addr = row_cmds[3 * idx] >> 5, period = row_cmds[3 * idx + 1] + row_cmds[3 * idx + 2];
+        res.natural_cycles += 2u * res.latch_cycles + 16u + t_addr + period + shift_wait(t_addr, period);
+    }
+    if (cfg.refresh_hz > 0.0)
+    {
+        res.lock_cycles = (uint64_t)((double)clk_hz / ((double)clkdiv * cfg.refresh_hz) + 0.5);
+        res.locked = res.natural_cycles <= res.lock_cycles;
+    }
+    if (res.locked)
+    {
+        const uint64_t padding = res.lock_cycles - res.natural_cycles;
+        for (size_t idx = 0; idx < n_cmds; ++idx)
+        {
+            const uint32_t t_addr = row_cmds[3 * idx] >> 5, period = row_cmds[3 * idx + 1] + row_cmds[3 * idx + 2];
+            row_cmds[3 * idx + 2] += shift_wait(t_addr, period) + (uint32_t)((idx + 1) * padding / n_cmds - idx * padding / n_cmds);
+        }
+    }
+
+    // --- Pixel data ---
+    uint32_t lcg = 12345u;
+    auto rnd = [&lcg]() {
+        lcg = lcg * 1664525u + 1013904223u;
+        return lcg >> 8;
+    };
+    std::vector<uint32_t> rgb_buffer(total_pixels);
+    for (auto &w : rgb_buffer)
+        w = rnd() & 0x3fffffffu;
+    std::vector<uint8_t> frame_buffers[2];
+    for (auto &fb : frame_buffers)
+    {
+        fb.resize((size_t)slice_bytes * slices);
+        for (auto &b : fb)
+            b = (uint8_t)(rnd() & 0x3fu);
+    }
+    const uint8_t *dma_buffer = frame_buffers[0].data();
+    uint8_t *frame_buffer = frame_buffers[1].data();
+    const uint8_t *dma_row_cmd_buffer = reinterpret_cast<const uint8_t *>(row_cmds.data());
+
+    // Reference extraction of one slice (what hub75_bitplane_setup must produce)
+    std::vector<uint8_t> reference((size_t)slice_bytes * slices);
+    for (int s = 0; s < slices; ++s)
+        for (int p = 0; p < slice_bytes; ++p)
+        {
+            const uint32_t w0 = rgb_buffer[2 * p], w1 = rgb_buffer[2 * p + 1];
+            const int sh = seq[s];
+            reference[(size_t)s * slice_bytes + p] = (uint8_t)(((w0 >> sh) & 1) | (((w0 >> (10 + sh)) & 1) << 1) | (((w0 >> (20 + sh)) & 1) << 2) |
+                                                                (((w1 >> sh) & 1) << 3) | (((w1 >> (10 + sh)) & 1) << 4) | (((w1 >> (20 + sh)) & 1) << 5));
+        }
+
+    // --- PIO (configure_pio) ---
+    pio_block_t pio;      // data_pio: stream on SM0, row on SM1
+    pio_block_t pio_read; // hub75_bitplane_setup
+    pio_sm_t &stream = pio.sm[0];
+    pio_sm_t &row = pio.sm[1];
+    pio_sm_t &setup = pio_read.sm[0];
+
+    stream.load(stream_prog);
+    stream.out_count = 6;
+    stream.autopull = true;
+    stream.pull_threshold = 8;
+    stream.join_tx();
+    stream.y = (uint32_t)stream_length - 1;
+    stream.set_clkdiv(clkdiv);
+    stream.enabled = true;
+
+    row.load(row_prog);
+    row.out_count = cfg.rowsel_pins;
+    row.autopull = true;
+    row.pull_threshold = 32;
+    row.y = res.latch_cycles;
+    row.set_clkdiv(clkdiv);
+    row.side_pins = 0b10;
+    row.enabled = true;
+
+    auto set_shift = [&](int shamt) {
+        setup.code[shift_offset] = shamt == 0 ? emu_encode_pull(false, true) : emu_encode_out_null((uint32_t)shamt);
+    };
+    setup.load(setup_prog);
+    setup.autopull = true;
+    setup.autopush = true;
+    set_shift(seq[0]);
+    setup.enabled = cfg.build;
+
+    // --- DMA (setup_dma_transfers, setup_bitplane_creation) ---
+    enum
+    {
+        ROW_CHAN,
+        ROW_CTRL_CHAN,
+        PIXEL_CHAN,
+        PIXEL_CTRL_CHAN,
+        READ_CHAN,
+        WRITE_CHAN,
+        N_CHAN
+    };
+    dma_t dma(N_CHAN);
+    dma.latency = cfg.dma_latency;
+    uint32_t bus_lcg = 777u;
+    const uint32_t bus_threshold = (uint32_t)(cfg.bus_busy * 65536.0);
+    if (cfg.bus_busy > 0.0)
+        dma.bus_busy = [&bus_lcg, bus_threshold]() {
+            bus_lcg = bus_lcg * 1103515245u + 12345u;
+            return ((bus_lcg >> 8) & 0xffffu) < bus_threshold;
+        };
+
+    // Deferred IRQ handlers
+    std::deque<std::pair<uint64_t, std::function<void()>>> irqs;
+    auto raise = [&](std::function<void()> fn) { irqs.emplace_back(dma.now + (uint64_t)cfg.irq_latency, std::move(fn)); };
+
+    dma_channel_t &row_chan = dma.ch[ROW_CHAN];
+    row_chan.data_size = 4;
+    row_chan.read_addr = dma_row_cmd_buffer;
+    row_chan.write_fifo = &row.tx;
+    row_chan.trans_count = (uint32_t)row_cmds.size();
+    row_chan.chain_to = ROW_CTRL_CHAN;
+
+    dma_channel_t &row_ctrl_chan = dma.ch[ROW_CTRL_CHAN];
+    row_ctrl_chan.data_size = sizeof(void *);
+    row_ctrl_chan.read_addr = reinterpret_cast<const uint8_t *>(&dma_row_cmd_buffer);
+    row_ctrl_chan.read_increment = false;
+    row_ctrl_chan.write_addr = reinterpret_cast<uint8_t *>(&row_chan.read_addr);
+    row_ctrl_chan.write_increment = false;
+    row_ctrl_chan.trans_count = 1;
+    row_ctrl_chan.chain_to = ROW_CHAN;
+
+    dma_channel_t &pixel_chan = dma.ch[PIXEL_CHAN];
+    pixel_chan.data_size = 1;
+    pixel_chan.read_addr = dma_buffer;
+    pixel_chan.write_fifo = &stream.tx;
+    pixel_chan.trans_count = (uint32_t)slice_bytes * slices;
+    pixel_chan.chain_to = PIXEL_CTRL_CHAN;
+
+    // Frame buffer each pixel frame was streamed from, consumed by the row data check
+    std::deque<const uint8_t *> streamed_frames{dma_buffer};
+
+    dma_channel_t &pixel_ctrl_chan = dma.ch[PIXEL_CTRL_CHAN];
+    pixel_ctrl_chan.data_size = sizeof(void *);
+    pixel_ctrl_chan.read_addr = reinterpret_cast<const uint8_t *>(&dma_buffer);
+    pixel_ctrl_chan.read_increment = false;
+    pixel_ctrl_chan.write_addr = reinterpret_cast<uint8_t *>(&pixel_chan.read_addr);
+    pixel_ctrl_chan.write_increment = false;
+    pixel_ctrl_chan.trans_count = 1;
+    pixel_ctrl_chan.chain_to = PIXEL_CHAN;
+
+    dma_channel_t &read_chan = dma.ch[READ_CHAN];
+    read_chan.data_size = 4;
+    read_chan.write_fifo = &setup.tx;
+    read_chan.trans_count = (uint32_t)total_pixels;
+
+    dma_channel_t &write_chan = dma.ch[WRITE_CHAN];
+    write_chan.data_size = 4;
+    write_chan.read_fifo = &setup.rx;
+    write_chan.trans_count = (uint32_t)total_pixels / 8;
+
+    // --- Bitplane builder (start_bitplane_build, read_chan_handler) ---
+    int bitplane = 0;
+    int write_slice = 0;
+    bool swap_frame_buffer_pending = false;
+    uint64_t slice_start = 0, build_start = 0, read_done = 0;
+
+    auto start_slice = [&](int slice) {
+        if (write_chan.busy)
+            res.write_chan_busy++;
+        write_chan.write_addr = frame_buffer + (size_t)slice * slice_bytes;
+        read_chan.read_addr = reinterpret_cast<const uint8_t *>(rgb_buffer.data());
+        write_slice = slice;
+        slice_start = dma.now;
+        dma.start(READ_CHAN);
+        dma.start(WRITE_CHAN);
+    };
+    auto start_build = [&]() {
+        build_start = dma.now;
+        bitplane = 0;
+        start_slice(0);
+    };
+
+    read_chan.on_complete = [&]() {
+        read_done = dma.now;
+        raise([&]() {
+            if (++bitplane < slices)
+            {
+                set_shift(seq[bitplane]);
+                start_slice(bitplane);
+            }
+            else
+            {
+                bitplane = 0;
+                set_shift(seq[0]);
+                swap_frame_buffer_pending = true;
+            }
+        });
+    };
+    write_chan.on_complete = [&]() {
+        res.slice_build.add(dma.now - slice_start);
+        res.drain.add(dma.now - read_done);
+        if (write_slice == slices - 1)
+        {
+            res.frame_build.add(dma.now - build_start);
+            res.frames_built++;
+            for (size_t k = 0; k < reference.size(); ++k)
+                res.build_mismatch += frame_buffer[k] != reference[k];
+        }
+    };
+    pixel_ctrl_chan.on_complete = [&]() {
+        streamed_frames.push_back(pixel_chan.read_addr);
+        raise([&]() {
+            if (swap_frame_buffer_pending)
+            {
+                uint8_t *new_front = frame_buffer;
+                frame_buffer = const_cast<uint8_t *>(dma_buffer);
+                dma_buffer = new_front;
+                swap_frame_buffer_pending = false;
+                start_build();
+            }
+        });
+    };
+
+    // --- Run (start_hub75_driver) ---
+    dma.start(ROW_CHAN);
+    dma.start(PIXEL_CHAN);
+    if (cfg.build)
+        start_build();
+
+    // Observed pin state
+    bool oe_on = false, stb = false, clk = false;
+    uint32_t addr = 0;
+    uint64_t oe_events = 0, latch_events = 0;
+    uint64_t t_oe_on = 0, t_oe_off = 0, t_stb_rise = 0, t_stb_fall = 0, t_addr = 0, t_first_clk = 0, t_last_clk = 0;
+    int cur_slice = 0;
+    bool have_row = false;
+    std::vector<uint8_t> shifted;
+    shifted.reserve(stream_length);
+    const uint8_t *cur_frame = nullptr;
+
+    int frame = -1; // index of the frame being displayed, -1 before the first
+    uint64_t frame_start = 0;
+    bool measuring = false;
+    std::vector<uint64_t> oe_on_slice(slices), wait_slice(slices);
+    pio_stall_t stream_prev = STALL_NONE, row_prev = STALL_NONE;
+    bool stream_stalled_in_frame = false, row_stalled_in_frame = false;
+
+    // Generous limit: every row at its slowest plus shifting, a few times over
+    uint64_t estimate = 0;
+    for (int s = 0; s < slices; ++s)
+        estimate += (uint64_t)scan_depth * (res.lit_cycles[s] + row_cmds[3 * s * scan_depth + 2] + res.addr_cycles + 2 * res.latch_cycles + 12 * stream_length + 200);
+    const uint64_t limit = (uint64_t)(estimate * clkdiv) * (cfg.frames + 2) * 4 + 100000;
+
+    for (uint64_t now = 1; frame <= cfg.frames; ++now)
+    {
+        if (now > limit)
+            throw std::runtime_error("display stalled - no frame completed within the expected time");
+
+        dma.tick();
+        pio.tick();
+        pio_read.tick();
+        while (!irqs.empty() && irqs.front().first <= now)
+        {
+            auto fn = std::move(irqs.front().second);
+            irqs.pop_front();
+            fn();
+        }
+
+        // --- Observe pins ---
+        const bool n_oe_on = !(row.side_pins & 2u);
+        const bool n_stb = row.side_pins & 1u;
+        const uint32_t n_addr = row.out_pins;
+        const bool n_clk = stream.side_pins & 1u;
+
+        if (n_addr != addr)
+        {
+            if (measuring)
+            {
+                if (n_oe_on)
+                    res.addr_change_while_on++;
+                res.latch_to_addr.add(now - t_stb_fall);
+            }
+            t_addr = now;
+        }
+
+        if (n_clk && !clk)
+        {
+            if (n_stb && measuring)
+                res.clock_while_latch++;
+            if (shifted.empty())
+                t_first_clk = now;
+            t_last_clk = now;
+            if ((int)shifted.size() < stream_length)
+                shifted.push_back((uint8_t)(stream.out_pins & 0x3fu));
+        }
+
+        if (n_stb && !stb)
+        {
+            const uint64_t cmd = latch_events++ % (uint64_t)total_cmds;
+            if (cmd == 0)
+            {
+                cur_frame = streamed_frames.front();
+                streamed_frames.pop_front();
+            }
+            if (measuring)
+            {
+                if (n_oe_on)
+                    res.latch_while_on++;
+                if (oe_events)
+                    res.blank_to_latch.add(now - t_oe_off);
+                res.row_shift.add(t_last_clk - t_first_clk);
+                res.rows_checked++;
+                const uint8_t *expect = cur_frame + cmd * (uint64_t)stream_length;
+                if ((int)shifted.size() != stream_length || memcmp(shifted.data(), expect, stream_length) != 0)
+                {
+                    res.row_data_mismatch++;
+                    // pixel_ctrl_chan reloads dma_buffer before the swap in its IRQ, so the
+                    // new back buffer is streamed once more while the next build fills it
+                    if (cur_frame == frame_buffer)
+                        res.row_data_torn++;
+                }
+            }
+            shifted.clear();
+            t_stb_rise = now;
+        }
+        if (!n_stb && stb)
+        {
+            if (measuring)
+                res.latch_pulse.add(now - t_stb_rise);
+            t_stb_fall = now;
+        }
+
+        if (n_oe_on && !oe_on)
+        {
+            const uint64_t cmd = oe_events++ % (uint64_t)total_cmds;
+            if (cmd == 0)
+            {
+                if (measuring)
+                {
+                    res.frame_cycles.push_back(now - frame_start);
+                    res.stream_starved_frames += stream_stalled_in_frame;
+                    res.row_starved_frames += row_stalled_in_frame;
+                }
+                stream_stalled_in_frame = row_stalled_in_frame = false;
+                frame++;
+                frame_start = now;
+                measuring = frame >= 1 && frame <= cfg.frames;
+            }
+            cur_slice = (int)(cmd / (uint64_t)scan_depth);
+            have_row = true;
+            if (measuring)
+            {
+                res.addr_settle.add(now - t_addr);
+                if (n_addr != (uint32_t)(cmd % (uint64_t)scan_depth))
+                    res.row_addr_mismatch++;
+            }
+            t_oe_on = now;
+        }
+        if (!n_oe_on && oe_on)
+        {
+            if (measuring)
+                oe_on_slice[cur_slice] += now - t_oe_on;
+            t_oe_off = now;
+        }
+
+        oe_on = n_oe_on;
+        stb = n_stb;
+        addr = n_addr;
+        clk = n_clk;
+
+        // --- Stalls ---
+        if (measuring)
+        {
+            if (row.stalled == STALL_WAIT_IRQ && have_row)
+                wait_slice[cur_slice]++;
+            if (stream.stalled == STALL_TX_EMPTY)
+            {
+                res.stream_starved_cycles++;
+                res.stream_starved_events += stream_prev != STALL_TX_EMPTY;
+                stream_stalled_in_frame = true;
+            }
+            if (row.stalled == STALL_TX_EMPTY)
+            {
+                res.row_starved_cycles++;
+                res.row_starved_events += row_prev != STALL_TX_EMPTY;
+                row_stalled_in_frame = true;
+            }
+        }
+        stream_prev = stream.stalled;
+        row_prev = row.stalled;
+        res.cycles = now;
+    }
+
+    // --- Per bitplane, per frame, averaged over the rows ---
+    const int bitplanes = *std::max_element(seq.begin(), seq.end()) + 1;
+    res.oe_on_cycles.assign(bitplanes, 0.0);
+    res.lit_cmd_cycles.assign(bitplanes, 0.0);
+    res.shift_bound_cycles.assign(bitplanes, 0.0);
+    const double rows = (double)cfg.frames * scan_depth;
+    for (int s = 0; s < slices; ++s)
+    {
+        res.oe_on_cycles[seq[s]] += oe_on_slice[s] / rows;
+        res.lit_cmd_cycles[seq[s]] += res.lit_cycles[s] * clkdiv;
+        res.shift_bound_cycles[seq[s]] += wait_slice[s] / rows;
+    }
+    res.dma_bus_busy_cycles = dma.busy_cycles;
+    return res;
+}
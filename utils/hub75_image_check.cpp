@@ -0,0 +1,142 @@
+// Checks the compressed image decoders update_qoi() / update_rle() of src/hub75.cpp on a Linux host.
+//
+// The driver is compiled against the no-op SDK of utils/host_sdk. For each example asset the BGR
+// array is mapped with update_bgr(), then the utils/compress.py output of the same asset is decoded
+// with update_qoi() and update_rle() and rgb_buffer is compared slot by slot. Truncated streams must
+// be rejected with rgb_buffer unchanged. The host time per frame of each path is reported alongside.
+//
+//   for a in taylor_swift_64x64 vanessa_mai_64x64; do
+//       python utils/compress.py --qoi --bgr-header examples/$a.h -o /tmp/$a.qoi
+//       python utils/compress.py --rle --bgr-header examples/$a.h -o /tmp/$a.rle
+//   done
+//   g++ -O2 -std=c++17 -DUSE_PICO_GRAPHICS=false -Iutils/host_sdk -Iinclude -Isrc -o hub75_image_check utils/hub75_image_check.cpp src/hub75_trace.cpp
+//   ./hub75_image_check /tmp
+//
+// Built with the default configuration (64x64 panel); the assets must match the screen size.
+// Exit status: 0 ok, 1 mismatch or a truncated stream accepted, 2 missing files.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../src/hub75.cpp"
+
+#include "../examples/taylor_swift_64x64.h"
+#include "../examples/vanessa_mai_64x64.h"
+
+struct image_asset_t
+{
+    const char *name;
+    const uint8_t *bgr;
+    size_t size;
+};
+
+static const image_asset_t assets[] = {
+    {"taylor_swift_64x64", taylor_swift_64x64, sizeof(taylor_swift_64x64)},
+    {"vanessa_mai_64x64", vanessa_mai_64x64, sizeof(vanessa_mai_64x64)},
+};
+
+static bool read_file(const std::string &path, std::vector<uint8_t> &data)
+{
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f)
+    {
+        fprintf(stderr, "%s: cannot open\n", path.c_str());
+        return false;
+    }
+    data.clear();
+    for (int c; (c = fgetc(f)) != EOF;)
+        data.push_back((uint8_t)c);
+    fclose(f);
+    return true;
+}
+
+/// Host time of one call in µs, averaged over enough calls to take about 20 ms
+template <typename F>
+static double time_per_call(F f)
+{
+    using clock = std::chrono::steady_clock;
+    int n = 0;
+    const auto start = clock::now();
+    auto now = start;
+    while (now - start < std::chrono::milliseconds(20))
+    {
+        for (int i = 0; i < 100; ++i)
+            f();
+        n += 100;
+        now = clock::now();
+    }
+    return std::chrono::duration<double, std::micro>(now - start).count() / n;
+}
+
+/// Slots of rgb_buffer that differ from ref
+static size_t differences(const std::vector<uint32_t> &ref)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < TOTAL_PIXELS; ++i)
+        n += rgb_buffer[i] != ref[i];
+    return n;
+}
+
+/// Decodes data with update(), compares with ref and checks that every truncation is rejected
+template <typename F>
+static int check_decoder(const char *name, F update, const std::vector<uint8_t> &data, const std::vector<uint32_t> &ref)
+{
+    std::fill(rgb_buffer, rgb_buffer + TOTAL_PIXELS, 0u);
+    const bool accepted = update(data.data(), data.size());
+    const size_t diff = differences(ref);
+
+    // every shorter length must fail and leave the decoded frame in place
+    size_t truncated_accepted = 0, truncated_written = 0;
+    for (size_t len = 0; len < data.size(); ++len)
+    {
+        truncated_accepted += update(data.data(), len);
+        truncated_written += differences(ref) != 0;
+    }
+
+    const bool ok = accepted && !diff && !truncated_accepted && !truncated_written;
+    printf("    %-4s %5zu bytes  %s, %zu/%zu slots differ, truncated: %zu accepted, %zu wrote rgb_buffer  %s\n", name, data.size(),
+           accepted ? "accepted" : "REJECTED", diff, TOTAL_PIXELS, truncated_accepted, truncated_written, ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s DIR   (DIR holds <asset>.qoi and <asset>.rle from utils/compress.py)\n", argv[0]);
+        return 2;
+    }
+
+    int failed = 0;
+    for (const image_asset_t &a : assets)
+    {
+        std::vector<uint8_t> qoi, rle;
+        if (!read_file(std::string(argv[1]) + "/" + a.name + ".qoi", qoi) || !read_file(std::string(argv[1]) + "/" + a.name + ".rle", rle))
+            return 2;
+        if (a.size != TOTAL_PIXELS * 3)
+        {
+            fprintf(stderr, "%s: %zu bytes, the %ux%u screen needs %zu\n", a.name, a.size, (unsigned)HUB75_SCREEN_WIDTH,
+                    (unsigned)HUB75_SCREEN_HEIGHT, TOTAL_PIXELS * 3);
+            return 2;
+        }
+
+        update_bgr(a.bgr);
+        const std::vector<uint32_t> ref(rgb_buffer, rgb_buffer + TOTAL_PIXELS);
+
+        printf("%s\n", a.name);
+        failed |= check_decoder("qoi", update_qoi, qoi, ref);
+        failed |= check_decoder("rle", update_rle, rle, ref);
+
+        const double bgr_us = time_per_call([&] { update_bgr(a.bgr); });
+        const double qoi_us = time_per_call([&] { update_qoi(qoi.data(), qoi.size()); });
+        const double rle_us = time_per_call([&] { update_rle(rle.data(), rle.size()); });
+        printf("    host time per frame: bgr %.1f us (%zu bytes), qoi %.1f us (%.2fx), rle %.1f us (%.2fx)\n", bgr_us, a.size, qoi_us,
+               qoi_us / bgr_us, rle_us, rle_us / bgr_us);
+    }
+
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
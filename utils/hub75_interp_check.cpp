@@ -0,0 +1,101 @@
+// Checks the interpolator set-up of the RGB888 mapping kernel on a Linux host.
+//
+// Runs src/hub75_interp.hpp against the interpolator model in utils/interp_emu.h and
+// compares the looked-up CIE values with plain table indexing for every 24-bit colour
+// (plus a set of colours with the alpha byte set) and every CIE table variant of
+// src/cie.hpp, and the entry addresses of the 8 byte CCM_MATRIX tables of src/hub75_ccm.hpp.
+// Also checks that the interpolator state of the caller is restored.
+//
+//   g++ -O2 -std=c++17 -o hub75_interp_check utils/hub75_interp_check.cpp
+//   ./hub75_interp_check
+//
+// Exit status: 0 ok, 1 mismatch.
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "interp_emu.h"
+#include "../src/hub75_interp.hpp"
+#include "../src/hub75_ccm.hpp"
+#include "cie_tables.h"
+
+static int check_tables(const char *name, const uint16_t *red, const uint16_t *green, const uint16_t *blue)
+{
+    // Something the application left in the interpolators
+    interp0->accum[0] = 0x12345678u;
+    interp0->base[2] = 42;
+    interp_config cfg = interp_default_config();
+    interp_config_set_shift(&cfg, 3);
+    interp_set_config(interp1, 1, &cfg);
+
+    interp_lut_t state;
+    interp_lut_begin(state, red, green, blue, 1);
+
+    unsigned long errors = 0;
+    auto check = [&](uint32_t colour)
+    {
+        uint32_t rv, gv, bv;
+        interp_lut_channels(colour, rv, gv, bv);
+        if (rv != red[(colour >> 16) & 0xFF] || gv != green[(colour >> 8) & 0xFF] || bv != blue[colour & 0xFF])
+        {
+            if (errors++ < 5)
+                fprintf(stderr, "%s: colour %08x -> %u %u %u, expected %u %u %u\n", name, colour, rv, gv, bv,
+                        red[(colour >> 16) & 0xFF], green[(colour >> 8) & 0xFF], blue[colour & 0xFF]);
+        }
+    };
+
+    for (uint32_t colour = 0; colour < (1u << 24); ++colour)
+        check(colour);
+    for (uint32_t colour = 0; colour < (1u << 24); colour += 0x10101u)
+        check(colour | 0xFF000000u);
+
+    interp_lut_end(state);
+
+    if (interp0->accum[0] != 0x12345678u || interp0->base[2] != 42 || interp1->ctrl[1] != cfg.ctrl)
+    {
+        fprintf(stderr, "%s: interpolator state not restored\n", name);
+        errors++;
+    }
+
+    printf("%-22s %s\n", name, errors ? "FAILED" : "ok");
+    return errors ? 1 : 0;
+}
+
+static ccm_table_t ccm_table;
+
+static int check_ccm_entries()
+{
+    const int16_t m[3][3] = {{18350, -1311, -492}, {-819, 15892, -983}, {164, -655, 17203}};
+    ccm_build_tables(ccm_table, m, cie_separate_10::CIE_RED, cie_separate_10::CIE_GREEN, cie_separate_10::CIE_BLUE);
+
+    interp_lut_t state;
+    interp_lut_begin(state, ccm_table[0], ccm_table[1], ccm_table[2], CCM_ENTRY_SHIFT);
+
+    unsigned long errors = 0;
+    for (uint32_t colour = 0; colour < (1u << 24); ++colour)
+    {
+        const void *r, *g, *b;
+        interp_lut_lookup(colour | (colour << 24), CCM_ENTRY_SHIFT, r, g, b);
+        if (r != ccm_table[0][(colour >> 16) & 0xFF] || g != ccm_table[1][(colour >> 8) & 0xFF] || b != ccm_table[2][colour & 0xFF])
+        {
+            if (errors++ < 5)
+                fprintf(stderr, "ccm entries: colour %06x -> wrong entry address\n", colour);
+        }
+    }
+
+    interp_lut_end(state);
+
+    printf("%-22s %s\n", "ccm matrix entries", errors ? "FAILED" : "ok");
+    return errors ? 1 : 0;
+}
+
+int main()
+{
+    int failed = 0;
+    failed |= check_tables("separate, 10 bitplanes", cie_separate_10::CIE_RED, cie_separate_10::CIE_GREEN, cie_separate_10::CIE_BLUE);
+    failed |= check_tables("separate, 8 bitplanes", cie_separate_8::CIE_RED, cie_separate_8::CIE_GREEN, cie_separate_8::CIE_BLUE);
+    failed |= check_tables("shared, 10 bitplanes", cie_shared_10::CIE, cie_shared_10::CIE, cie_shared_10::CIE);
+    failed |= check_tables("shared, 8 bitplanes", cie_shared_8::CIE, cie_shared_8::CIE, cie_shared_8::CIE);
+    failed |= check_ccm_entries();
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
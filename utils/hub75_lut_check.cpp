@@ -0,0 +1,102 @@
+// Checks the on-device LUT generator (src/hub75_lut.hpp) on a Linux host.
+//
+// - CIE 1931 curve with the caps of utils/cie.py: compared with the tables of src/cie.hpp, at most 1 off
+// - gamma curves: compared with round(pow(v / 255, gamma) * max * cap), at most 1 off
+// - black level: compared with the float form of the same formula, at most 1 off
+//
+//   g++ -O2 -std=c++17 -o hub75_lut_check utils/hub75_lut_check.cpp
+//   ./hub75_lut_check
+//
+// Exit status: 0 ok, 1 mismatch.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+
+#include "../src/hub75_lut.hpp"
+#include "cie_tables.h"
+
+static uint16_t red[256], green[256], blue[256];
+static uint16_t *const tables[3] = {red, green, blue};
+
+static uint32_t q16(double x)
+{
+    return (uint32_t)lround(x * 65536.0);
+}
+
+static int check_cie(const char *name, const uint16_t *ref_r, const uint16_t *ref_g, const uint16_t *ref_b, const double caps[3],
+                     uint32_t max)
+{
+    const uint32_t cap_q16[3] = {q16(caps[0]), q16(caps[1]), q16(caps[2])};
+    lut_build_tables(tables, 0, cap_q16, max, 0);
+
+    const uint16_t *const ref[3] = {ref_r, ref_g, ref_b};
+    int differences = 0, worst = 0;
+    for (int c = 0; c < 3; ++c)
+        for (int v = 0; v < 256; ++v)
+            if (tables[c][v] != ref[c][v])
+            {
+                const int err = abs((int)tables[c][v] - (int)ref[c][v]);
+                worst = err > worst ? err : worst;
+                if (differences++ < 5)
+                    fprintf(stderr, "%s: channel %d, v %d: %u, cie.hpp %u\n", name, c, v, tables[c][v], ref[c][v]);
+            }
+
+    // A cap like 0.988 is not exact in Q16; entries whose float value is within ~0.005 of .5 may round the other way
+    if (differences)
+        printf("  %-40s %d/768 entries 1 off %s\n", name, differences, worst > 1 ? "FAILED" : "ok");
+    else
+        printf("  %-40s identical to cie.hpp\n", name);
+    return worst > 1 ? 1 : 0;
+}
+
+static int check_formula(double gamma, double cap, uint32_t max, uint32_t black)
+{
+    const uint32_t cap_q16[3] = {q16(cap), q16(cap), q16(cap)};
+    lut_build_tables(tables, q16(gamma), cap_q16, max, black);
+
+    int worst = 0, exact = 0;
+    for (int v = 0; v < 256; ++v)
+    {
+        const double y = pow(v / 255.0, gamma);
+        const long want = v == 0 ? 0 : lround(black + y * (max * cap - black));
+        const int err = (int)labs((long)red[v] - want);
+        worst = err > worst ? err : worst;
+        exact += err == 0;
+    }
+
+    char name[64];
+    snprintf(name, sizeof(name), "gamma %.2f cap %.3f max %u black %u", gamma, cap, max, black);
+    printf("  %-40s max error %d, %d/256 exact %s\n", name, worst, exact, worst > 1 ? "FAILED" : "ok");
+    return worst > 1 ? 1 : 0;
+}
+
+int main()
+{
+    int failed = 0;
+
+    // RED_CAP, GREEN_CAP, BLUE_CAP of utils/cie.py; the shared table uses GREEN_CAP
+    const double caps[3] = {0.988, 1.0, 1.0};
+    const double shared[3] = {1.0, 1.0, 1.0};
+
+    printf("CIE 1931\n");
+    failed |= check_cie("separate, 10 bitplanes", cie_separate_10::CIE_RED, cie_separate_10::CIE_GREEN, cie_separate_10::CIE_BLUE, caps, 1023);
+    failed |= check_cie("separate, 8 bitplanes", cie_separate_8::CIE_RED, cie_separate_8::CIE_GREEN, cie_separate_8::CIE_BLUE, caps, 255);
+    failed |= check_cie("shared, 10 bitplanes", cie_shared_10::CIE, cie_shared_10::CIE, cie_shared_10::CIE, shared, 1023);
+    failed |= check_cie("shared, 8 bitplanes", cie_shared_8::CIE, cie_shared_8::CIE, cie_shared_8::CIE, shared, 255);
+
+    printf("gamma\n");
+    for (double gamma : {0.45, 1.0, 1.8, 2.2, 2.8, 3.5})
+        for (uint32_t max : {1023u, 255u})
+            failed |= check_formula(gamma, 1.0, max, 0);
+    failed |= check_formula(2.2, 0.8, 1023, 0);
+    failed |= check_formula(2.2, 0.25, 1023, 0);
+
+    printf("black level\n");
+    failed |= check_formula(2.2, 1.0, 1023, 4);
+    failed |= check_formula(2.8, 0.5, 1023, 16);
+    failed |= check_formula(1.8, 1.0, 255, 2);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
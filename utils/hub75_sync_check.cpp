@@ -0,0 +1,308 @@
+// Checks the frame sync decisions (src/hub75_sync.hpp) on a Linux host.
+//
+// Simulates a wall of one master and several followers, each with its own crystal error,
+// interrupt latency and frame build time. The master pulses every FRAMES_PER_PULSE refresh
+// frames. The followers run the same event sequence as hub75.cpp (edge interrupt,
+// row_ctrl_chan completion, pixel frame boundary, timeout alarm). Every controller gets
+// the same frames to present. The spread is the time between the first and the last
+// controller showing a frame.
+//
+// - free running:      no sync, for comparison
+// - HUB75_SYNC_SWAP:    spread at most one refresh frame, drift_ppm matches the crystals
+// - HUB75_SYNC_REFRESH: spread within FRAME_SYNC_LATE_US, frames start at the pulse
+// - external 60 Hz:    pulse rate unrelated to the refresh, with jitter
+// - lost pulses:       a stopped stream restarts by timeout, swaps are not held
+//
+//   g++ -O2 -std=c++17 -o hub75_sync_check utils/hub75_sync_check.cpp
+//   ./hub75_sync_check
+//
+// Exit status: 0 ok, 1 failed.
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../src/hub75_sync.hpp"
+
+constexpr double FRAME_US = 1268.0; // 64x64, 1/32 scan, 789 Hz
+constexpr uint32_t FRAMES_PER_PULSE = 13;
+constexpr uint32_t LATE_US = 20; // FRAME_SYNC_LATE_US
+constexpr double RUN_US = 2e6;
+
+enum mode_t_ : int
+{
+    FREE,
+    SWAP,
+    REFRESH
+};
+
+struct controller_t
+{
+    double ppm;       ///< crystal error: timer and PIO clock run fast by ppm
+    double offset_us; ///< timer value at true time 0
+    double phase_us;  ///< first frame boundary
+};
+
+struct result_t
+{
+    std::vector<double> shown; ///< true time each present reached the panel, -1 = never
+    sync_t sync;
+    double max_dark_us; ///< longest stretch without a frame boundary
+};
+
+static std::mt19937 rng(48);
+
+static double uniform(double a, double b)
+{
+    return std::uniform_real_distribution<double>(a, b)(rng);
+}
+
+// Pulse times of a master: every FRAMES_PER_PULSE-th frame start
+static std::vector<double> master_pulses(const controller_t &m)
+{
+    std::vector<double> pulses;
+    const double frame = FRAME_US / (1.0 + m.ppm * 1e-6);
+    uint32_t count = 0;
+    for (double t = m.phase_us; t < RUN_US; t += frame)
+        if (++count >= FRAMES_PER_PULSE)
+        {
+            count = 0;
+            pulses.push_back(t);
+        }
+    return pulses;
+}
+
+/**
+ * Event simulation of one controller. pulses are true times of the edges, presents the true
+ * times update() is called; each build takes build_us.
+ */
+static result_t run(const controller_t &c, mode_t_ mode, const std::vector<double> &pulses, const std::vector<double> &presents,
+                    const std::vector<double> &build_us, double latency_us)
+{
+    const double scale = 1.0 + c.ppm * 1e-6;
+    const double frame = FRAME_US / scale; // true time of a frame of FRAME_US local time
+    auto local = [&](double t) { return (uint32_t)(int64_t)std::llround(c.offset_us + t * scale); };
+
+    result_t r;
+    r.shown.assign(presents.size(), -1.0);
+    r.max_dark_us = 0;
+    sync_init(r.sync, mode == REFRESH, LATE_US);
+    sync_t &s = r.sync;
+
+    bool running = true;
+    double boundary = c.phase_us, last_boundary = -1, last_frame_start = -1;
+    double alarm = INFINITY;
+    uint32_t alarm_gen = 0;
+    uint32_t frame_us = 0;
+    int pending = -1; // newest built frame waiting for its swap
+    size_t p = 0, b = 0;
+
+    // Edge interrupt entry: latency plus up to 2 us on the followers; the master sees its own
+    // pulse right after the frame boundary that emitted it
+    std::vector<double> arrivals;
+    for (double pulse : pulses)
+        arrivals.push_back(pulse + latency_us + (latency_us >= 1 ? uniform(0, 2) : 0));
+
+    std::vector<std::pair<double, int>> built;
+    for (size_t i = 0; i < presents.size(); ++i)
+        built.push_back({presents[i] + build_us[i], (int)i});
+    std::sort(built.begin(), built.end());
+
+    for (;;)
+    {
+        const double t_pulse = mode != FREE && p < arrivals.size() ? arrivals[p] : INFINITY;
+        const double t_build = b < built.size() ? built[b].first : INFINITY;
+        const double t_boundary = running ? boundary : INFINITY;
+        const double t = std::min(std::min(t_pulse, t_build), std::min(t_boundary, alarm));
+        if (t >= RUN_US)
+            break;
+
+        if (t == t_build)
+        {
+            pending = built[b++].second;
+        }
+        else if (t == t_pulse)
+        {
+            ++p;
+            if (sync_pulse(s, local(t)))
+            {
+                running = true;
+                boundary = t + frame;
+                last_frame_start = t;
+                if (last_boundary >= 0)
+                    r.max_dark_us = std::max(r.max_dark_us, t - last_boundary);
+            }
+        }
+        else if (t == alarm)
+        {
+            alarm = INFINITY;
+            if (s.stops == alarm_gen && sync_timeout(s, local(t)))
+            {
+                running = true;
+                boundary = t + frame;
+                last_frame_start = t;
+                r.max_dark_us = std::max(r.max_dark_us, t - last_boundary);
+            }
+        }
+        else
+        {
+            // row_ctrl_chan completion and pixel frame boundary
+            const uint32_t now = local(t);
+            if (last_frame_start >= 0)
+                frame_us = now - local(last_frame_start);
+            last_boundary = t;
+
+            const bool allowed = mode == FREE || sync_swap(s, now, pending >= 0);
+            if (pending >= 0 && allowed)
+            {
+                r.shown[pending] = t;
+                pending = -1;
+            }
+
+            switch (mode == FREE ? SYNC_CONTINUE : sync_frame(s, now, frame_us))
+            {
+            case SYNC_WAIT:
+                running = false;
+                last_frame_start = -1;
+                alarm = t + sync_timeout_in(s, now) / scale;
+                alarm_gen = s.stops;
+                break;
+            default:
+                boundary = t + frame;
+                last_frame_start = t;
+                break;
+            }
+        }
+    }
+    return r;
+}
+
+struct wall_t
+{
+    double spread_max_us = 0;
+    double spread_avg_us = 0;
+    int never = 0;
+    std::vector<result_t> results;
+};
+
+// Content at half the pulse rate, presented 1 ms after every second pulse from the third on, when
+// the followers know the period (every 33 ms without pulses)
+static wall_t run_wall(const std::vector<controller_t> &cs, const std::vector<mode_t_> &modes, const std::vector<double> &pulses)
+{
+    std::vector<double> presents;
+    if (pulses.empty())
+        for (double t = 5000; t < RUN_US - 50000; t += 33333)
+            presents.push_back(t);
+    for (size_t i = 2; i < pulses.size(); i += 2)
+        if (pulses[i] < RUN_US - 50000)
+            presents.push_back(pulses[i] + 1000);
+
+    wall_t w;
+    for (size_t i = 0; i < cs.size(); ++i)
+    {
+        std::vector<double> build;
+        for (size_t k = 0; k < presents.size(); ++k)
+            build.push_back(uniform(2000, 6000));
+        w.results.push_back(run(cs[i], modes[i], pulses, presents, build, i == 0 ? 0.01 : 1));
+    }
+
+    int counted = 0;
+    for (size_t k = 0; k < presents.size(); ++k)
+    {
+        double lo = INFINITY, hi = -INFINITY;
+        for (const result_t &r : w.results)
+        {
+            if (r.shown[k] < 0)
+            {
+                ++w.never;
+                continue;
+            }
+            lo = std::min(lo, r.shown[k]);
+            hi = std::max(hi, r.shown[k]);
+        }
+        if (hi >= lo)
+        {
+            w.spread_max_us = std::max(w.spread_max_us, hi - lo);
+            w.spread_avg_us += hi - lo;
+            ++counted;
+        }
+    }
+    w.spread_avg_us /= counted ? counted : 1;
+    return w;
+}
+
+static void print_wall(const char *name, const wall_t &w)
+{
+    printf("%s\n  swap spread: max %.1f us, avg %.1f us, %d frames never shown\n", name, w.spread_max_us, w.spread_avg_us, w.never);
+    for (size_t i = 1; i < w.results.size(); ++i)
+    {
+        const sync_t &s = w.results[i].sync;
+        printf("  follower %zu: %u pulses, %u missed, phase %d..%d us, drift %+.1f ppm, %u late, %u resyncs, %u stops, "
+               "%.2f %% waited, %u held swaps\n",
+               i, s.pulses, s.missed, s.have_phase ? s.phase_min : 0, s.have_phase ? s.phase_max : 0,
+               s.drift_span_us ? (double)s.drift_us * 1e6 / s.drift_span_us : 0.0, s.late, s.resyncs, s.stops,
+               100.0 * s.waited_us / RUN_US, s.held_swaps);
+    }
+}
+
+int main()
+{
+    // Crystal errors within +-50 ppm
+    const std::vector<controller_t> wall = {{12, 1000, 0}, {-38, 555555, 417}, {47, 4000000000.0, 903}, {-5, 77, 1201}};
+    int failed = 0;
+
+    const std::vector<double> pulses = master_pulses(wall[0]);
+    const std::vector<double> none;
+
+    const wall_t free_wall = run_wall(wall, {FREE, FREE, FREE, FREE}, none);
+    print_wall("free running", free_wall);
+
+    const wall_t swap = run_wall(wall, {SWAP, SWAP, SWAP, SWAP}, pulses);
+    print_wall("HUB75_SYNC_SWAP, master pulses every 13 frames", swap);
+    bool ok = swap.never == 0 && swap.spread_max_us <= FRAME_US + 10;
+    for (size_t i = 1; i < wall.size(); ++i)
+    {
+        const sync_t &s = swap.results[i].sync;
+        const double drift = (double)s.drift_us * 1e6 / s.drift_span_us;
+        ok &= std::fabs(drift - (wall[0].ppm - wall[i].ppm)) < 2.0;
+    }
+    printf("  %s\n", ok ? "ok" : "FAILED");
+    failed |= !ok;
+
+    const wall_t refresh = run_wall(wall, {SWAP, REFRESH, REFRESH, REFRESH}, pulses);
+    print_wall("HUB75_SYNC_REFRESH, master pulses every 13 frames", refresh);
+    ok = refresh.never == 0 && refresh.spread_max_us <= LATE_US + 5;
+    for (size_t i = 1; i < wall.size(); ++i)
+        ok &= refresh.results[i].sync.phase_max <= (int32_t)LATE_US + 2 && refresh.results[i].max_dark_us < 2 * FRAME_US; // + edge jitter
+    printf("  %s\n", ok ? "ok" : "FAILED");
+    failed |= !ok;
+
+    // External generator at 60 Hz with +-5 us jitter, unrelated to the refresh
+    std::vector<double> ext;
+    for (double t = 300; t < RUN_US; t += 1e6 / 60)
+        ext.push_back(t + uniform(-5, 5));
+    const wall_t external = run_wall(wall, {REFRESH, REFRESH, REFRESH, REFRESH}, ext);
+    print_wall("HUB75_SYNC_REFRESH, external 60 Hz", external);
+    ok = external.never == 0 && external.spread_max_us <= LATE_US + 15;
+    printf("  %s\n", ok ? "ok" : "FAILED");
+    failed |= !ok;
+
+    // The pulses stop for 200 ms and come back
+    std::vector<double> gaps;
+    for (double t : ext)
+        if (t < 700000 || t > 900000)
+            gaps.push_back(t);
+    const wall_t lost = run_wall(wall, {REFRESH, REFRESH, REFRESH, REFRESH}, gaps);
+    print_wall("HUB75_SYNC_REFRESH, external 60 Hz, 200 ms without pulses", lost);
+    ok = lost.never == 0;
+    for (const result_t &r : lost.results)
+        ok &= r.sync.missed == ext.size() - gaps.size() && r.max_dark_us < 1e6 / 60;
+    printf("  %s\n", ok ? "ok" : "FAILED");
+    failed |= !ok;
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
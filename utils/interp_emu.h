@@ -0,0 +1,178 @@
+// Host model of the RP2040 / RP2350 SIO interpolator.
+//
+// Implements the subset of the Pico SDK interpolator API used by src/hub75_interp.hpp
+// with the same names, so the mapping kernels can be run and checked on a Linux host:
+//
+//   #include "interp_emu.h"
+//   #include "../src/hub75_interp.hpp"
+//
+// Modelled per lane: logical right shift, mask, sign extension, cross input, add raw,
+// BASE0/1/2, PEEK0/1/2 and POP0/1/2 with write-back (cross result included).
+// Not modelled: blend and clamp modes, FORCE_MSB, interp1 differences, the overflow flag.
+// Bases are pointer sized, so table addresses of a 64-bit host survive the addition.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// CTRL_LANE bit layout as in hardware/regs/sio.h
+namespace interp_emu_ctrl
+{
+    constexpr uint32_t SHIFT_LSB = 0;
+    constexpr uint32_t MASK_LSB_LSB = 5;
+    constexpr uint32_t MASK_MSB_LSB = 10;
+    constexpr uint32_t SIGNED_BITS = 1u << 15;
+    constexpr uint32_t CROSS_INPUT_BITS = 1u << 16;
+    constexpr uint32_t CROSS_RESULT_BITS = 1u << 17;
+    constexpr uint32_t ADD_RAW_BITS = 1u << 18;
+} // namespace interp_emu_ctrl
+
+typedef struct
+{
+    uint32_t ctrl;
+} interp_config;
+
+struct interp_hw_t;
+
+// PEEKn / POPn registers: reading computes the lane results from the current state
+struct interp_emu_peek_t
+{
+    const interp_hw_t *hw;
+    uintptr_t operator[](int i) const;
+};
+
+struct interp_emu_pop_t
+{
+    interp_hw_t *hw;
+    uintptr_t operator[](int i) const;
+};
+
+struct interp_hw_t
+{
+    uint32_t accum[2] = {0, 0};
+    uintptr_t base[3] = {0, 0, 0};
+    uint32_t ctrl[2] = {0, 0};
+    interp_emu_peek_t peek{this};
+    interp_emu_pop_t pop{this};
+
+    interp_hw_t() = default;
+    interp_hw_t(const interp_hw_t &) = delete;
+    interp_hw_t &operator=(const interp_hw_t &) = delete;
+
+    // Shifted, masked and sign extended input of a lane
+    uint32_t lane_masked(int lane) const
+    {
+        using namespace interp_emu_ctrl;
+        const uint32_t c = ctrl[lane];
+        const uint32_t input = (c & CROSS_INPUT_BITS) ? accum[1 - lane] : accum[lane];
+        const uint32_t shift = (c >> SHIFT_LSB) & 31u;
+        const uint32_t lsb = (c >> MASK_LSB_LSB) & 31u;
+        const uint32_t msb = (c >> MASK_MSB_LSB) & 31u;
+        const uint32_t mask = (msb == 31 ? 0xFFFFFFFFu : (2u << msb) - 1u) & ~((1u << lsb) - 1u);
+        uint32_t v = (input >> shift) & mask;
+        if ((c & SIGNED_BITS) && msb < 31 && (v >> msb) & 1u)
+            v |= ~((2u << msb) - 1u);
+        return v;
+    }
+
+    uintptr_t result(int i) const
+    {
+        using namespace interp_emu_ctrl;
+        if (i == 2)
+            return base[2] + (uintptr_t)(int32_t)lane_masked(0) + (uintptr_t)(int32_t)lane_masked(1);
+        const uint32_t c = ctrl[i];
+        const uint32_t input = (c & CROSS_INPUT_BITS) ? accum[1 - i] : accum[i];
+        return base[i] + (uintptr_t)(int32_t)((c & ADD_RAW_BITS) ? input : lane_masked(i));
+    }
+};
+
+inline uintptr_t interp_emu_peek_t::operator[](int i) const
+{
+    return hw->result(i);
+}
+
+inline uintptr_t interp_emu_pop_t::operator[](int i) const
+{
+    const uintptr_t r = hw->result(i);
+    const uint32_t r0 = (uint32_t)hw->result(0);
+    const uint32_t r1 = (uint32_t)hw->result(1);
+    hw->accum[0] = (hw->ctrl[0] & interp_emu_ctrl::CROSS_RESULT_BITS) ? r1 : r0;
+    hw->accum[1] = (hw->ctrl[1] & interp_emu_ctrl::CROSS_RESULT_BITS) ? r0 : r1;
+    return r;
+}
+
+// One instance per interpolator, like the per-core SIO registers on the device
+static interp_hw_t interp_emu_hw[2];
+#define interp0 (&interp_emu_hw[0])
+#define interp1 (&interp_emu_hw[1])
+
+typedef struct
+{
+    uint32_t accum[2];
+    uintptr_t base[3];
+    uint32_t ctrl[2];
+} interp_hw_save_t;
+
+static inline interp_config interp_default_config()
+{
+    interp_config c = {0};
+    c.ctrl = 31u << interp_emu_ctrl::MASK_MSB_LSB; // shift 0, mask bits 0..31
+    return c;
+}
+
+static inline void interp_config_set_shift(interp_config *c, uint32_t shift)
+{
+    c->ctrl = (c->ctrl & ~(31u << interp_emu_ctrl::SHIFT_LSB)) | ((shift & 31u) << interp_emu_ctrl::SHIFT_LSB);
+}
+
+static inline void interp_config_set_mask(interp_config *c, uint32_t mask_lsb, uint32_t mask_msb)
+{
+    using namespace interp_emu_ctrl;
+    c->ctrl = (c->ctrl & ~((31u << MASK_LSB_LSB) | (31u << MASK_MSB_LSB))) | ((mask_lsb & 31u) << MASK_LSB_LSB) |
+              ((mask_msb & 31u) << MASK_MSB_LSB);
+}
+
+static inline void interp_emu_set_bit(interp_config *c, uint32_t bit, bool on)
+{
+    c->ctrl = on ? (c->ctrl | bit) : (c->ctrl & ~bit);
+}
+
+static inline void interp_config_set_signed(interp_config *c, bool on)
+{
+    interp_emu_set_bit(c, interp_emu_ctrl::SIGNED_BITS, on);
+}
+
+static inline void interp_config_set_cross_input(interp_config *c, bool on)
+{
+    interp_emu_set_bit(c, interp_emu_ctrl::CROSS_INPUT_BITS, on);
+}
+
+static inline void interp_config_set_cross_result(interp_config *c, bool on)
+{
+    interp_emu_set_bit(c, interp_emu_ctrl::CROSS_RESULT_BITS, on);
+}
+
+static inline void interp_config_set_add_raw(interp_config *c, bool on)
+{
+    interp_emu_set_bit(c, interp_emu_ctrl::ADD_RAW_BITS, on);
+}
+
+static inline void interp_set_config(interp_hw_t *interp, uint32_t lane, interp_config *c)
+{
+    interp->ctrl[lane] = c->ctrl;
+}
+
+static inline void interp_save(interp_hw_t *interp, interp_hw_save_t *saver)
+{
+    memcpy(saver->accum, interp->accum, sizeof(saver->accum));
+    memcpy(saver->base, interp->base, sizeof(saver->base));
+    memcpy(saver->ctrl, interp->ctrl, sizeof(saver->ctrl));
+}
+
+static inline void interp_restore(interp_hw_t *interp, interp_hw_save_t *saver)
+{
+    memcpy(interp->accum, saver->accum, sizeof(saver->accum));
+    memcpy(interp->base, saver->base, sizeof(saver->base));
+    memcpy(interp->ctrl, saver->ctrl, sizeof(saver->ctrl));
+}
@@ -0,0 +1,1076 @@
+// Cycle-counting emulator for the PIO and DMA features used by the HUB75 driver.
+//
+// Host-side only - no Pico SDK or pioasm needed. pio_assemble() reads src/hub75.pio
+// itself, so the emulated state machines run exactly the instruction words that are
+// loaded on the device, including instructions patched at run time
+// (hub75_bitplane_setup_set_shift()).
+//
+// Supported PIO subset: jmp, wait (gpio, pin, irq), in, out, push, pull, mov, irq, set,
+// nop, side-set (with opt), delays, autopull/autopush, TX/RX FIFO join, fractional clock
+// divider, instructions forced from the CPU (pio_sm_exec(), must not stall) and the
+// .program/.side_set/.define/.wrap_target/.wrap directives.
+// Not supported: out/mov exec, mov status, PIO version 1 extensions. gpio_in returns the
+// level the state machine sees; the 2-cycle input synchroniser is up to the caller.
+//
+// The DMA model issues at most one transfer per system clock (round robin between
+// channels with an asserted DREQ), each transfer landing `latency` cycles later.
+// Channels chain like on the device, so control-channel reloads cost real cycles.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct pio_program_t
+{
+    std::string name;
+    std::vector<uint16_t> code;
+    int wrap_target = 0;
+    int wrap = 0;
+    int sideset_bits = 0; ///< side-set field width including the opt enable bit
+    bool sideset_opt = false;
+    std::map<std::string, int> labels; ///< all labels, public or not
+    std::map<std::string, int> defines;
+};
+
+// Host equivalents of the SDK encoders used to patch programs
+inline uint16_t emu_encode_pull(bool if_empty, bool block)
+{
+    return 0x8080u | (if_empty ? 0x40u : 0u) | (block ? 0x20u : 0u);
+}
+
+inline uint16_t emu_encode_out_null(uint32_t bits)
+{
+    return 0x6060u | (bits & 31u);
+}
+
+// ---------------------------------------------------------------------------
+// Assembler
+// ---------------------------------------------------------------------------
+
+namespace pio_asm
+{
+    struct line_t
+    {
+        int line;
+        std::vector<std::string> tokens; ///< mnemonic and operands
+        bool has_side;
+        std::string side, delay;
+    };
+
+    inline std::string lower(std::string s)
+    {
+        for (char &c : s)
+            c = (char)tolower((unsigned char)c);
+        return s;
+    }
+
+    [[noreturn]] inline void fail(int line, const std::string &msg)
+    {
+        throw std::runtime_error("line " + std::to_string(line) + ": " + msg);
+    }
+
+    inline int value(const std::string &tok, const std::map<std::string, int> &defines, int line)
+    {
+        if (tok.empty())
+            fail(line, "missing value");
+        if (tok[0] == '-')
+            return -value(tok.substr(1), defines, line);
+        if (isdigit((unsigned char)tok[0]))
+        {
+            if (tok.size() > 2 && (tok[1] == 'b' || tok[1] == 'B'))
+                return (int)std::stoul(tok.substr(2), nullptr, 2);
+            return (int)std::stoul(tok, nullptr, 0);
+        }
+        auto it = defines.find(tok);
+        if (it == defines.end())
+            fail(line, "unknown symbol '" + tok + "'");
+        return it->second;
+    }
+
+    inline std::vector<std::string> split(const std::string &s)
+    {
+        std::vector<std::string> out;
+        std::istringstream in(s);
+        std::string t;
+        while (in >> t)
+            out.push_back(t);
+        return out;
+    }
+
+    inline int source_code(const std::string &s, bool for_mov, int line)
+    {
+        static const std::map<std::string, int> in_src = {{"pins", 0}, {"x", 1}, {"y", 2}, {"null", 3}, {"isr", 6}, {"osr", 7}};
+        static const std::map<std::string, int> mov_src = {{"pins", 0}, {"x", 1}, {"y", 2}, {"null", 3}, {"isr", 6}, {"osr", 7}};
+        const auto &m = for_mov ? mov_src : in_src;
+        auto it = m.find(lower(s));
+        if (it == m.end())
+            fail(line, "unsupported source '" + s + "'");
+        return it->second;
+    }
+
+    inline int dest_code(const std::string &s, const std::string &op, int line)
+    {
+        static const std::map<std::string, int> out_dst = {{"pins", 0}, {"x", 1}, {"y", 2}, {"null", 3}, {"pindirs", 4}, {"pc", 5}, {"isr", 6}};
+        static const std::map<std::string, int> mov_dst = {{"pins", 0}, {"x", 1}, {"y", 2}, {"pc", 5}, {"isr", 6}, {"osr", 7}};
+        static const std::map<std::string, int> set_dst = {{"pins", 0}, {"x", 1}, {"y", 2}, {"pindirs", 4}};
+        const auto &m = op == "out" ? out_dst : op == "mov" ? mov_dst : set_dst;
+        auto it = m.find(lower(s));
+        if (it == m.end())
+            fail(line, "unsupported destination '" + s + "' for " + op);
+        return it->second;
+    }
+
+    inline uint16_t irq_index(const std::vector<std::string> &t, size_t i, const std::map<std::string, int> &defines, int line)
+    {
+        if (i >= t.size())
+            fail(line, "missing irq index");
+        int idx = value(t[i], defines, line) & 7;
+        if (i + 1 < t.size() && lower(t[i + 1]) == "rel")
+            idx |= 0x10;
+        return (uint16_t)idx;
+    }
+
+    inline uint16_t encode(const line_t &l, const pio_program_t &p, const std::map<std::string, int> &symbols)
+    {
+        const auto &t = l.tokens;
+        const std::string op = lower(t[0]);
+        const int line = l.line;
+        auto arg = [&](size_t i) -> const std::string & {
+            if (i >= t.size())
+                fail(line, "missing operand for " + op);
+            return t[i];
+        };
+
+        uint16_t instr = 0;
+        if (op == "jmp")
+        {
+            static const std::map<std::string, int> conds = {{"!x", 1}, {"x--", 2}, {"!y", 3}, {"y--", 4}, {"x!=y", 5}, {"pin", 6}, {"!osre", 7}};
+            int cond = 0;
+            size_t i = 1;
+            auto c = conds.find(lower(arg(1)));
+            if (c != conds.end())
+            {
+                cond = c->second;
+                i = 2;
+            }
+            instr = (uint16_t)(0x0000u | (cond << 5) | (value(arg(i), symbols, line) & 31));
+        }
+        else if (op == "wait")
+        {
+            size_t i = 1;
+            int polarity = 1;
+            if (isdigit((unsigned char)arg(1)[0]))
+                polarity = value(t[i++], symbols, line) & 1;
+            const std::string src = lower(arg(i));
+            if (src == "gpio")
+                instr = (uint16_t)(0x2000u | (polarity << 7) | (0 << 5) | (value(arg(i + 1), symbols, line) & 31));
+            else if (src == "pin")
+                instr = (uint16_t)(0x2000u | (polarity << 7) | (1 << 5) | (value(arg(i + 1), symbols, line) & 31));
+            else if (src == "irq")
+                instr = (uint16_t)(0x2000u | (polarity << 7) | (2 << 5) | irq_index(t, i + 1, symbols, line));
+            else
+                fail(line, "unsupported wait source '" + src + "'");
+        }
+        else if (op == "in")
+        {
+            instr = (uint16_t)(0x4000u | (source_code(arg(1), false, line) << 5) | (value(arg(2), symbols, line) & 31));
+        }
+        else if (op == "out")
+        {
+            instr = (uint16_t)(0x6000u | (dest_code(arg(1), op, line) << 5) | (value(arg(2), symbols, line) & 31));
+        }
+        else if (op == "push" || op == "pull")
+        {
+            bool cond = false, block = true;
+            for (size_t i = 1; i < t.size(); ++i)
+            {
+                const std::string o = lower(t[i]);
+                if (o == "iffull" || o == "ifempty")
+                    cond = true;
+                else if (o == "noblock")
+                    block = false;
+                else if (o != "block")
+                    fail(line, "unknown " + op + " option '" + o + "'");
+            }
+            instr = (uint16_t)(0x8000u | (op == "pull" ? 0x80u : 0u) | (cond ? 0x40u : 0u) | (block ? 0x20u : 0u));
+        }
+        else if (op == "mov" || op == "nop")
+        {
+            int dst = 2, mop = 0, src = 2; // nop == mov y, y
+            if (op == "mov")
+            {
+                dst = dest_code(arg(1), op, line);
+                std::string s = arg(2);
+                if (s == "!" || s == "~" || s == "::")
+                {
+                    mop = s == "::" ? 2 : 1;
+                    s = arg(3);
+                }
+                else if (s[0] == '!' || s[0] == '~')
+                {
+                    mop = 1;
+                    s = s.substr(1);
+                }
+                else if (s.compare(0, 2, "::") == 0)
+                {
+                    mop = 2;
+                    s = s.substr(2);
+                }
+                src = source_code(s, true, line);
+            }
+            instr = (uint16_t)(0xa000u | (dst << 5) | (mop << 3) | src);
+        }
+        else if (op == "irq")
+        {
+            size_t i = 1;
+            int clr = 0, wait = 0;
+            const std::string mode = lower(arg(1));
+            if (mode == "set" || mode == "nowait")
+                i = 2;
+            else if (mode == "wait")
+                wait = 1, i = 2;
+            else if (mode == "clear")
+                clr = 1, i = 2;
+            instr = (uint16_t)(0xc000u | (clr << 6) | (wait << 5) | irq_index(t, i, symbols, line));
+        }
+        else if (op == "set")
+        {
+            instr = (uint16_t)(0xe000u | (dest_code(arg(1), op, line) << 5) | (value(arg(2), symbols, line) & 31));
+        }
+        else
+        {
+            fail(line, "unsupported instruction '" + op + "'");
+        }
+
+        // Delay / side-set field, bits 12:8
+        const int delay_bits = 5 - p.sideset_bits;
+        uint32_t field = 0;
+        if (l.has_side)
+        {
+            if (p.sideset_bits == 0)
+                fail(line, "side-set without .side_set");
+            const uint32_t side = (uint32_t)value(l.side, symbols, line);
+            field |= side << delay_bits;
+            if (p.sideset_opt)
+                field |= 0x10u;
+        }
+        else if (p.sideset_bits && !p.sideset_opt)
+        {
+            fail(line, "side-set required by .side_set");
+        }
+        if (!l.delay.empty())
+        {
+            const int d = value(l.delay, symbols, line);
+            if (d < 0 || d >= (1 << delay_bits))
+                fail(line, "delay out of range");
+            field |= (uint32_t)d;
+        }
+        return (uint16_t)(instr | (field << 8));
+    }
+}
+
+/**
+ * @brief Assemble every program of a .pio source.
+ *
+ * Throws std::runtime_error with the line number on anything outside the supported subset.
+ */
+inline std::map<std::string, pio_program_t> pio_assemble(const std::string &source)
+{
+    using namespace pio_asm;
+
+    std::map<std::string, pio_program_t> programs;
+    std::map<std::string, int> global_defines;
+    pio_program_t *p = nullptr;
+    std::vector<line_t> lines;
+    bool wrap_target_next = false;
+    bool in_code_block = false;
+
+    auto finish = [&]() {
+        if (!p)
+            return;
+        std::map<std::string, int> symbols = global_defines;
+        for (const auto &d : p->defines)
+            symbols[d.first] = d.second;
+        for (const auto &l : p->labels)
+            symbols[l.first] = l.second;
+        for (const auto &l : lines)
+            p->code.push_back(encode(l, *p, symbols));
+        if (p->wrap < 0)
+            p->wrap = (int)p->code.size() - 1;
+        lines.clear();
+    };
+
+    std::istringstream in(source);
+    std::string text;
+    int line_no = 0;
+    while (std::getline(in, text))
+    {
+        ++line_no;
+        if (in_code_block)
+        {
+            if (text.find("%}") != std::string::npos)
+                in_code_block = false;
+            continue;
+        }
+        if (text.compare(0, 1, "%") == 0)
+        {
+            in_code_block = text.find("%}") == std::string::npos;
+            continue;
+        }
+
+        // Strip comments
+        size_t cut = std::min(text.find(';'), text.find("//"));
+        if (cut != std::string::npos)
+            text.erase(cut);
+
+        std::vector<std::string> tok = split(text);
+        if (tok.empty())
+            continue;
+
+        if (tok[0][0] == '.')
+        {
+            const std::string d = lower(tok[0]);
+            if (d == ".program")
+            {
+                finish();
+                if (tok.size() < 2)
+                    fail(line_no, ".program without name");
+                p = &programs[tok[1]];
+                p->name = tok[1];
+                p->wrap = -1;
+                wrap_target_next = false;
+            }
+            else if (d == ".pio_version" || d == ".lang_opt")
+            {
+                // no influence on the instruction encoding of the supported subset
+            }
+            else if (d == ".define")
+            {
+                size_t i = 1;
+                if (i < tok.size() && lower(tok[i]) == "public")
+                    ++i;
+                if (i + 1 >= tok.size())
+                    fail(line_no, "malformed .define");
+                auto &defs = p ? p->defines : global_defines;
+                std::map<std::string, int> symbols = global_defines;
+                if (p)
+                    symbols.insert(p->defines.begin(), p->defines.end());
+                defs[tok[i]] = value(tok[i + 1], symbols, line_no);
+            }
+            else if (!p)
+            {
+                fail(line_no, tok[0] + " outside of a program");
+            }
+            else if (d == ".side_set")
+            {
+                if (tok.size() < 2)
+                    fail(line_no, "malformed .side_set");
+                p->sideset_bits = value(tok[1], p->defines, line_no);
+                for (size_t i = 2; i < tok.size(); ++i)
+                {
+                    if (lower(tok[i]) == "opt")
+                        p->sideset_opt = true;
+                    else if (lower(tok[i]) != "pindirs")
+                        fail(line_no, "unknown .side_set option '" + tok[i] + "'");
+                }
+                p->sideset_bits += p->sideset_opt ? 1 : 0;
+                if (p->sideset_bits > 5)
+                    fail(line_no, "too many side-set bits");
+            }
+            else if (d == ".wrap_target")
+            {
+                wrap_target_next = true;
+            }
+            else if (d == ".wrap")
+            {
+                if (lines.empty())
+                    fail(line_no, ".wrap before the first instruction");
+                p->wrap = (int)lines.size() - 1;
+            }
+            else
+            {
+                fail(line_no, "unsupported directive " + tok[0]);
+            }
+            continue;
+        }
+
+        if (!p)
+            fail(line_no, "instruction outside of a program");
+
+        // Labels, optionally public and optionally followed by an instruction
+        size_t i = 0;
+        if (lower(tok[0]) == "public")
+            ++i;
+        if (i < tok.size() && tok[i].back() == ':')
+        {
+            p->labels[tok[i].substr(0, tok[i].size() - 1)] = (int)lines.size();
+            tok.erase(tok.begin(), tok.begin() + i + 1);
+            if (tok.empty())
+                continue;
+        }
+
+        line_t l{line_no, {}, false, {}, {}};
+        std::string rest;
+        for (const auto &t : tok)
+            rest += t + " ";
+
+        // [delay]
+        size_t lb = rest.find('[');
+        if (lb != std::string::npos)
+        {
+            size_t rb = rest.find(']', lb);
+            if (rb == std::string::npos)
+                fail(line_no, "unterminated delay");
+            l.delay = rest.substr(lb + 1, rb - lb - 1);
+            l.delay.erase(0, l.delay.find_first_not_of(' '));
+            l.delay.erase(l.delay.find_last_not_of(' ') + 1);
+            rest.erase(lb, rb - lb + 1);
+        }
+        for (char &c : rest)
+            if (c == ',')
+                c = ' ';
+        std::vector<std::string> parts = split(rest);
+        for (size_t k = 0; k < parts.size(); ++k)
+        {
+            const std::string w = lower(parts[k]);
+            if (w == "side" || w == "sideset")
+            {
+                if (k + 1 >= parts.size())
+                    fail(line_no, "side without value");
+                l.has_side = true;
+                l.side = parts[k + 1];
+                parts.erase(parts.begin() + k, parts.begin() + k + 2);
+                break;
+            }
+        }
+        if (wrap_target_next)
+        {
+            p->wrap_target = (int)lines.size();
+            wrap_target_next = false;
+        }
+        l.tokens = parts;
+        lines.push_back(l);
+    }
+    finish();
+    return programs;
+}
+
+inline std::map<std::string, pio_program_t> pio_assemble_file(const std::string &path)
+{
+    std::ifstream f(path);
+    if (!f)
+        throw std::runtime_error("cannot open " + path);
+    std::stringstream ss;
+    ss << f.rdbuf();
+    try
+    {
+        return pio_assemble(ss.str());
+    }
+    catch (const std::runtime_error &e)
+    {
+        throw std::runtime_error(path + ": " + e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------
+// State machines
+// ---------------------------------------------------------------------------
+
+struct pio_fifo_t
+{
+    uint32_t data[8] = {};
+    int head = 0;
+    int count = 0;
+    int depth = 4;
+    uint64_t pushes = 0;
+
+    bool full() const { return count >= depth; }
+    bool empty() const { return count == 0; }
+
+    void push(uint32_t v)
+    {
+        data[(head + count) & 7] = v;
+        ++count;
+        ++pushes;
+    }
+
+    uint32_t pop()
+    {
+        uint32_t v = data[head];
+        head = (head + 1) & 7;
+        --count;
+        return v;
+    }
+};
+
+enum pio_stall_t
+{
+    STALL_NONE,
+    STALL_TX_EMPTY, ///< pull / autopull on an empty TX FIFO
+    STALL_RX_FULL,  ///< push / autopush into a full RX FIFO
+    STALL_WAIT_IRQ, ///< wait irq
+    STALL_WAIT_PIN, ///< wait gpio / wait pin
+    STALL_IRQ_WAIT, ///< irq wait until the flag is cleared
+    STALL_COUNT
+};
+
+struct pio_block_t;
+
+struct pio_sm_t
+{
+    // Configuration
+    std::vector<uint16_t> code; ///< program at offset 0 - may be patched while running
+    int wrap_target = 0;
+    int wrap = 31;
+    int sideset_bits = 0;
+    bool sideset_opt = false;
+    bool out_shift_right = true;
+    bool autopull = false;
+    int pull_threshold = 32;
+    bool in_shift_right = true;
+    bool autopush = false;
+    int push_threshold = 32;
+    int out_count = 32; ///< pins driven by out pins / mov pins
+    int set_count = 5;
+    int in_base = 0; ///< first GPIO of wait pin / in pins
+    int jmp_pin = 0;
+    uint32_t clkdiv_256 = 256; ///< clock divider, 8 fractional bits
+    bool enabled = false;
+
+    // State
+    int pc = 0;
+    uint32_t x = 0, y = 0;
+    uint32_t osr = 0, isr = 0;
+    int osr_count = 32; ///< 32 == empty
+    int isr_count = 0;
+    int delay = 0;
+    bool irq_wait_pending = false;
+    int exec_instr = -1; ///< instruction forced by exec(), runs on the next cycle
+    uint32_t clk_acc = 0;
+    pio_fifo_t tx, rx;
+
+    // Outputs
+    uint32_t out_pins = 0;
+    uint32_t side_pins = 0;
+    uint32_t set_pins = 0;
+
+    // Statistics (in state machine cycles)
+    uint64_t cycles = 0;
+    pio_stall_t stalled = STALL_NONE;
+    uint64_t stall_cycles[STALL_COUNT] = {};
+    uint64_t stall_events[STALL_COUNT] = {};
+
+    void load(const pio_program_t &p)
+    {
+        code = p.code;
+        wrap_target = p.wrap_target;
+        wrap = p.wrap;
+        sideset_bits = p.sideset_bits;
+        sideset_opt = p.sideset_opt;
+        pc = 0;
+    }
+
+    void set_clkdiv(double div)
+    {
+        clkdiv_256 = (uint32_t)(div * 256.0 + 0.5);
+        if (clkdiv_256 < 256)
+            clkdiv_256 = 256;
+    }
+
+    void join_tx()
+    {
+        tx.depth = 8;
+        rx.depth = 0;
+    }
+
+    void join_rx()
+    {
+        rx.depth = 8;
+        tx.depth = 0;
+    }
+
+    /// pio_sm_exec(): run instr once instead of the next program instruction
+    void exec(uint16_t instr)
+    {
+        exec_instr = instr;
+    }
+};
+
+struct pio_block_t
+{
+    pio_sm_t sm[4];
+    uint8_t irq = 0;
+    std::function<bool(int)> gpio_in; ///< input level of a GPIO for wait gpio / wait pin / jmp pin
+
+    /// Advance all enabled state machines by one system clock
+    void tick()
+    {
+        irq_set = irq_clear = 0;
+        for (int n = 0; n < 4; ++n)
+        {
+            pio_sm_t &s = sm[n];
+            if (!s.enabled)
+                continue;
+            s.clk_acc += 256;
+            if (s.clk_acc < s.clkdiv_256)
+                continue;
+            s.clk_acc -= s.clkdiv_256;
+            step(n);
+        }
+        irq = (uint8_t)((irq | irq_set) & ~irq_clear);
+    }
+
+private:
+    uint8_t irq_set = 0;
+    uint8_t irq_clear = 0;
+
+    static uint32_t mask(int bits)
+    {
+        return bits >= 32 ? 0xffffffffu : ((1u << bits) - 1u);
+    }
+
+    static int irq_num(int sm, uint32_t index)
+    {
+        return (index & 0x10) ? (int)((index & 4) | ((index + sm) & 3)) : (int)(index & 7);
+    }
+
+    bool pin(int gpio) const
+    {
+        return gpio_in ? gpio_in(gpio) : false;
+    }
+
+    static void refill(pio_sm_t &s)
+    {
+        s.osr = s.tx.pop();
+        s.osr_count = 0;
+    }
+
+    static void stall(pio_sm_t &s, pio_stall_t why)
+    {
+        if (s.stalled != why)
+            s.stall_events[why]++;
+        s.stalled = why;
+        s.stall_cycles[why]++;
+    }
+
+    void step(int n)
+    {
+        pio_sm_t &s = sm[n];
+        s.cycles++;
+
+        if (s.delay)
+        {
+            s.delay--;
+            return;
+        }
+
+        const bool forced = s.exec_instr >= 0;
+        const uint16_t instr = forced ? (uint16_t)s.exec_instr : s.code[s.pc];
+        s.exec_instr = -1;
+        const uint32_t field = (instr >> 8) & 31u;
+        const int delay_bits = 5 - s.sideset_bits;
+
+        // Side-set takes effect as the instruction issues, even if it then stalls
+        if (s.sideset_bits)
+        {
+            const int value_bits = s.sideset_bits - (s.sideset_opt ? 1 : 0);
+            if (!s.sideset_opt || (field & 0x10u))
+                s.side_pins = (field >> delay_bits) & mask(value_bits);
+        }
+
+        const uint32_t op = instr >> 13;
+        const uint32_t a = (instr >> 5) & 7u;
+        const uint32_t b = instr & 31u;
+        bool jumped = false;
+
+        switch (op)
+        {
+        case 0: // JMP
+        {
+            bool take = true;
+            switch (a)
+            {
+            case 1: take = s.x == 0; break;
+            case 2: take = s.x != 0; s.x--; break;
+            case 3: take = s.y == 0; break;
+            case 4: take = s.y != 0; s.y--; break;
+            case 5: take = s.x != s.y; break;
+            case 6: take = pin(s.jmp_pin); break;
+            case 7: take = s.osr_count < s.pull_threshold; break;
+            }
+            if (take)
+            {
+                s.pc = (int)b;
+                jumped = true;
+            }
+            break;
+        }
+        case 1: // WAIT
+        {
+            const bool polarity = (instr >> 7) & 1u;
+            const uint32_t src = (instr >> 5) & 3u;
+            if (src == 2)
+            {
+                const int num = irq_num(n, b);
+                const bool set = (irq >> num) & 1u;
+                if (set != polarity)
+                    return stall(s, STALL_WAIT_IRQ);
+                if (polarity)
+                    irq_clear |= (uint8_t)(1u << num);
+            }
+            else
+            {
+                const int gpio = src == 1 ? (s.in_base + (int)b) & 31 : (int)b;
+                if (pin(gpio) != polarity)
+                    return stall(s, STALL_WAIT_PIN);
+            }
+            break;
+        }
+        case 2: // IN
+        {
+            const int bits = b ? (int)b : 32;
+            if (s.autopush && s.isr_count + bits >= s.push_threshold && s.rx.full())
+                return stall(s, STALL_RX_FULL);
+            uint32_t data = 0;
+            switch (a)
+            {
+            case 0:
+                for (int k = 0; k < bits; ++k)
+                    data |= (uint32_t)pin((s.in_base + k) & 31) << k;
+                break;
+            case 1: data = s.x; break;
+            case 2: data = s.y; break;
+            case 3: data = 0; break;
+            case 6: data = s.isr; break;
+            case 7: data = s.osr; break;
+            default: throw std::runtime_error("unsupported IN source");
+            }
+            data &= mask(bits);
+            if (s.in_shift_right)
+                s.isr = (bits == 32 ? 0 : s.isr >> bits) | (bits == 32 ? data : data << (32 - bits));
+            else
+                s.isr = (bits == 32 ? 0 : s.isr << bits) | data;
+            s.isr_count = std::min(32, s.isr_count + bits);
+            if (s.autopush && s.isr_count >= s.push_threshold)
+            {
+                s.rx.push(s.isr);
+                s.isr = 0;
+                s.isr_count = 0;
+            }
+            break;
+        }
+        case 3: // OUT
+        {
+            const int bits = b ? (int)b : 32;
+            if (s.autopull && s.osr_count >= s.pull_threshold)
+            {
+                if (s.tx.empty())
+                    return stall(s, STALL_TX_EMPTY);
+                refill(s);
+            }
+            uint32_t data;
+            if (s.out_shift_right)
+            {
+                data = s.osr & mask(bits);
+                s.osr = bits == 32 ? 0 : s.osr >> bits;
+            }
+            else
+            {
+                data = bits == 32 ? s.osr : s.osr >> (32 - bits);
+                s.osr = bits == 32 ? 0 : s.osr << bits;
+            }
+            s.osr_count = std::min(32, s.osr_count + bits);
+            switch (a)
+            {
+            case 0: s.out_pins = data & mask(s.out_count); break;
+            case 1: s.x = data; break;
+            case 2: s.y = data; break;
+            case 3: break;
+            case 4: break; // pindirs
+            case 5: s.pc = (int)(data & 31u); jumped = true; break;
+            case 6:
+                s.isr = data;
+                s.isr_count = bits;
+                break;
+            default: throw std::runtime_error("unsupported OUT destination");
+            }
+            // Autopull refills in the background as soon as the OSR runs empty
+            if (s.autopull && s.osr_count >= s.pull_threshold && !s.tx.empty())
+                refill(s);
+            break;
+        }
+        case 4: // PUSH / PULL
+        {
+            const bool is_pull = (instr >> 7) & 1u;
+            const bool conditional = (instr >> 6) & 1u;
+            const bool block = (instr >> 5) & 1u;
+            if (is_pull)
+            {
+                // With autopull a PULL on a full OSR is a no-op (fence)
+                if (s.autopull && s.osr_count == 0)
+                    break;
+                if (conditional && s.osr_count < s.pull_threshold)
+                    break;
+                if (s.tx.empty())
+                {
+                    if (block)
+                        return stall(s, STALL_TX_EMPTY);
+                    s.osr = s.x;
+                    s.osr_count = 0;
+                }
+                else
+                {
+                    refill(s);
+                }
+            }
+            else
+            {
+                if (conditional && s.isr_count < s.push_threshold)
+                    break;
+                if (s.rx.full())
+                {
+                    if (block)
+                        return stall(s, STALL_RX_FULL);
+                }
+                else
+                {
+                    s.rx.push(s.isr);
+                }
+                s.isr = 0;
+                s.isr_count = 0;
+            }
+            break;
+        }
+        case 5: // MOV
+        {
+            const uint32_t src = instr & 7u;
+            const uint32_t mop = (instr >> 3) & 3u;
+            uint32_t data = 0;
+            switch (src)
+            {
+            case 0: data = 0; break;
+            case 1: data = s.x; break;
+            case 2: data = s.y; break;
+            case 3: data = 0; break;
+            case 6: data = s.isr; break;
+            case 7: data = s.osr; break;
+            default: throw std::runtime_error("unsupported MOV source");
+            }
+            if (mop == 1)
+                data = ~data;
+            else if (mop == 2)
+            {
+                uint32_t r = 0;
+                for (int k = 0; k < 32; ++k)
+                    r |= ((data >> k) & 1u) << (31 - k);
+                data = r;
+            }
+            switch (a)
+            {
+            case 0: s.out_pins = data & mask(s.out_count); break;
+            case 1: s.x = data; break;
+            case 2: s.y = data; break;
+            case 5: s.pc = (int)(data & 31u); jumped = true; break;
+            case 6:
+                s.isr = data;
+                s.isr_count = 0;
+                break;
+            case 7:
+                s.osr = data;
+                s.osr_count = 0;
+                break;
+            default: throw std::runtime_error("unsupported MOV destination");
+            }
+            break;
+        }
+        case 6: // IRQ
+        {
+            const bool clr = (instr >> 6) & 1u;
+            const bool wait = (instr >> 5) & 1u;
+            const int num = irq_num(n, b);
+            if (clr)
+            {
+                irq_clear |= (uint8_t)(1u << num);
+            }
+            else if (wait)
+            {
+                if (!s.irq_wait_pending)
+                {
+                    irq_set |= (uint8_t)(1u << num);
+                    s.irq_wait_pending = true;
+                    return stall(s, STALL_IRQ_WAIT);
+                }
+                if ((irq >> num) & 1u)
+                    return stall(s, STALL_IRQ_WAIT);
+                s.irq_wait_pending = false;
+            }
+            else
+            {
+                irq_set |= (uint8_t)(1u << num);
+            }
+            break;
+        }
+        case 7: // SET
+            switch (a)
+            {
+            case 0: s.set_pins = b & mask(s.set_count); break;
+            case 1: s.x = b; break;
+            case 2: s.y = b; break;
+            case 4: break; // pindirs
+            default: throw std::runtime_error("unsupported SET destination");
+            }
+            break;
+        }
+
+        s.stalled = STALL_NONE;
+        if (!jumped && !forced)
+            s.pc = (s.pc == s.wrap) ? s.wrap_target : (s.pc + 1) & 31;
+        s.delay = (int)(field & mask(delay_bits));
+    }
+};
+
+// ---------------------------------------------------------------------------
+// DMA
+// ---------------------------------------------------------------------------
+
+struct dma_channel_t
+{
+    int data_size = 4; ///< bytes per transfer (1, 2, 4 - or sizeof(void *) for host pointer reloads)
+    const uint8_t *read_addr = nullptr;
+    bool read_increment = true;
+    uint8_t *write_addr = nullptr;
+    bool write_increment = true;
+    pio_fifo_t *read_fifo = nullptr;  ///< source is a PIO RX FIFO instead of read_addr
+    pio_fifo_t *write_fifo = nullptr; ///< destination is a PIO TX FIFO instead of write_addr
+    uint32_t trans_count = 0;         ///< reload value used when the channel is triggered
+    int chain_to = -1;
+    std::function<void()> on_complete; ///< e.g. schedules the IRQ handler
+
+    // State
+    bool busy = false;
+    uint32_t remaining = 0; ///< transfers not yet issued
+    int in_flight = 0;
+    uint64_t transfers = 0;
+};
+
+struct dma_t
+{
+    std::vector<dma_channel_t> ch;
+    int latency = 4;             ///< cycles from issuing a transfer until it lands
+    std::function<bool()> bus_busy; ///< returns true on cycles where the DMA loses the bus
+    uint64_t now = 0;
+    uint64_t busy_cycles = 0; ///< cycles a transfer was ready but the bus was busy
+
+    explicit dma_t(int channels = 12) : ch(channels) {}
+
+    /// Trigger a channel; re-triggering a busy channel has no effect, like on the device
+    void start(int c)
+    {
+        dma_channel_t &d = ch[c];
+        if (d.busy)
+            return;
+        d.busy = true;
+        d.remaining = d.trans_count;
+        if (d.remaining == 0)
+            complete(c);
+    }
+
+    void tick()
+    {
+        now++;
+
+        // Land transfers issued `latency` cycles ago
+        while (!pending.empty() && pending.front().when <= now)
+        {
+            transfer_t t = pending.front();
+            pending.pop_front();
+            dma_channel_t &d = ch[t.chan];
+            if (d.write_fifo)
+            {
+                uint32_t v = (uint32_t)t.value;
+                if (d.data_size == 1)
+                    v = (v & 0xffu) * 0x01010101u; // byte lanes are replicated on the bus
+                else if (d.data_size == 2)
+                    v = (v & 0xffffu) * 0x00010001u;
+                d.write_fifo->push(v);
+            }
+            else
+            {
+                memcpy(t.dst, &t.value, d.data_size);
+            }
+            d.in_flight--;
+            if (d.remaining == 0 && d.in_flight == 0)
+                complete(t.chan);
+        }
+
+        // Issue at most one transfer per cycle, round robin
+        const int n = (int)ch.size();
+        for (int k = 0; k < n; ++k)
+        {
+            const int c = (rr + k) % n;
+            dma_channel_t &d = ch[c];
+            if (!d.busy || d.remaining == 0)
+                continue;
+            if (d.write_fifo && d.write_fifo->count + d.in_flight >= d.write_fifo->depth)
+                continue;
+            if (d.read_fifo && d.read_fifo->empty())
+                continue;
+            if (bus_busy && bus_busy())
+            {
+                busy_cycles++;
+                break;
+            }
+
+            transfer_t t{now + (uint64_t)latency, c, 0, d.write_addr};
+            if (d.read_fifo)
+            {
+                t.value = d.read_fifo->pop();
+            }
+            else
+            {
+                memcpy(&t.value, d.read_addr, d.data_size);
+                if (d.read_increment)
+                    d.read_addr += d.data_size;
+            }
+            if (!d.write_fifo && d.write_increment)
+                d.write_addr += d.data_size;
+            d.remaining--;
+            d.in_flight++;
+            d.transfers++;
+            pending.push_back(t);
+            rr = (c + 1) % n;
+            break;
+        }
+    }
+
+private:
+    struct transfer_t
+    {
+        uint64_t when;
+        int chan;
+        uint64_t value;
+        uint8_t *dst;
+    };
+    std::deque<transfer_t> pending;
+    int rr = 0;
+
+    void complete(int c)
+    {
+        dma_channel_t &d = ch[c];
+        d.busy = false;
+        if (d.on_complete)
+            d.on_complete();
+        if (d.chain_to >= 0 && d.chain_to != c)
+            start(d.chain_to);
+    }
+};
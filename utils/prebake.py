@@ -0,0 +1,270 @@
+"""Pre-bake an image into the exact HUB75 frame_buffer bitplane image.
+
+The result is presented with hub75_show_prebaked() / hub75_show_prebaked_in_place()
+without any per-frame CPU work: no rotation lookup, no CIE LUT, no CCM and no
+bitplane extraction on the device.
+
+The configuration given on the command line must match the defines the firmware
+is built with (see CMakeLists.txt). The asset header records the geometry and the
+colour depth, and the driver refuses assets baked for a different layout.
+The CIE LUT and CCM settings are baked into the pixel data and are not checked.
+
+Usage examples:
+    python utils/prebake.py --bgr-header examples/taylor_swift_64x64.h -o taylor_prebaked.h
+    python utils/prebake.py --image logo.png --width 64 --height 32 --rowsel-pins 4 -o logo_prebaked.h
+"""
+
+import argparse
+import os
+import re
+import struct
+from sys import stdout
+
+# Must match include/hub75.hpp
+ROW_MAP_STANDARD = 0
+ROW_MAP_SPLIT = 1
+ROW_MAP_S31 = 2
+
+CHAIN_MODE_SERPENTINE = 0
+CHAIN_MODE_RASTER = 1
+
+# Must match hub75_prebaked_header_t in include/hub75.hpp
+PREBAKED_MAGIC = 0x50353748  # 'H75P'
+PREBAKED_VERSION = 1
+PREBAKED_HEADER = "<IHHHHBBBBBBBBIII"
+PREBAKED_HEADER_SIZE = struct.calcsize(PREBAKED_HEADER)
+
+# Must match BCM_SEQUENCE in src/hub75.cpp
+BCM_SEQUENCES = {
+    (10, True): [9, 0, 8, 1, 9, 2, 7, 3, 9, 4, 8, 5, 9, 6],
+    (10, False): [0, 9, 2, 7, 4, 5, 1, 8, 3, 6],
+    (8, True): [7, 0, 6, 1, 7, 2, 5, 3, 7, 4, 6],
+    (8, False): [0, 7, 2, 5, 1, 6, 3, 4],
+}
+
+CCM_TERMS = ["RG", "RB", "GR", "GB", "BR", "BG"]
+
+
+def load_cie_tables(path, bitplanes, separate):
+    """Return (red, green, blue) LUTs exactly as compiled from src/cie.hpp."""
+    text = open(path).read()
+    tables = [
+        [int(v) for v in re.findall(r"\d+", body)]
+        for body in re.findall(r"static const uint16_t \w+\[256\] = \{([^}]*)\}", text)
+    ]
+    # cie.hpp layout: separate 10 (R, G, B), separate 8 (R, G, B), shared 10, shared 8
+    assert len(tables) == 8 and all(len(t) == 256 for t in tables), "unexpected cie.hpp layout"
+    if separate:
+        base = 0 if bitplanes == 10 else 3
+        return tables[base], tables[base + 1], tables[base + 2]
+    shared = tables[6] if bitplanes == 10 else tables[7]
+    return shared, shared, shared
+
+
+def make_pack(cfg):
+    """Return pack(r, g, b) -> 30-bit rgb_buffer word, mirroring pack_lut_rgb_()."""
+    red, green, blue = load_cie_tables(cfg.cie, cfg.bitplanes, cfg.separate_cie)
+    max_val = 1023 if cfg.bitplanes == 10 else 255
+    s = {k: getattr(cfg, "ccm_" + k.lower()) for k in CCM_TERMS}
+
+    def shr(v, n):
+        return v >> n if n < 32 else 0
+
+    def pack(r, g, b):
+        rv, gv, bv = red[r], green[g], blue[b]
+        r_out = min(rv + shr(gv, s["RG"]) + shr(bv, s["RB"]), max_val)
+        g_out = min(gv + shr(rv, s["GR"]) + shr(bv, s["GB"]), max_val)
+        b_out = min(bv + shr(rv, s["BR"]) + shr(gv, s["BG"]), max_val)
+        return (b_out << 20) | (g_out << 10) | r_out
+
+    return pack
+
+
+def scan_slot_index(cfg, sx, sy):
+    """Screen coordinate -> rgb_buffer slot, mirroring scan_slot_index() in src/hub75.cpp."""
+    pw, ph = cfg.width, cfg.height
+    dw, dh = pw * cfg.chain_cols, ph * cfg.chain_rows
+    scan_depth = 1 << cfg.rowsel_pins
+    rip = ph // scan_depth
+
+    if cfg.rotation == 90:
+        dx, dy = dw - 1 - sy, sx
+    elif cfg.rotation == 180:
+        dx, dy = dw - 1 - sx, dh - 1 - sy
+    elif cfg.rotation == 270:
+        dx, dy = sy, dh - 1 - sx
+    else:
+        dx, dy = sx, sy
+
+    if cfg.row_mapping == ROW_MAP_SPLIT and cfg.chain_cols == 1 and cfg.chain_rows == 1:
+        column_pairs = pw >> 1
+        half_pairs = column_pairs >> 1
+        group_row_offset = (ph // scan_depth) * pw
+        half_panel_offset = (ph >> 1) * pw
+        index = dy * pw + dx
+        lower_half = int(index >= half_panel_offset)
+        if lower_half:
+            index -= half_panel_offset
+        upper_group = int(index >= group_row_offset)
+        if upper_group:
+            index -= group_row_offset
+        line = index // half_pairs
+        j = line * column_pairs + upper_group * half_pairs + index % half_pairs
+        return (j << 1) + lower_half
+
+    v, phys_h = dy // ph, dx // pw
+    local_y, i, h = dy % ph, dx % pw, phys_h
+    if cfg.chain_mode == CHAIN_MODE_SERPENTINE and (v & 1):
+        local_y, i, h = ph - 1 - local_y, pw - 1 - i, cfg.chain_cols - 1 - phys_h
+
+    row, p = local_y % scan_depth, local_y // scan_depth
+    chunk_base = ((row * cfg.chain_rows + v) * cfg.chain_cols + h) * (pw * rip)
+
+    if cfg.row_mapping == ROW_MAP_S31:
+        pair_base = 0 if (p & 1) else pw << 1
+        return chunk_base + pair_base + (i << 1) + (p >> 1)
+    return chunk_base + i * rip + p
+
+
+def screen_size(cfg):
+    dw, dh = cfg.width * cfg.chain_cols, cfg.height * cfg.chain_rows
+    return (dh, dw) if cfg.rotation in (90, 270) else (dw, dh)
+
+
+def build_rgb_buffer(cfg, pixels):
+    """pixels: row-major list of (r, g, b) in screen coordinates."""
+    sw, sh = screen_size(cfg)
+    pack = make_pack(cfg)
+    rgb_buffer = [0] * (sw * sh)
+    for y in range(sh):
+        for x in range(sw):
+            rgb_buffer[scan_slot_index(cfg, x, y)] = pack(*pixels[y * sw + x])
+    return rgb_buffer
+
+
+def build_frame_buffer(cfg, rgb_buffer):
+    """Emulate hub75_bitplane_setup for every BCM slice.
+
+    Each output byte packs one pixel pair as 00 B1 G1 R1 B0 G0 R0,
+    taken from bit `shift` of each 10-bit colour field.
+    """
+    sequence = BCM_SEQUENCES[(cfg.bitplanes, cfg.balanced)]
+    out = bytearray()
+    for shift in sequence:
+        for j in range(0, len(rgb_buffer), 2):
+            byte = 0
+            for k, word in enumerate((rgb_buffer[j], rgb_buffer[j + 1])):
+                word >>= shift
+                byte |= ((word & 1) | ((word >> 10) & 1) << 1 | ((word >> 20) & 1) << 2) << (3 * k)
+            out.append(byte)
+    return bytes(out), len(sequence)
+
+
+def make_header(cfg, sequence_length, data_size):
+    dw, dh = cfg.width * cfg.chain_cols, cfg.height * cfg.chain_rows
+    return struct.pack(
+        PREBAKED_HEADER,
+        PREBAKED_MAGIC,
+        PREBAKED_VERSION,
+        PREBAKED_HEADER_SIZE,
+        dw,
+        dh,
+        cfg.bitplanes,
+        sequence_length,
+        cfg.row_mapping,
+        cfg.rowsel_pins,
+        cfg.chain_rows,
+        cfg.chain_cols,
+        cfg.chain_mode,
+        cfg.rotation // 90,
+        (dw * dh) >> 1,
+        data_size,
+        0,
+    )
+
+
+def read_bgr_header(path):
+    """Read a BGR byte array as used by update_bgr() (e.g. examples/taylor_swift_64x64.h)."""
+    text = open(path).read()
+    body = text[text.index("{") + 1 : text.rindex("}")]
+    data = [int(v, 0) for v in re.findall(r"0x[0-9a-fA-F]+|\d+", body)]
+    return [(data[k + 2], data[k + 1], data[k]) for k in range(0, len(data) - 2, 3)]
+
+
+def read_image(path, size):
+    from PIL import Image  # only needed for image files
+
+    img = Image.open(path).convert("RGB")
+    if img.size != size:
+        img = img.resize(size)
+    return list(img.getdata())
+
+
+def write_c_header(f, name, source, cfg, blob):
+    f.write('#include "pico.h"\n')
+    f.write(f"// Pre-baked HUB75 frame_buffer image of {os.path.basename(source)}\n")
+    f.write("// Generated by utils/prebake.py - do not edit manually.\n")
+    f.write(
+        f"// {cfg.width}x{cfg.height} panel, CHAIN_ROWS={cfg.chain_rows}, CHAIN_COLS={cfg.chain_cols}, "
+        f"ROW_MAPPING={cfg.row_mapping}, ROWSEL_N_PINS={cfg.rowsel_pins}, DISPLAY_ROTATION={cfg.rotation}, "
+        f"BITPLANES={cfg.bitplanes}, BALANCED_LIGHT_OUTPUT={'true' if cfg.balanced else 'false'}\n"
+    )
+    f.write(f"static const uint8_t __attribute__((aligned(4))) {name}[] = {{")
+    for i, v in enumerate(blob):
+        if i % 24 == 0:
+            f.write("\n")
+        f.write("0x%02x, " % v)
+    f.write("\n};\n")
+
+
+def str2bool(s):
+    return s.lower() in ("1", "true", "yes", "on")
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Pre-bake an image into a HUB75 frame_buffer asset")
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument("--image", help="image file (requires Pillow), resized to the screen size")
+    src.add_argument("--bgr-header", help="C header holding a BGR byte array as used by update_bgr()")
+    ap.add_argument("-o", "--output", help="output file (.h for a C array, anything else for raw binary)")
+    ap.add_argument("--name", help="C array name (default: derived from the output file name)")
+    ap.add_argument("--width", type=int, default=64, help="MATRIX_PANEL_WIDTH")
+    ap.add_argument("--height", type=int, default=64, help="MATRIX_PANEL_HEIGHT")
+    ap.add_argument("--chain-rows", type=int, default=1, help="CHAIN_ROWS")
+    ap.add_argument("--chain-cols", type=int, default=1, help="CHAIN_COLS")
+    ap.add_argument("--chain-mode", type=int, default=CHAIN_MODE_SERPENTINE, choices=[0, 1], help="CHAIN_MODE")
+    ap.add_argument("--row-mapping", type=int, default=ROW_MAP_STANDARD, choices=[0, 1, 2], help="ROW_MAPPING")
+    ap.add_argument("--rowsel-pins", type=int, default=5, help="ROWSEL_N_PINS")
+    ap.add_argument("--rotation", type=int, default=0, choices=[0, 90, 180, 270], help="DISPLAY_ROTATION")
+    ap.add_argument("--bitplanes", type=int, default=10, choices=[8, 10], help="BITPLANES")
+    ap.add_argument("--balanced", type=str2bool, default=True, help="BALANCED_LIGHT_OUTPUT")
+    ap.add_argument("--separate-cie", type=str2bool, default=False, help="SEPARATE_CIE_CHANNELS")
+    for term in CCM_TERMS:
+        ap.add_argument(f"--ccm-{term.lower()}", type=int, default=31, help=f"CCM_{term}_SHIFT")
+    ap.add_argument("--cie", default=os.path.join(os.path.dirname(__file__), "..", "src", "cie.hpp"), help="path to cie.hpp")
+    cfg = ap.parse_args()
+
+    sw, sh = screen_size(cfg)
+    pixels = read_bgr_header(cfg.bgr_header) if cfg.bgr_header else read_image(cfg.image, (sw, sh))
+    if len(pixels) != sw * sh:
+        ap.error(f"source has {len(pixels)} pixels, screen is {sw}x{sh}")
+
+    data, sequence_length = build_frame_buffer(cfg, build_rgb_buffer(cfg, pixels))
+    blob = make_header(cfg, sequence_length, len(data)) + data
+
+    source = cfg.image or cfg.bgr_header
+    if cfg.output and not cfg.output.endswith(".h"):
+        with open(cfg.output, "wb") as f:
+            f.write(blob)
+    else:
+        stem = os.path.splitext(os.path.basename(cfg.output or source))[0]
+        name = cfg.name or re.sub(r"\W", "_", stem)
+        if cfg.output:
+            with open(cfg.output, "w") as f:
+                write_c_header(f, name, source, cfg, blob)
+        else:
+            write_c_header(stdout, name, source, cfg, blob)
+
+
+if __name__ == "__main__":
+    main()
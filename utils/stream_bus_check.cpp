@@ -0,0 +1,524 @@
+// Checks the SPI and 8080 bus slaves of the frame stream (src/hub75.pio, src/hub75_stream.cpp) on a Linux host.
+//
+// Assembles src/hub75.pio with utils/pio_emu.h and runs hub75_spi_slave / hub75_parallel_slave
+// cycle by cycle against a host master that follows the READY handshake: wait for READY
+// high, assert CS, send at most STREAM_BUS_CHUNK bytes, release CS. Inputs reach the state
+// machine through the 2-cycle synchroniser. A DMA channel drains the RX FIFO into the ring;
+// a model of hub75_stream_poll() runs every POLL_US, feeds the ring to the firmware decoder
+// (src/hub75_stream_decoder.cpp), is busy DECODE_CYCLES per byte doing so (the bytes stay
+// in the ring until it is done) and then raises READY like the firmware (forced `nop side 1`).
+// After a present it decodes nothing for PENDING_US, while hub75_present_pending() is true.
+//
+// The stream is 128x64 content as full frames, dirty rectangles and RLE. Checked:
+//
+// - every presented frame matches what was sent, no decoder errors, the ring never overruns
+// - the documented bus clocks pass and give more than 60 full frames per second; one cycle
+//   less than the state machine needs fails
+// - a slow poll loop only slows the host down, while a host ignoring READY overruns the ring
+// - an SPI chunk cut off after 3 bits of a byte (the host resends the byte in its next chunk)
+//   stays aligned once the poll forces `jmp abort`, and is bit-shifted for good without it
+//
+//   g++ -O2 -std=c++17 -Iinclude -o stream_bus_check utils/stream_bus_check.cpp src/hub75_stream_decoder.cpp
+//   ./stream_bus_check
+//
+// Run from the repository root. Exit status: 0 ok, 1 failed.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "hub75_stream_decoder.h"
+#include "pio_emu.h"
+
+constexpr int WIDTH = 128;
+constexpr int HEIGHT = 64;
+constexpr uint32_t RING_SIZE = 1u << 14; // STREAM_RING_BITS
+constexpr uint32_t CHUNK = RING_SIZE / 2; // STREAM_BUS_CHUNK
+constexpr double POLL_US = 100;           // main loop period around hub75_stream_poll()
+constexpr double SLOW_POLL_US = 10000;    // ... in an application busy elsewhere
+constexpr uint32_t DECODE_CYCLES = 40;    // per byte: decoder plus hub75_write_rect_bgr(), ~120 cycles per pixel
+constexpr double HOST_LATENCY_US = 1;     // host reaction to READY
+constexpr double PENDING_US = 2000;       // present to swap: 128x64 bitplane build plus the wait for the frame boundary
+
+// SPI: MOSI, SCK, CS on GPIO 0..2; 8080: D0..D7, WR, CS on GPIO 0..9; READY is the side-set pin
+enum bus_t
+{
+    SPI,
+    PARALLEL
+};
+
+// ---------------------------------------------------------------------------
+// Stream content
+// ---------------------------------------------------------------------------
+
+static void put16(std::vector<uint8_t> &v, uint16_t x)
+{
+    v.push_back(x & 0xff);
+    v.push_back(x >> 8);
+}
+
+static void packet(std::vector<uint8_t> &out, uint8_t type, const std::vector<uint8_t> &payload, uint8_t flags = 0)
+{
+    out.push_back(STREAM_SYNC0);
+    out.push_back(STREAM_SYNC1);
+    out.push_back(type);
+    out.push_back(flags);
+    for (int k = 0; k < 4; ++k)
+        out.push_back((uint8_t)(payload.size() >> (8 * k)));
+    out.insert(out.end(), payload.begin(), payload.end());
+    uint16_t sum = 0;
+    for (uint8_t b : payload)
+        sum += b;
+    put16(out, sum);
+}
+
+static std::vector<uint8_t> rect_header(int x, int y, int w, int h)
+{
+    std::vector<uint8_t> p;
+    put16(p, x);
+    put16(p, y);
+    put16(p, w);
+    put16(p, h);
+    return p;
+}
+
+// Same encoding as utils/stream_send.py
+static void rle(std::vector<uint8_t> &out, const uint8_t *bgr, int n)
+{
+    int i = 0;
+    std::vector<int> literals;
+    auto flush = [&]() {
+        for (size_t k = 0; k < literals.size(); k += 128)
+        {
+            const size_t m = std::min<size_t>(128, literals.size() - k);
+            out.push_back((uint8_t)(m - 1));
+            for (size_t j = 0; j < m; ++j)
+                out.insert(out.end(), bgr + 3 * literals[k + j], bgr + 3 * literals[k + j] + 3);
+        }
+        literals.clear();
+    };
+    while (i < n)
+    {
+        int run = 1;
+        while (i + run < n && run < 128 && !memcmp(bgr + 3 * i, bgr + 3 * (i + run), 3))
+            ++run;
+        if (run >= 2)
+        {
+            flush();
+            out.push_back((uint8_t)(0x80 | (run - 1)));
+            out.insert(out.end(), bgr + 3 * i, bgr + 3 * i + 3);
+        }
+        else
+        {
+            literals.push_back(i);
+        }
+        i += run;
+    }
+    flush();
+}
+
+struct stream_t
+{
+    std::vector<uint8_t> bytes;
+    std::vector<std::vector<uint8_t>> frames; ///< BGR screen expected at each present
+    int full_frames = 0;
+};
+
+// Full frames of noise, dirty rectangles, RLE bands and separate present packets
+static stream_t make_stream(int full_frames)
+{
+    stream_t s;
+    std::mt19937 rng(49);
+    std::vector<uint8_t> screen(WIDTH * HEIGHT * 3, 0);
+
+    for (int f = 0; f < full_frames; ++f)
+    {
+        for (uint8_t &b : screen)
+            b = (uint8_t)rng();
+        packet(s.bytes, STREAM_FULL, screen, STREAM_FLAG_PRESENT);
+        s.frames.push_back(screen);
+        ++s.full_frames;
+
+        // A dirty rectangle, then an RLE band with a few edges, presented by a PRESENT packet
+        const int x = rng() % 64, y = rng() % 32, w = 1 + rng() % 64, h = 1 + rng() % 32;
+        std::vector<uint8_t> p = rect_header(x, y, w, h);
+        for (int r = 0; r < h; ++r)
+            for (int c = 0; c < w * 3; ++c)
+            {
+                const uint8_t v = (uint8_t)rng();
+                p.push_back(v);
+                screen[((y + r) * WIDTH + x) * 3 + c] = v;
+            }
+        packet(s.bytes, STREAM_RECT, p);
+
+        const int band = rng() % (HEIGHT - 8);
+        for (int k = band * WIDTH * 3; k < (band + 8) * WIDTH * 3; k += 3)
+        {
+            const uint8_t v = (k / 3) % WIDTH < WIDTH / 2 ? 0x20 : (uint8_t)(rng() & 0xc0);
+            screen[k] = v, screen[k + 1] = 0x40, screen[k + 2] = v;
+        }
+        p = rect_header(0, band, WIDTH, 8);
+        rle(p, &screen[band * WIDTH * 3], WIDTH * 8);
+        packet(s.bytes, STREAM_RLE, p);
+        packet(s.bytes, STREAM_PRESENT, {});
+        s.frames.push_back(screen);
+    }
+    return s;
+}
+
+// ---------------------------------------------------------------------------
+// Device side: decoder sink
+// ---------------------------------------------------------------------------
+
+static std::vector<uint8_t> screen(WIDTH * HEIGHT * 3);
+static std::vector<std::vector<uint8_t>> presented;
+static std::vector<uint64_t> present_cycle;
+static uint64_t now;
+static uint64_t pending_cycles;
+static uint64_t pending_until; ///< hub75_present_pending() is true before this cycle
+
+static void sink_write(int x, int y, int n, const uint8_t *bgr)
+{
+    memcpy(&screen[(y * WIDTH + x) * 3], bgr, n * 3);
+}
+
+static void sink_fill(int x, int y, int n, uint8_t b, uint8_t g, uint8_t r)
+{
+    for (int k = 0; k < n; ++k)
+    {
+        uint8_t *p = &screen[(y * WIDTH + x + k) * 3];
+        p[0] = b, p[1] = g, p[2] = r;
+    }
+}
+
+static void sink_present(void)
+{
+    presented.push_back(screen);
+    present_cycle.push_back(now);
+    pending_until = now + pending_cycles;
+}
+
+// ---------------------------------------------------------------------------
+// Simulation
+// ---------------------------------------------------------------------------
+
+struct result_t
+{
+    bool ok;
+    double mbyte_s;
+    double full_fps; ///< 128x64 full frames per second at the measured throughput
+    uint32_t overruns, errors, checksum_errors, mismatches;
+    uint32_t aborts, restarts; ///< chunks the host cut off mid-byte, forced `jmp abort`
+    double ready_low_pct; ///< time the host waited for READY
+};
+
+/**
+ * @param lo, hi      cycles per bus clock half: SCK low / high, WR low / high
+ * @param handshake   false: the host ignores READY
+ * @param abort_every SPI: cut every abort_every-th chunk off after 3 bits of its 100th byte, 0 = never
+ * @param restart     the poll forces `jmp abort` when it finds CS high in the middle of a byte
+ */
+static result_t run(const std::map<std::string, pio_program_t> &programs, bus_t bus, double clk_mhz, int lo, int hi, bool handshake,
+                    const stream_t &st, double poll_us = POLL_US, int abort_every = 0, bool restart = true)
+{
+    // Device
+    pio_block_t pio;
+    pio_sm_t &sm = pio.sm[0];
+    sm.load(programs.at(bus == SPI ? "hub75_spi_slave" : "hub75_parallel_slave"));
+    sm.in_base = 0;
+    sm.jmp_pin = 1; // SCK
+    sm.in_shift_right = false;
+    sm.autopush = true;
+    sm.push_threshold = 8;
+    sm.join_rx();
+    sm.enabled = true;
+
+    std::vector<uint8_t> received(st.bytes.size() + 64);
+    dma_t dma(1);
+    dma.ch[0].data_size = 1;
+    dma.ch[0].read_fifo = &sm.rx;
+    dma.ch[0].write_addr = received.data();
+    dma.ch[0].trans_count = (uint32_t)received.size();
+    dma.start(0);
+
+    const int cs_pin = bus == SPI ? 2 : 9;
+    uint32_t level[4] = {1u << cs_pin | (bus == PARALLEL ? 1u << 8 : 0), 0, 0, 0}; // host drives; CS and WR idle high
+    level[1] = level[2] = level[3] = level[0];
+    uint32_t bus_level = level[0];
+    pio.gpio_in = [&](int gpio) { return ((level[(now - 2) & 3] >> gpio) & 1u) != 0; }; // 2-cycle synchroniser
+
+    hub75_stream_decoder_t dec;
+    const hub75_stream_sink_t sink = {sink_write, sink_fill, sink_present};
+    hub75_stream_decoder_init(&dec, WIDTH, HEIGHT, &sink);
+    std::fill(screen.begin(), screen.end(), 0);
+    presented.clear();
+    present_cycle.clear();
+
+    const uint64_t poll_cycles = (uint64_t)(poll_us * clk_mhz);
+    const uint64_t host_latency = (uint64_t)(HOST_LATENCY_US * clk_mhz);
+    pending_cycles = (uint64_t)(PENDING_US * clk_mhz);
+    pending_until = 0;
+    uint32_t ring_read = 0, overruns = 0;
+    uint64_t next_poll = poll_cycles, poll_end = 0;
+    uint32_t decoding_to = 0; // poll in progress: bytes up to here are being decoded
+    bool polling = false;
+
+    // Host
+    enum
+    {
+        H_WAIT_READY,
+        H_REACT,
+        H_SETUP,
+        H_BIT_LO,
+        H_BIT_HI,
+        H_HOLD,
+        H_GAP
+    } hs = H_WAIT_READY;
+    size_t pos = 0, chunk_end = 0, abort_pos = SIZE_MAX;
+    uint32_t chunks = 0, aborts = 0, restarts = 0;
+    const int abort_label = bus == SPI ? programs.at("hub75_spi_slave").labels.at("abort") : 0;
+    int bit = 0, count = 0;
+    uint64_t first_byte = 0, wait_cycles = 0, last_byte = 0;
+    uint32_t last_produced = 0;
+
+    for (now = 0;; ++now)
+    {
+        // Host master, one step per system clock
+        const bool ready = (sm.side_pins & 1u) != 0;
+        switch (hs)
+        {
+        case H_WAIT_READY:
+            if (pos >= st.bytes.size())
+                break;
+            ++wait_cycles;
+            if (ready || !handshake)
+            {
+                hs = H_REACT;
+                count = (int)host_latency;
+            }
+            break;
+        case H_REACT:
+            if (--count <= 0)
+            {
+                bus_level &= ~(1u << cs_pin); // CS ↓
+                chunk_end = std::min(st.bytes.size(), pos + CHUNK);
+                if (abort_every && ++chunks % abort_every == 0 && pos + 100 < chunk_end)
+                    abort_pos = pos + 99;
+                if (!first_byte)
+                    first_byte = now;
+                hs = H_SETUP;
+                count = lo;
+            }
+            break;
+        case H_SETUP:
+            if (--count <= 0)
+            {
+                hs = H_BIT_LO;
+                bit = bus == SPI ? 7 : 0;
+                count = lo;
+                if (bus == SPI)
+                    bus_level = (bus_level & ~1u) | ((st.bytes[pos] >> bit) & 1u); // MOSI
+                else
+                    bus_level = (bus_level & ~0x1ffu) | st.bytes[pos];             // D0..D7, WR ↓
+            }
+            break;
+        case H_BIT_LO:
+            if (--count <= 0)
+            {
+                bus_level |= bus == SPI ? 2u : 0x100u; // SCK ↑ / WR ↑
+                hs = H_BIT_HI;
+                count = hi;
+            }
+            break;
+        case H_BIT_HI:
+            if (--count <= 0)
+            {
+                if (pos == abort_pos && bit == 5)
+                {
+                    // Cut off after 3 bits: SCK ↓, CS ↑, resend the whole byte in the next chunk
+                    bus_level &= ~2u;
+                    abort_pos = SIZE_MAX;
+                    ++aborts;
+                    hs = H_HOLD;
+                    count = lo;
+                    break;
+                }
+                if (bus == SPI && bit > 0)
+                    --bit;
+                else
+                {
+                    ++pos;
+                    bit = bus == SPI ? 7 : 0;
+                    if (pos == chunk_end)
+                    {
+                        if (bus == SPI)
+                            bus_level &= ~2u; // SCK ↓; WR stays high
+                        hs = H_HOLD;
+                        count = lo;
+                        break;
+                    }
+                }
+                hs = H_BIT_LO;
+                count = lo;
+                if (bus == SPI)
+                    bus_level = (bus_level & ~3u) | ((st.bytes[pos] >> bit) & 1u); // SCK ↓, next MOSI
+                else
+                    bus_level = (bus_level & ~0x1ffu) | st.bytes[pos];
+            }
+            break;
+        case H_HOLD:
+            if (--count <= 0)
+            {
+                bus_level |= 1u << cs_pin; // CS ↑
+                hs = H_GAP;
+                count = (int)host_latency;
+            }
+            break;
+        case H_GAP:
+            if (--count <= 0)
+                hs = H_WAIT_READY;
+            break;
+        }
+        level[now & 3] = bus_level;
+
+        pio.tick();
+        dma.tick();
+
+        const uint32_t produced = (uint32_t)(dma.ch[0].transfers - dma.ch[0].in_flight);
+        if (produced != last_produced)
+            last_produced = produced, last_byte = now;
+        if (produced - ring_read > RING_SIZE)
+        {
+            // The DMA lapped the poll - like the firmware, drop the lost bytes and resync
+            ++overruns;
+            ring_read = produced;
+            hub75_stream_decoder_reset(&dec);
+            polling = false;
+        }
+
+        // hub75_stream_poll(): decode up to the next present unless one is pending, stay busy DECODE_CYCLES
+        // per byte, then free the ring and raise READY
+        if (!polling && now >= next_poll)
+        {
+            decoding_to = ring_read;
+            if (now >= pending_until)
+                decoding_to += (uint32_t)hub75_stream_decoder_feed(&dec, &received[ring_read], produced - ring_read);
+            poll_end = now + (uint64_t)(decoding_to - ring_read) * DECODE_CYCLES;
+            polling = true;
+        }
+        if (polling && now >= poll_end)
+        {
+            polling = false;
+            ring_read = decoding_to;
+            next_poll = now + poll_cycles;
+            const bool cs_high = ((level[(now - 2) & 3] >> cs_pin) & 1u) != 0;
+            if (restart && bus == SPI && !ready && cs_high && sm.pc != 0)
+            {
+                sm.exec(abort_label); // pio_encode_jmp(offset + hub75_spi_slave_offset_abort); READY at the next poll
+                ++restarts;
+            }
+            else if (!ready && cs_high && RING_SIZE - (produced - ring_read) >= CHUNK)
+                sm.exec(0xa042 | 0x1800); // pio_encode_nop() | pio_encode_sideset_opt(1, 1)
+        }
+
+        // Done - or lost bytes the decoder still waits for
+        if (pos >= st.bytes.size() && hs == H_WAIT_READY && ring_read == produced && !polling &&
+            (produced >= st.bytes.size() || now - last_byte > poll_cycles * 4))
+            break;
+    }
+
+    result_t r{};
+    r.overruns = overruns;
+    r.aborts = aborts;
+    r.restarts = restarts;
+    r.errors = dec.stats.errors;
+    r.checksum_errors = dec.stats.checksum_errors;
+    for (size_t k = 0; k < st.frames.size(); ++k)
+        r.mismatches += k >= presented.size() || presented[k] != st.frames[k];
+    r.mismatches += presented.size() > st.frames.size() ? (uint32_t)(presented.size() - st.frames.size()) : 0;
+    r.ok = !r.overruns && !r.errors && !r.checksum_errors && !r.mismatches &&
+           !memcmp(received.data(), st.bytes.data(), st.bytes.size());
+
+    const double seconds = (double)((present_cycle.empty() ? now : present_cycle.back()) - first_byte) / (clk_mhz * 1e6);
+    r.mbyte_s = st.bytes.size() / seconds / 1e6;
+    r.full_fps = r.mbyte_s * 1e6 / (WIDTH * HEIGHT * 3 + 10);
+    r.ready_low_pct = 100.0 * wait_cycles / (now - first_byte);
+    return r;
+}
+
+static void print(const char *what, double clk_mhz, int lo, int hi, const result_t &r)
+{
+    printf("  %-10s %5.1f MHz  %2d+%-2d cycles (%5.2f MHz)  %5.2f MB/s  %6.1f full fps  waited %4.1f %%  "
+           "%u overruns, %u errors, %u bad frames  %s\n",
+           what, clk_mhz, lo, hi, clk_mhz / (lo + hi), r.mbyte_s, r.full_fps, r.ready_low_pct, r.overruns, r.errors + r.checksum_errors,
+           r.mismatches, r.ok ? "clean" : "corrupt");
+}
+
+int main()
+{
+    const auto programs = pio_assemble_file("src/hub75.pio");
+    const stream_t st = make_stream(4);
+    int failed = 0;
+
+    printf("%zu bytes: %d full 128x64 frames, dirty rectangles, RLE, %zu presents; chunks of %u bytes, ring %u bytes\n", st.bytes.size(),
+           st.full_frames, st.frames.size(), CHUNK, RING_SIZE);
+
+    // The documented limits pass with margin; just beyond what the program can sample it fails,
+    // so the limit is the state machine's and not the test's
+    printf("SPI mode 0, SCK up to clk_sys / 8\n");
+    for (double clk : {133.0, 150.0, 266.0})
+    {
+        const result_t r = run(programs, SPI, clk, 4, 4, true, st);
+        print("SCK", clk, 4, 4, r);
+        failed |= !r.ok || r.full_fps < 60;
+    }
+    for (int lo : {2, 1})
+    {
+        // Needs 2 cycles low and 3 high
+        const result_t r = run(programs, SPI, 266.0, lo, 5 - lo, true, st);
+        print("SCK", 266.0, lo, 5 - lo, r);
+        failed |= r.ok != (lo == 2);
+    }
+
+    printf("8080 parallel, write cycles of 3 + 3 clk_sys\n");
+    for (double clk : {133.0, 266.0})
+    {
+        const result_t r = run(programs, PARALLEL, clk, 3, 3, true, st);
+        print("WR", clk, 3, 3, r);
+        failed |= !r.ok || r.full_fps < 60;
+    }
+    for (int hi : {2, 1})
+    {
+        // Needs 2 cycles high
+        const result_t r = run(programs, PARALLEL, 266.0, 2, hi, true, st);
+        print("WR", 266.0, 2, hi, r);
+        failed |= r.ok != (hi == 2);
+    }
+
+    printf("hub75_stream_poll() every 10 ms\n");
+    {
+        const result_t r = run(programs, SPI, 266.0, 4, 4, true, st, SLOW_POLL_US);
+        print("SCK", 266.0, 4, 4, r);
+        failed |= !r.ok;
+    }
+    printf("hub75_stream_poll() every 10 ms, host ignoring READY\n");
+    {
+        const result_t r = run(programs, SPI, 266.0, 4, 4, false, st, SLOW_POLL_US);
+        print("SCK", 266.0, 4, 4, r);
+        failed |= r.overruns == 0;
+    }
+
+    printf("SPI chunks cut off mid-byte, every third chunk\n");
+    for (bool restart : {true, false})
+    {
+        const result_t r = run(programs, SPI, 266.0, 4, 4, true, st, POLL_US, 3, restart);
+        print(restart ? "jmp abort" : "no restart", 266.0, 4, 4, r);
+        printf("  %u chunks cut off, %u restarts\n", r.aborts, r.restarts);
+        failed |= restart ? !r.ok || !r.aborts || r.restarts != r.aborts : r.ok;
+    }
+
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+// Linux stand-in for the device side of the framed stream protocol.
+//
+// Runs the same decoder as the firmware (src/hub75_stream_decoder.cpp) on a serial
+// device, pseudo-terminal or recorded file and writes every presented frame as PPM.
+// Together with utils/stream_send.py this checks a sender without any hardware:
+//
+//   socat -d -d pty,raw,echo=0,link=/tmp/hub75_rx pty,raw,echo=0,link=/tmp/hub75_tx &
+//   g++ -O2 -Iinclude utils/stream_dump.cpp src/hub75_stream_decoder.cpp -o stream_dump
+//   ./stream_dump /tmp/hub75_rx 64 64 frame_ &
+//   python utils/stream_send.py /tmp/hub75_tx --bgr-header examples/taylor_swift_64x64.h
+//
+// Usage: stream_dump <port|file> <width> <height> [ppm prefix]
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "hub75_stream_decoder.h"
+
+static int width;
+static int height;
+static std::vector<uint8_t> screen; // RGB
+static const char *prefix = nullptr;
+
+static void sink_write(int x, int y, int n, const uint8_t *bgr)
+{
+    uint8_t *dst = &screen[(y * width + x) * 3];
+    for (int k = 0; k < n; ++k, bgr += 3, dst += 3)
+    {
+        dst[0] = bgr[2];
+        dst[1] = bgr[1];
+        dst[2] = bgr[0];
+    }
+}
+
+static void sink_fill(int x, int y, int n, uint8_t b, uint8_t g, uint8_t r)
+{
+    uint8_t *dst = &screen[(y * width + x) * 3];
+    for (int k = 0; k < n; ++k, dst += 3)
+    {
+        dst[0] = r;
+        dst[1] = g;
+        dst[2] = b;
+    }
+}
+
+static void sink_present(void)
+{
+    static int frame = 0;
+    if (prefix)
+    {
+        char name[256];
+        snprintf(name, sizeof(name), "%s%04d.ppm", prefix, frame);
+        FILE *f = fopen(name, "wb");
+        if (f)
+        {
+            fprintf(f, "P6\n%d %d\n255\n", width, height);
+            fwrite(screen.data(), 1, screen.size(), f);
+            fclose(f);
+        }
+    }
+    frame++;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "usage: %s <port|file> <width> <height> [ppm prefix]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    width = atoi(argv[2]);
+    height = atoi(argv[3]);
+    prefix = argc > 4 ? argv[4] : nullptr;
+    screen.assign(width * height * 3, 0);
+
+    int fd = open(argv[1], O_RDONLY | O_NOCTTY);
+    if (fd < 0)
+    {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+    if (isatty(fd))
+    {
+        termios t;
+        tcgetattr(fd, &t);
+        cfmakeraw(&t);
+        tcsetattr(fd, TCSANOW, &t);
+    }
+
+    hub75_stream_decoder_t dec;
+    const hub75_stream_sink_t sink = {sink_write, sink_fill, sink_present};
+    hub75_stream_decoder_init(&dec, width, height, &sink);
+
+    uint8_t buf[4096];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) > 0)
+    {
+        for (size_t used = 0; used < (size_t)n;) // stops after every present
+            used += hub75_stream_decoder_feed(&dec, buf + used, (size_t)n - used);
+        const hub75_stream_stats_t &s = dec.stats;
+        fprintf(stderr, "\rbytes %u packets %u frames %u errors %u checksum errors %u",
+                s.bytes, s.packets, s.frames, s.errors, s.checksum_errors);
+    }
+    fprintf(stderr, "\n");
+    close(fd);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+"""Send frames to a HUB75 controller using the framed stream protocol.
+
+See include/hub75_stream_decoder.h for the packet layout. The first frame is always
+sent in full; following frames are sent as dirty rectangles (raw or RLE) holding only
+what changed, unless --mode full is given.
+
+The port can be a serial device (/dev/ttyACM0 for USB CDC, a USB-UART bridge for the
+UART path), a pseudo-terminal, or a plain file to record a stream.
+
+Usage examples:
+    python utils/stream_send.py /dev/ttyACM0 --fps 30 --loop frames/*.png
+    python utils/stream_send.py /tmp/hub75_tx --mode rle --bgr-header --fps 10 a.h b.h c.h
+    python utils/stream_send.py recorded.bin --bgr-header examples/taylor_swift_64x64.h
+"""
+
+import argparse
+import os
+import re
+import struct
+import termios
+import time
+import tty
+
+STREAM_SYNC = b"\xA5\x5A"
+STREAM_FULL = 0x01
+STREAM_RECT = 0x02
+STREAM_RLE = 0x03
+STREAM_PRESENT = 0x04
+STREAM_FLAG_PRESENT = 0x01
+
+BAUDRATES = {v: getattr(termios, "B%d" % v) for v in (115200, 230400, 460800, 921600, 1000000, 2000000, 3000000) if hasattr(termios, "B%d" % v)}
+
+
+def packet(kind, payload, flags=0):
+    return STREAM_SYNC + struct.pack("<BBI", kind, flags, len(payload)) + payload + struct.pack("<H", sum(payload) & 0xFFFF)
+
+
+def rle(pixels):
+    """Encode BGR bytes as used by update_rle() / STREAM_RLE."""
+    n_px = len(pixels) // 3
+    px = [pixels[3 * k : 3 * k + 3] for k in range(n_px)]
+    out = bytearray()
+    literals = []
+
+    def flush():
+        while literals:
+            chunk = literals[:128]
+            del literals[:128]
+            out.append(len(chunk) - 1)
+            for p in chunk:
+                out.extend(p)
+
+    i = 0
+    while i < n_px:
+        n = 1
+        while i + n < n_px and n < 128 and px[i + n] == px[i]:
+            n += 1
+        if n >= 2:
+            flush()
+            out.append(0x80 | (n - 1))
+            out.extend(px[i])
+        else:
+            literals.append(px[i])
+        i += n
+    flush()
+    return bytes(out)
+
+
+def dirty_rects(prev, frame, width, height, band):
+    """Bounding box of the changed pixels per band of rows."""
+    rects = []
+    row_bytes = width * 3
+    for y0 in range(0, height, band):
+        y1 = min(y0 + band, height)
+        x_min, x_max = width, -1
+        for y in range(y0, y1):
+            a = prev[y * row_bytes : (y + 1) * row_bytes]
+            b = frame[y * row_bytes : (y + 1) * row_bytes]
+            if a == b:
+                continue
+            for x in range(width):
+                if a[3 * x : 3 * x + 3] != b[3 * x : 3 * x + 3]:
+                    x_min = min(x_min, x)
+                    break
+            for x in range(width - 1, -1, -1):
+                if a[3 * x : 3 * x + 3] != b[3 * x : 3 * x + 3]:
+                    x_max = max(x_max, x)
+                    break
+        if x_max >= 0:
+            rects.append((x_min, y0, x_max - x_min + 1, y1 - y0))
+    return rects
+
+
+def encode_frame(prev, frame, width, height, mode, band):
+    if prev is None or mode == "full":
+        return packet(STREAM_FULL, frame)
+
+    rects = dirty_rects(prev, frame, width, height, band)
+    if not rects:
+        return packet(STREAM_PRESENT, b"")
+
+    out = bytearray()
+    for n, (x, y, w, h) in enumerate(rects):
+        pixels = b"".join(frame[((y + j) * width + x) * 3 : ((y + j) * width + x + w) * 3] for j in range(h))
+        flags = STREAM_FLAG_PRESENT if n == len(rects) - 1 else 0
+        header = struct.pack("<HHHH", x, y, w, h)
+        if mode == "rle":
+            out += packet(STREAM_RLE, header + rle(pixels), flags)
+        else:
+            out += packet(STREAM_RECT, header + pixels, flags)
+    return bytes(out)
+
+
+def read_bgr_header(path):
+    text = open(path).read()
+    body = text[text.index("{") + 1 : text.rindex("}")]
+    return bytes(int(v, 0) for v in re.findall(r"0x[0-9a-fA-F]+|\d+", body))
+
+
+def read_image(path):
+    from PIL import Image  # only needed for image files
+
+    img = Image.open(path).convert("RGB")
+    bgr = bytearray()
+    for r, g, b in img.getdata():
+        bgr.extend((b, g, r))
+    return img.size, bytes(bgr)
+
+
+def open_port(path, baudrate):
+    fd = os.open(path, os.O_WRONLY | os.O_CREAT | os.O_NOCTTY, 0o644)
+    if os.isatty(fd):
+        tty.setraw(fd)
+        if baudrate:
+            attrs = termios.tcgetattr(fd)
+            attrs[4] = attrs[5] = BAUDRATES[baudrate]
+            termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Send frames using the HUB75 framed stream protocol")
+    ap.add_argument("port", help="serial device, pseudo-terminal or output file")
+    ap.add_argument("frames", nargs="+", help="frame images (Pillow) or, with --bgr-header, BGR C headers")
+    ap.add_argument("--bgr-header", action="store_true", help="frames are C headers with BGR byte arrays")
+    ap.add_argument("--width", type=int, help="screen width, required with --bgr-header unless square")
+    ap.add_argument("--mode", choices=["full", "rect", "rle"], default="rect", help="full frames, raw dirty rectangles or RLE dirty rectangles")
+    ap.add_argument("--band", type=int, default=8, help="rows per dirty rectangle band")
+    ap.add_argument("--fps", type=float, default=0, help="frame rate, 0 = as fast as possible")
+    ap.add_argument("--loop", action="store_true", help="repeat the frame sequence until interrupted")
+    ap.add_argument("--baudrate", type=int, choices=sorted(BAUDRATES), help="set the baud rate of a serial device")
+    args = ap.parse_args()
+
+    frames = []
+    for path in args.frames:
+        if args.bgr_header:
+            data = read_bgr_header(path)
+            width = args.width or int((len(data) // 3) ** 0.5)
+            size = (width, len(data) // 3 // width)
+        else:
+            size, data = read_image(path)
+        frames.append(data)
+    width, height = size
+
+    fd = open_port(args.port, args.baudrate)
+    prev = None
+    sent = 0
+    start = time.monotonic()
+    try:
+        while True:
+            for n, frame in enumerate(frames):
+                data = encode_frame(prev, frame, width, height, args.mode, args.band)
+                os.write(fd, data)
+                sent += len(data)
+                prev = frame
+                if args.fps:
+                    delay = start + (n + 1) / args.fps - time.monotonic()
+                    if delay > 0:
+                        time.sleep(delay)
+            if not args.loop:
+                break
+            start = time.monotonic()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        os.close(fd)
+    print(f"sent {sent} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,176 @@
+"""Convert a hub75_trace_print() dump into Chrome trace JSON.
+
+Capture the serial output of a board that called hub75_trace_print() and convert it:
+
+    python utils/trace2json.py serial.log -o trace.json
+
+Open trace.json in https://ui.perfetto.dev or chrome://tracing. Each core gets its own
+track (update() calls, row command rebuilds); the bitplane builder and the panel
+(frame swaps, FIFO starvation) get separate tracks, so rendering on one core can be
+compared with the driver on the other.
+
+The log may contain other output; only the lines between `hub75_trace begin` and
+`hub75_trace end` are used. With several dumps the last one is converted unless
+--all is given.
+"""
+
+import argparse
+import json
+import sys
+
+# enum Hub75TraceEvent in include/hub75.hpp
+UPDATE_BEGIN = 1
+UPDATE_END = 2
+BUILD_BEGIN = 3
+SLICE_DONE = 4
+BUILD_DONE = 5
+SWAP = 6
+ROW_CMD_BEGIN = 7
+ROW_CMD_END = 8
+ROW_CMD_SWAP = 9
+STARVED = 10
+IDLE = 11
+SYNC = 12
+USER = 32
+
+UPDATE_NAMES = {0: "update", 1: "update_bgr", 2: "update_qoi", 3: "update_rle", 4: "hub75_pipeline_poll"}
+STARVED_FLAGS = {1: "stream", 2: "row", 4: "tx_overrun"}
+IDLE_NAMES = {0: "full rate", 1: "idle rate", 2: "stream stopped", 3: "stream restarted"}
+SYNC_NAMES = {0: "sync pulse", 1: "waiting for pulse", 2: "restart on pulse", 3: "restart late", 4: "restart by timeout"}
+
+PID = 1
+TID_BUILDER = 10
+TID_PANEL = 11
+
+
+def read_dumps(lines):
+    """Return a list of dumps, each a list of (core, time_us, type, arg)."""
+    dumps = []
+    current = None
+    for line in lines:
+        line = line.strip()
+        if line.startswith("hub75_trace begin"):
+            current = []
+        elif line.startswith("hub75_trace end"):
+            if current is not None:
+                dumps.append(current)
+            current = None
+        elif current is not None:
+            fields = line.split()
+            if len(fields) == 4 and all(f.isdigit() for f in fields):
+                current.append(tuple(int(f) for f in fields))
+    return dumps
+
+
+def unwrap(events):
+    """time_us_32() wraps after 71 minutes - make the timestamps monotonic, relative to the first event."""
+    out = []
+    base = None
+    last = None
+    offset = 0
+    for core, t, kind, arg in events:
+        if base is None:
+            base = last = t
+        if t < last and last - t > 1 << 31:
+            offset += 1 << 32
+        last = t
+        out.append((core, t + offset - base, kind, arg))
+    return out
+
+
+def convert(events):
+    trace = []
+    cores = sorted({e[0] for e in events})
+    for core in cores:
+        trace.append({"ph": "M", "pid": PID, "tid": core, "name": "thread_name", "args": {"name": f"core{core}"}})
+    trace.append({"ph": "M", "pid": PID, "tid": TID_BUILDER, "name": "thread_name", "args": {"name": "bitplane builder"}})
+    trace.append({"ph": "M", "pid": PID, "tid": TID_PANEL, "name": "thread_name", "args": {"name": "panel"}})
+    trace.append({"ph": "M", "pid": PID, "name": "process_name", "args": {"name": "hub75"}})
+
+    update_open = {}  # core -> (start, name)
+    row_cmd_open = {}  # core -> (start, basis)
+    build_start = None
+    last_swap = None
+
+    def complete(name, tid, start, end, args=None):
+        ev = {"ph": "X", "pid": PID, "tid": tid, "name": name, "ts": start, "dur": max(end - start, 0)}
+        if args:
+            ev["args"] = args
+        trace.append(ev)
+
+    def instant(name, tid, ts, args=None):
+        ev = {"ph": "i", "s": "t", "pid": PID, "tid": tid, "name": name, "ts": ts}
+        if args:
+            ev["args"] = args
+        trace.append(ev)
+
+    for core, ts, kind, arg in events:
+        if kind == UPDATE_BEGIN:
+            if core in update_open:  # returned early (e.g. invalid QOI data)
+                start, name = update_open[core]
+                complete(name, core, start, ts, {"completed": False})
+            update_open[core] = (ts, UPDATE_NAMES.get(arg, "update"))
+        elif kind == UPDATE_END:
+            if core in update_open:
+                start, name = update_open.pop(core)
+                complete(name, core, start, ts)
+        elif kind == BUILD_BEGIN:
+            if build_start is not None:
+                complete("bitplane build", TID_BUILDER, build_start, ts, {"overwritten": True})
+            build_start = ts
+        elif kind == SLICE_DONE:
+            instant(f"slice {arg}", TID_BUILDER, ts, {"slice": arg})
+        elif kind == BUILD_DONE:
+            if build_start is not None:
+                complete("bitplane build", TID_BUILDER, build_start, ts)
+            build_start = None
+        elif kind == SWAP:
+            if last_swap is not None:
+                complete("frame on panel", TID_PANEL, last_swap[0], ts, {"prebaked": bool(last_swap[1])})
+            last_swap = (ts, arg)
+            instant("swap", TID_PANEL, ts)
+        elif kind == ROW_CMD_BEGIN:
+            row_cmd_open[core] = (ts, arg)
+        elif kind == ROW_CMD_END:
+            if core in row_cmd_open:
+                start, basis = row_cmd_open.pop(core)
+                complete("row cmd rebuild", core, start, ts, {"basis": basis, "intensity": arg / 1000})
+        elif kind == ROW_CMD_SWAP:
+            instant("row cmd swap", TID_PANEL, ts)
+        elif kind == STARVED:
+            flags = [name for bit, name in STARVED_FLAGS.items() if arg & bit]
+            instant("starved", TID_PANEL, ts, {"flags": flags})
+        elif kind == IDLE:
+            instant(IDLE_NAMES.get(arg, f"idle {arg}"), TID_PANEL, ts)
+        elif kind == SYNC:
+            instant(SYNC_NAMES.get(arg, f"sync {arg}"), TID_PANEL, ts)
+        else:
+            instant(f"user {kind}" if kind >= USER else f"event {kind}", core, ts, {"arg": arg})
+
+    return {"traceEvents": trace, "displayTimeUnit": "ms"}
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Convert hub75_trace_print() output to Chrome trace JSON")
+    ap.add_argument("log", help="captured serial output, - for stdin")
+    ap.add_argument("-o", "--output", help="output file (default stdout)")
+    ap.add_argument("--all", action="store_true", help="concatenate all dumps instead of using the last one")
+    args = ap.parse_args()
+
+    lines = sys.stdin if args.log == "-" else open(args.log, errors="replace")
+    dumps = read_dumps(lines)
+    if not dumps:
+        sys.exit("no hub75_trace dump found")
+
+    events = [e for d in dumps for e in d] if args.all else dumps[-1]
+    result = convert(unwrap(events))
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    json.dump(result, out, indent=None)
+    if args.output:
+        out.close()
+        print(f"{len(events)} events from {len(dumps)} dump(s) written to {args.output}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()